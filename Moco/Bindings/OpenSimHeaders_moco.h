@@ -6,8 +6,10 @@
 #include <Moco/About.h>
 #include <Moco/Common/TableProcessor.h>
 #include <Moco/Components/DeGrooteFregly2016Muscle.h>
+#include <Moco/Components/DeGrooteFregly2016MuscleGroup.h>
 #include <Moco/Components/ModelFactory.h>
 #include <Moco/Components/MultivariatePolynomialFunction.h>
+#include <Moco/Components/PolynomialGeometryPath.h>
 #include <Moco/Components/PositionMotion.h>
 #include <Moco/Components/Bhargava2004Metabolics.h>
 #include <Moco/MocoBounds.h>
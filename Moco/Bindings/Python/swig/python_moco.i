@@ -212,6 +212,12 @@ using namespace SimTK;
     (int n, double* derivOut),
     (int n, double* paramsOut)
 };
+// For setState(), etc.
+// NumPy arrays of doubles are passed to C++ without copying; other sequences
+// (e.g., lists) are converted to a NumPy array first.
+%apply (int DIM1, double* IN_ARRAY1) {
+    (int ntraj, double* traj)
+};
 // For getStatesTrajectory(), etc.
 // Similar to above but for 2D arrays.
 %apply (int DIM1, int DIM2, double* INPLACE_FARRAY2) {
@@ -220,6 +226,36 @@ using namespace SimTK;
     (int nrow, int ncol, double* multsOut),
     (int nrow, int ncol, double* derivsOut)
 };
+// For getTimeView(), getStatesTrajectoryView(), etc.
+// These functions return read-only NumPy arrays that refer to the memory of
+// the MocoTrajectory instead of copying it. SimTK matrices are stored by
+// column, so the 2D views are Fortran-ordered. Each view holds a reference to
+// the Python MocoTrajectory (`owner`) so that the memory outlives the view.
+%{
+static PyObject* moco_create_readonly_view(PyObject* owner,
+        const double* data, int ndim, int nrow, int ncol) {
+    npy_intp dims[2] = {nrow, ncol};
+    npy_intp strides[2] = {(npy_intp)sizeof(double),
+                           (npy_intp)(nrow * sizeof(double))};
+    PyObject* array = PyArray_New(&PyArray_Type, ndim, dims, NPY_DOUBLE,
+            strides, const_cast<double*>(data), (int)sizeof(double),
+            NPY_ARRAY_F_CONTIGUOUS | NPY_ARRAY_ALIGNED, NULL);
+    if (!array) return NULL;
+    Py_INCREF(owner);
+    if (PyArray_SetBaseObject((PyArrayObject*)array, owner) < 0) {
+        Py_DECREF(array);
+        return NULL;
+    }
+    return array;
+}
+static PyObject* moco_create_readonly_view(
+        PyObject* owner, const SimTK::Matrix& mat) {
+    OPENSIM_THROW_IF(mat.nelt() && !mat.hasContiguousData(),
+            OpenSim::Exception, "Matrix data is not contiguous.");
+    return moco_create_readonly_view(owner, mat.getContiguousScalarData(), 2,
+            mat.nrow(), mat.ncol());
+}
+%}
 %extend OpenSim::MocoTrajectory {
     MocoTrajectory(
             int ntime,
@@ -267,24 +303,20 @@ using namespace SimTK;
                 SimTK::Matrix(nrowderivs, ncolderivs, derivs),
                 SimTK::RowVector(nparams, params, true));
     }
-    void setTime(const std::vector<double>& time) {
-        $self->setTime(SimTK::Vector((int)time.size(), time.data()));
+    void setTime(int ntime, double* time) {
+        $self->setTime(SimTK::Vector(ntime, time, true));
     }
-    void setState(const std::string& name, const std::vector<double>& traj) {
-        $self->setState(name, SimTK::Vector((int)traj.size(), traj.data()));
+    void setState(const std::string& name, int ntraj, double* traj) {
+        $self->setState(name, SimTK::Vector(ntraj, traj, true));
     }
-    void setControl(const std::string& name, const std::vector<double>& traj) {
-        $self->setControl(name, SimTK::Vector((int)traj.size(), traj.data()));
+    void setControl(const std::string& name, int ntraj, double* traj) {
+        $self->setControl(name, SimTK::Vector(ntraj, traj, true));
     }
-    void setMultiplier(const std::string& name, const std::vector<double>& traj)
-    {
-        $self->setMultiplier(name,
-                SimTK::Vector((int)traj.size(), traj.data()));
+    void setMultiplier(const std::string& name, int ntraj, double* traj) {
+        $self->setMultiplier(name, SimTK::Vector(ntraj, traj, true));
     }
-    void setDerivative(const std::string& name, const std::vector<double>& traj)
-    {
-        $self->setDerivative(name,
-                SimTK::Vector((int)traj.size(), traj.data()));
+    void setDerivative(const std::string& name, int ntraj, double* traj) {
+        $self->setDerivative(name, SimTK::Vector(ntraj, traj, true));
     }
     void _getTimeMat(int n, double* timeOut) const {
         OPENSIM_THROW_IF(n != $self->getNumTimes(), OpenSim::Exception,
@@ -354,6 +386,26 @@ using namespace SimTK;
                 "ncol != number of derivs");
         std::copy_n(derivs.getContiguousScalarData(), nrow * ncol, derivsOut);
     }
+    PyObject* _getTimeView(PyObject* owner) const {
+        const auto& time = $self->getTime();
+        return moco_create_readonly_view(owner,
+                time.getContiguousScalarData(), 1, time.size(), 1);
+    }
+    PyObject* _getStatesTrajectoryView(PyObject* owner) const {
+        return moco_create_readonly_view(owner, $self->getStatesTrajectory());
+    }
+    PyObject* _getControlsTrajectoryView(PyObject* owner) const {
+        return moco_create_readonly_view(owner,
+                $self->getControlsTrajectory());
+    }
+    PyObject* _getMultipliersTrajectoryView(PyObject* owner) const {
+        return moco_create_readonly_view(owner,
+                $self->getMultipliersTrajectory());
+    }
+    PyObject* _getDerivativesTrajectoryView(PyObject* owner) const {
+        return moco_create_readonly_view(owner,
+                $self->getDerivativesTrajectory());
+    }
 %pythoncode %{
     def getTimeMat(self):
         return self._getTimeMat(self.getNumTimes())
@@ -389,6 +441,54 @@ using namespace SimTK;
         self._getDerivativesTrajectoryMat(mat)
         return mat
 
+    # The *View() functions return read-only NumPy arrays that share memory
+    # with this MocoTrajectory; unlike the *Mat() functions, nothing is copied.
+    # A view reflects later edits to existing entries of the trajectory.
+    # Functions that would reallocate the trajectory's memory (e.g.,
+    # setNumTimes(), resample(), insertStatesTrajectory()) raise an exception
+    # while any view exists; delete the views (or copy them with np.array())
+    # first.
+    # Weak references to the live views, keyed by the address of the C++
+    # trajectory, so that all Python proxies of a trajectory share them. The
+    # entry for a trajectory is removed once its last view is deleted, so
+    # that the address can be reused by another trajectory.
+    _views = {}
+    def _addView(self, view):
+        import weakref
+        key = int(self.this)
+        def discard(ref):
+            views = [v for v in MocoTrajectory._views.get(key, [])
+                     if v is not ref and v() is not None]
+            if views:
+                MocoTrajectory._views[key] = views
+            else:
+                MocoTrajectory._views.pop(key, None)
+        views = [v for v in MocoTrajectory._views.get(key, [])
+                 if v() is not None]
+        views.append(weakref.ref(view, discard))
+        MocoTrajectory._views[key] = views
+        return view
+    def _checkNoViews(self):
+        key = int(self.this)
+        views = [v for v in MocoTrajectory._views.get(key, [])
+                 if v() is not None]
+        if views:
+            MocoTrajectory._views[key] = views
+            raise RuntimeError('Cannot resize a MocoTrajectory while NumPy '
+                               'views of its data exist; delete the views '
+                               'first.')
+        MocoTrajectory._views.pop(key, None)
+    def getTimeView(self):
+        return self._addView(self._getTimeView(self))
+    def getStatesTrajectoryView(self):
+        return self._addView(self._getStatesTrajectoryView(self))
+    def getControlsTrajectoryView(self):
+        return self._addView(self._getControlsTrajectoryView(self))
+    def getMultipliersTrajectoryView(self):
+        return self._addView(self._getMultipliersTrajectoryView(self))
+    def getDerivativesTrajectoryView(self):
+        return self._addView(self._getDerivativesTrajectoryView(self))
+
 %};
 }
 
@@ -420,6 +520,25 @@ using namespace SimTK;
     ptr._markAdopted()
 %}
 
+// NumPy views of a MocoTrajectory's data (e.g., getStatesTrajectoryView())
+// would dangle if the trajectory reallocated its memory.
+%define MOCO_FORBID_WITH_TRAJECTORY_VIEWS(METHOD)
+%pythonprepend OpenSim::MocoTrajectory::METHOD %{
+    self._checkNoViews()
+%}
+%enddef
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(setNumTimes);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(resampleWithNumTimes);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(resampleWithInterval);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(resampleWithFrequency);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(resample);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(setStatesTrajectory);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(insertStatesTrajectory);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(insertControlsTrajectory);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(generateSpeedsFromValues);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(generateAccelerationsFromValues);
+MOCO_FORBID_WITH_TRAJECTORY_VIEWS(generateAccelerationsFromSpeeds);
+
 %pythonprepend OpenSim::MocoStudy::solve %{
     if MocoCasADiSolver.safeDownCast(self.updSolver()):
         solver = MocoCasADiSolver.safeDownCast(self.updSolver())
@@ -216,6 +216,43 @@ class TestSwigAddtlInterface(unittest.TestCase):
         assert (it.getDerivativesTrajectoryMat() == dt).all()
         assert (it.getParametersMat() == p).all()
 
+        # Read-only views share memory with the trajectory.
+        stView = it.getStatesTrajectoryView()
+        assert not stView.flags.writeable
+        assert (stView == st).all()
+        assert (it.getTimeView() == time).all()
+        assert (it.getControlsTrajectoryView() == ct).all()
+        assert (it.getMultipliersTrajectoryView() == mt).all()
+        assert (it.getDerivativesTrajectoryView() == dt).all()
+        it.setState('s1', np.array([5.0, 6.0, 7.0]))
+        assert (stView[:, 1] == [5, 6, 7]).all()
+        it.setControl('c0', [1.0, 2.0, 3.0])
+        assert (it.getControlsTrajectoryView()[:, 0] == [1, 2, 3]).all()
+        # Reallocating the trajectory's memory is not allowed while views
+        # exist, since the views would dangle.
+        with self.assertRaises(RuntimeError):
+            it.setNumTimes(5)
+        with self.assertRaises(RuntimeError):
+            it.resampleWithNumTimes(5)
+        # The view keeps the trajectory's memory alive.
+        del it
+        assert (stView[:, 0] == st[:, 0]).all()
+        # Once the views are gone, the trajectory can be resized.
+        it2 = osim.MocoTrajectory(time, ['s0', 's1'], ['c0', 'c1', 'c2'],
+                                  ['m0'], ['p0', 'p1'], st, ct, mt, p)
+        view = it2.getTimeView()
+        with self.assertRaises(RuntimeError):
+            it2.resampleWithNumTimes(5)
+        del view
+        it2.resampleWithNumTimes(5)
+        assert it2.getNumTimes() == 5
+        # The registry of views does not keep entries for deleted views.
+        assert int(it2.this) not in osim.MocoTrajectory._views
+        for i in range(10):
+            view = it2.getTimeView()
+            del view
+        assert int(it2.this) not in osim.MocoTrajectory._views
+
     def test_createRep(self):
         model = osim.Model()
         model.setName('sliding_mass')
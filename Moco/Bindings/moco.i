@@ -22,6 +22,11 @@ namespace OpenSim {
 %include <Moco/ModelProcessor.h>
 
 namespace OpenSim {
+    %ignore SolverTimers;
+    %ignore SharedReferenceSplines;
+    %ignore *::setProfiler;
+    %ignore *::addProfilerSections;
+    %ignore *::getProfiler;
     %ignore MocoGoal::IntegrandInput;
     %ignore MocoGoal::calcIntegrand;
     %ignore MocoGoal::GoalInput;
@@ -215,6 +220,7 @@ namespace OpenSim {
 %include <Moco/MocoTrack.h>
 
 %include <Moco/Components/DeGrooteFregly2016Muscle.h>
+%include <Moco/Components/DeGrooteFregly2016MuscleGroup.h>
 moco_unique_ptr(OpenSim::PositionMotion);
 %include <Moco/Components/PositionMotion.h>
 
@@ -225,6 +231,7 @@ moco_unique_ptr(OpenSim::PositionMotion);
 
 %include <Moco/Components/ModelFactory.h>
 %include <Moco/Components/MultivariatePolynomialFunction.h>
+%include <Moco/Components/PolynomialGeometryPath.h>
 %include <Moco/Components/Bhargava2004Metabolics.h>
 
 %include <Moco/ModelOperators.h>
@@ -18,9 +18,25 @@
 #include <Moco/About.h>
 #include <Moco/MocoProblem.h>
 #include <Moco/MocoStudy.h>
+#include <Moco/MocoCasADiSolver/MocoCasADiSolver.h>
 #include <Moco/MocoUtilities.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <regex>
+#include <thread>
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <dirent.h>
+#endif
+
+#include <OpenSim/Common/Logger.h>
 #include <OpenSim/Common/Object.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Simulation/osimSimulation.h>
@@ -40,6 +56,20 @@ Usage:
   opensim-moco [--library=<path>] run [--visualize] <.omoco-file>
     Run the MocoStudy in the provided .omoco file.
 
+  opensim-moco [--library=<path>] run-batch [--threads=<N>] [--jobs=<N>]
+          [--list=<file>] [--summary=<file>] [<.omoco-file-or-glob>...]
+    Run many MocoStudy files, several at a time, on a shared pool of threads.
+    The files can be provided as arguments, as glob patterns (e.g.,
+    "subject*/*.omoco"; the wildcards * and ? are supported in the file name),
+    or in a text file (--list) containing one file or pattern per line.
+    --threads is the total number of threads to use (default: the number of
+    processors). --jobs is the number of studies to solve concurrently
+    (default: the number of files or threads, whichever is smaller). Each
+    study solved with MocoCasADiSolver uses threads/jobs threads, unless its
+    solver's 'parallel' property is 0 (serial). Afterwards, a summary of the
+    status, objective, number of iterations, and wall time of each study is
+    printed, and written to --summary as a tab-delimited table, if provided.
+
   opensim-moco [--library=<path>] print-xml
     Print a template XML .omoco file for a MocoStudy.
 
@@ -71,6 +101,160 @@ void run_tool(std::string setupFile, bool visualize) {
     }
 }
 
+/// Expand a glob pattern into the matching file paths, sorted. Wildcards are
+/// supported only in the file name, not in the directory.
+std::vector<std::string> expand_glob(const std::string& pattern) {
+    const auto lastSep = pattern.find_last_of("/\\");
+    const std::string dir = lastSep == std::string::npos
+                                    ? ""
+                                    : pattern.substr(0, lastSep + 1);
+    const std::string name = pattern.substr(dir.size());
+    if (name.find_first_of("*?") == std::string::npos) return {pattern};
+
+    std::string regexStr;
+    for (const char c : name) {
+        if (c == '*') {
+            regexStr += ".*";
+        } else if (c == '?') {
+            regexStr += ".";
+        } else if (std::string("\\^$.|+()[]{}").find(c) !=
+                   std::string::npos) {
+            regexStr += std::string("\\") + c;
+        } else {
+            regexStr += c;
+        }
+    }
+    const std::regex regex(regexStr);
+
+    std::vector<std::string> names;
+#ifdef _WIN32
+    _finddata_t entry;
+    const auto handle = _findfirst((dir + "*").c_str(), &entry);
+    if (handle != -1) {
+        do {
+            if (!(entry.attrib & _A_SUBDIR)) names.push_back(entry.name);
+        } while (_findnext(handle, &entry) == 0);
+        _findclose(handle);
+    }
+#else
+    if (DIR* dirp = opendir(dir.empty() ? "." : dir.c_str())) {
+        while (const dirent* entry = readdir(dirp)) {
+            names.push_back(entry->d_name);
+        }
+        closedir(dirp);
+    }
+#endif
+    std::vector<std::string> files;
+    for (const auto& candidate : names) {
+        if (candidate == "." || candidate == "..") continue;
+        if (std::regex_match(candidate, regex)) files.push_back(dir + candidate);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+struct BatchResult {
+    std::string file;
+    std::string status = "not run";
+    bool success = false;
+    double objective = SimTK::NaN;
+    int numIterations = -1;
+    double wallTime = SimTK::NaN;
+};
+
+void print_batch_summary(
+        std::ostream& stream, const std::vector<BatchResult>& results) {
+    stream << "file\tsuccess\tstatus\tobjective\titerations\twall_time_s\n";
+    for (const auto& result : results) {
+        stream << result.file << "\t" << (result.success ? "true" : "false")
+               << "\t" << result.status << "\t"
+               << std::setprecision(10) << result.objective << "\t"
+               << result.numIterations << "\t" << std::setprecision(4)
+               << result.wallTime << "\n";
+    }
+}
+
+/// Returns true if all studies were solved successfully.
+bool run_batch(const std::vector<std::string>& files, int numThreads,
+        int numJobs, const std::string& summaryFile) {
+    OPENSIM_THROW_IF(files.empty(), Exception, "No .omoco files provided.");
+    if (numThreads <= 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (numJobs <= 0) numJobs = std::min((int)files.size(), numThreads);
+    numJobs = std::min((int)files.size(), numJobs);
+    const int numThreadsPerStudy = std::max(1, numThreads / numJobs);
+    std::cout << "Running " << files.size() << " studies, " << numJobs
+              << " at a time, with up to " << numThreadsPerStudy
+              << " thread(s) each." << std::endl;
+
+    std::vector<BatchResult> results(files.size());
+    std::atomic<int> nextFile(0);
+    std::mutex printMutex;
+    auto work = [&]() {
+        int ifile;
+        while ((ifile = nextFile++) < (int)files.size()) {
+            auto& result = results[ifile];
+            result.file = files[ifile];
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                std::unique_ptr<Object> obj(
+                        Object::makeObjectFromFile(result.file));
+                auto* study = dynamic_cast<MocoStudy*>(obj.get());
+                OPENSIM_THROW_IF(!study, Exception,
+                        "The provided file '{}' does not contain a "
+                        "MocoStudy.",
+                        result.file);
+                if (auto* solver = dynamic_cast<MocoCasADiSolver*>(
+                            &study->updSolver())) {
+                    if (solver->getProperty_parallel().empty() ||
+                            solver->get_parallel() != 0) {
+                        solver->set_parallel(numThreadsPerStudy);
+                    }
+                }
+                MocoSolution solution = study->solve();
+                result.success = solution.success();
+                result.status = solution.getStatus();
+                solution.unseal();
+                result.objective = solution.getObjective();
+                result.numIterations = solution.getNumIterations();
+            } catch (const std::exception& ex) {
+                result.status = std::string("exception: ") + ex.what();
+                // Keep the summary table on one line per study.
+                std::replace(result.status.begin(), result.status.end(),
+                        '\n', ' ');
+            }
+            result.wallTime = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                                      .count();
+            std::lock_guard<std::mutex> lock(printMutex);
+            std::cout << "Finished '" << result.file << "' ("
+                      << result.status << ")." << std::endl;
+        }
+    };
+    // The logger level is process-wide, so it is set once here rather than
+    // by the solver of each study; see MocoCasADiSolver::solveImpl(). Each
+    // job catches its own exceptions.
+    const Logger::Level origLoggerLevel = Logger::getLevel();
+    Logger::setLevel(Logger::Level::Warn);
+    std::vector<std::thread> threads;
+    for (int ijob = 1; ijob < numJobs; ++ijob) threads.emplace_back(work);
+    work();
+    for (auto& thread : threads) thread.join();
+    Logger::setLevel(origLoggerLevel);
+
+    std::cout << std::endl;
+    print_batch_summary(std::cout, results);
+    if (!summaryFile.empty()) {
+        std::ofstream stream(summaryFile);
+        OPENSIM_THROW_IF(!stream, Exception,
+                "Could not open summary file '{}'.", summaryFile);
+        print_batch_summary(stream, results);
+    }
+    return std::all_of(results.begin(), results.end(),
+            [](const BatchResult& result) { return result.success; });
+}
+
 void print_xml() {
     const auto* obj = Object::getDefaultInstanceOfType("MocoStudy");
     if (!obj) {
@@ -154,6 +338,50 @@ int main(int argc, char* argv[]) {
             }
             run_tool(setupFile, visualize);
 
+        } else if (subcommand == "run-batch") {
+            std::vector<std::string> patterns;
+            int numThreads = 0;
+            int numJobs = 0;
+            std::string summaryFile;
+            for (int iarg = 2; iarg < argc; ++iarg) {
+                const std::string arg(argv[iarg + offset]);
+                const std::string value = arg.substr(arg.find("=") + 1);
+                if (startsWith(arg, "--threads=")) {
+                    numThreads = std::stoi(value);
+                } else if (startsWith(arg, "--jobs=")) {
+                    numJobs = std::stoi(value);
+                } else if (startsWith(arg, "--summary=")) {
+                    summaryFile = value;
+                } else if (startsWith(arg, "--list=")) {
+                    std::ifstream list(value);
+                    OPENSIM_THROW_IF(!list, Exception,
+                            "Could not open list file '{}'.", value);
+                    std::string line;
+                    while (std::getline(list, line)) {
+                        line.erase(line.find_last_not_of(" \t\r") + 1);
+                        if (line.empty() || line[0] == '#') continue;
+                        patterns.push_back(line);
+                    }
+                } else if (startsWith(arg, "--")) {
+                    OPENSIM_THROW(
+                            Exception, "Unrecognized option '{}'.", arg);
+                } else {
+                    patterns.push_back(arg);
+                }
+            }
+            std::vector<std::string> files;
+            for (const auto& pattern : patterns) {
+                const auto matches = expand_glob(pattern);
+                if (matches.empty()) {
+                    std::cout << "No files match '" << pattern << "'."
+                              << std::endl;
+                }
+                files.insert(files.end(), matches.begin(), matches.end());
+            }
+            if (!run_batch(files, numThreads, numJobs, summaryFile)) {
+                return EXIT_FAILURE;
+            }
+
         } else if (subcommand == "print-xml") {
             OPENSIM_THROW_IF(
                     argc != 2, Exception, "Incorrect number of arguments.");
@@ -0,0 +1,216 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: TableProcessor.cpp                                           *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia, Nicholas Bianco, Prasanna Sritharan         *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TableProcessor.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+
+#include <OpenSim/Common/IO.h>
+
+using namespace OpenSim;
+
+namespace {
+
+// Processed tables are cached in a binary format so that reading the cache
+// is fast and does not lose precision:
+//   header, numRows, numColumns, column labels, metadata, times, data.
+// Only string-valued table metadata can be cached.
+const std::string cacheHeader = "OpenSimMocoTableProcessorCache1";
+
+void writeString(std::ostream& stream, const std::string& string) {
+    const std::uint64_t size = string.size();
+    stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    stream.write(string.data(), size);
+}
+
+std::string readString(std::istream& stream) {
+    std::uint64_t size = 0;
+    stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+    // Guard against allocating a huge string for an invalid file.
+    if (!stream || size > (1u << 20)) {
+        stream.setstate(std::ios::failbit);
+        return {};
+    }
+    std::string string(size, '\0');
+    stream.read(&string[0], size);
+    return string;
+}
+
+/// Returns false if the table cannot be cached.
+bool writeCachedTable(const TimeSeriesTable& table, const std::string& path) {
+    const auto& metadata = table.getTableMetaData();
+    const auto keys = metadata.getKeys();
+    for (const auto& key : keys) {
+        if (!SimTK::Value<std::string>::isA(metadata.getValueForKey(key))) {
+            return false;
+        }
+    }
+
+    // Write to a temporary file first so that other processes never read a
+    // partially-written cache file.
+    const std::string tempPath = path + "." + getMocoFormattedDateTime(true);
+    {
+        std::ofstream stream(tempPath, std::ios::out | std::ios::binary);
+        if (!stream) return false;
+        writeString(stream, cacheHeader);
+        const std::uint64_t numRows = table.getNumRows();
+        const std::uint64_t numColumns = table.getNumColumns();
+        stream.write(reinterpret_cast<const char*>(&numRows), sizeof(numRows));
+        stream.write(reinterpret_cast<const char*>(&numColumns),
+                sizeof(numColumns));
+        for (const auto& label : table.getColumnLabels()) {
+            writeString(stream, label);
+        }
+        const std::uint64_t numKeys = keys.size();
+        stream.write(reinterpret_cast<const char*>(&numKeys), sizeof(numKeys));
+        for (const auto& key : keys) {
+            writeString(stream, key);
+            writeString(stream, table.getTableMetaDataAsString(key));
+        }
+        const auto& times = table.getIndependentColumn();
+        stream.write(reinterpret_cast<const char*>(times.data()),
+                numRows * sizeof(double));
+        for (int irow = 0; irow < (int)numRows; ++irow) {
+            const auto row = table.getRowAtIndex(irow);
+            for (int icol = 0; icol < (int)numColumns; ++icol) {
+                stream.write(reinterpret_cast<const char*>(&row[icol]),
+                        sizeof(double));
+            }
+        }
+        if (!stream) {
+            stream.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    std::remove(path.c_str());
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/// Returns false if the cache file does not exist or is invalid.
+bool readCachedTable(const std::string& path, TimeSeriesTable& table) {
+    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    if (!stream) return false;
+    if (readString(stream) != cacheHeader) return false;
+    std::uint64_t numRows = 0;
+    std::uint64_t numColumns = 0;
+    stream.read(reinterpret_cast<char*>(&numRows), sizeof(numRows));
+    stream.read(reinterpret_cast<char*>(&numColumns), sizeof(numColumns));
+    if (!stream) return false;
+    std::vector<std::string> labels(numColumns);
+    for (auto& label : labels) label = readString(stream);
+    std::uint64_t numKeys = 0;
+    stream.read(reinterpret_cast<char*>(&numKeys), sizeof(numKeys));
+    std::vector<std::pair<std::string, std::string>> metadata(numKeys);
+    for (auto& entry : metadata) {
+        entry.first = readString(stream);
+        entry.second = readString(stream);
+    }
+    std::vector<double> times(numRows);
+    stream.read(reinterpret_cast<char*>(times.data()),
+            numRows * sizeof(double));
+    SimTK::Matrix data((int)numRows, (int)numColumns);
+    for (int irow = 0; irow < (int)numRows; ++irow) {
+        for (int icol = 0; icol < (int)numColumns; ++icol) {
+            stream.read(reinterpret_cast<char*>(&data(irow, icol)),
+                    sizeof(double));
+        }
+    }
+    if (!stream) return false;
+
+    table = TimeSeriesTable(times, data, labels);
+    for (const auto& entry : metadata) {
+        table.addTableMetaData(entry.first, entry.second);
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+TimeSeriesTable TableProcessor::process(
+        std::string relativeToDirectory, const Model* model) const {
+    if (get_filepath().empty()) {
+        OPENSIM_THROW_IF_FRMOBJ(
+                !m_tableProvided, Exception, "No source table.");
+        return applyOperators(*m_table, model);
+    }
+    OPENSIM_THROW_IF_FRMOBJ(m_tableProvided, Exception,
+            "Expected either an in-memory table or a filepath, but "
+            "both were provided.");
+    using SimTK::Pathname;
+    std::string path = get_filepath();
+    if (!relativeToDirectory.empty()) {
+        path = Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                relativeToDirectory, path);
+    }
+    if (get_cache_directory().empty()) {
+        return applyOperators(TimeSeriesTable(path), model);
+    }
+
+    std::string cacheDirectory = get_cache_directory();
+    if (!relativeToDirectory.empty()) {
+        cacheDirectory =
+                Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                        relativeToDirectory, cacheDirectory);
+    }
+    // The processed table depends on the contents of the source file, the
+    // operators, and the model (used for converting degrees to radians and
+    // available to the operators).
+    std::string key = readFileContents(path);
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        key += get_operators(i).dump();
+    }
+    if (model) key += model->dump();
+    const std::string cachePath = cacheDirectory + "/TableProcessor_" +
+                                  computeContentDigest(key) + ".bin";
+
+    TimeSeriesTable table;
+    if (readCachedTable(cachePath, table)) {
+        log_info("Using cached processed table '{}' for '{}'.", cachePath,
+                get_filepath());
+        return table;
+    }
+    table = applyOperators(TimeSeriesTable(path), model);
+    IO::makeDir(cacheDirectory);
+    if (!writeCachedTable(table, cachePath)) {
+        log_warn("Could not cache processed table '{}' to '{}'.",
+                get_filepath(), cachePath);
+    }
+    return table;
+}
+
+TimeSeriesTable TableProcessor::applyOperators(
+        TimeSeriesTable table, const Model* model) const {
+    if (model && table.hasTableMetaDataKey("inDegrees") &&
+            table.getTableMetaDataAsString("inDegrees") == "yes") {
+        OPENSIM_THROW_IF(
+                !model->hasSystem(), ModelHasNoSystem, model->getName());
+        model->getSimbodyEngine().convertDegreesToRadians(table);
+    }
+
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        get_operators(i).operate(table, model);
+    }
+    return table;
+}
@@ -20,6 +20,7 @@
 
 #include "../MocoUtilities.h"
 #include <algorithm>
+#include <memory>
 
 #include <OpenSim/Common/TimeSeriesTable.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -52,18 +53,25 @@ public:
             filepath, std::string, "File path to a TimeSeriesTable.");
     OpenSim_DECLARE_LIST_PROPERTY(operators, TableOperator,
             "Operators to apply to the source table of this processor.");
+    OpenSim_DECLARE_PROPERTY(cache_directory, std::string,
+            "Directory in which to cache processed tables, keyed by the "
+            "contents of the source file, the operators, and the model. The "
+            "directory is evaluated relative to the same directory as "
+            "filepath. Only used if the source table is a file (default: "
+            "empty, which disables caching).");
     /// This constructor is only for use when reading (deserializing) from an
     /// XML file.
     TableProcessor() {
         constructProperty_filepath("");
         constructProperty_operators();
+        constructProperty_cache_directory("");
     }
     /// Use an in-memory TimeSeriesTable as the source table.
     /// Since this constructor is not explicit, you can provide a
     /// TimeSeriesTable to any function that takes a TableProcessor (in C++).
     TableProcessor(TimeSeriesTable table) : TableProcessor() {
         m_tableProvided = true;
-        m_table = std::move(table);
+        m_table = std::make_shared<const TimeSeriesTable>(std::move(table));
     }
     /// Use a filepath as the source table.
     /// Since this constructor is not explicit, you can provide a string
@@ -77,41 +85,12 @@ public:
     /// radians (if the table has a header with inDegrees=yes) before any
     /// operations are performed. This model is accessible by any
     /// TableOperator%s that require it.
+    /// If the cache_directory property is set and the source table is a file,
+    /// the processed table is read from the cache if the same file has already
+    /// been processed with the same operators (and model); otherwise, the
+    /// processed table is written to the cache.
     TimeSeriesTable process(std::string relativeToDirectory,
-            const Model* model = nullptr) const {
-        TimeSeriesTable table;
-        if (get_filepath().empty()) {
-            if (m_tableProvided) {
-                table = m_table;
-            } else {
-                OPENSIM_THROW_FRMOBJ(Exception, "No source table.");
-            }
-        } else {
-            OPENSIM_THROW_IF_FRMOBJ(m_tableProvided, Exception,
-                    "Expected either an in-memory table or a filepath, but "
-                    "both were provided.");
-            std::string path = get_filepath();
-            if (!relativeToDirectory.empty()) {
-                using SimTK::Pathname;
-                path = Pathname::
-                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
-                                relativeToDirectory, path);
-            }
-            table = TimeSeriesTable(path);
-        }
-
-        if (model && table.hasTableMetaDataKey("inDegrees") &&
-                table.getTableMetaDataAsString("inDegrees") == "yes") {
-            OPENSIM_THROW_IF(
-                    !model->hasSystem(), ModelHasNoSystem, model->getName());
-            model->getSimbodyEngine().convertDegreesToRadians(table);
-        }
-
-        for (int i = 0; i < getProperty_operators().size(); ++i) {
-            get_operators(i).operate(table, model);
-        }
-        return table;
-    }
+            const Model* model = nullptr) const;
     /// Same as above, but paths are evaluated with respect to the current
     /// working directory.
     TimeSeriesTable process(const Model* model = nullptr) const {
@@ -145,8 +124,13 @@ public:
     }
 
 private:
+    TimeSeriesTable applyOperators(
+            TimeSeriesTable table, const Model* model) const;
+
     bool m_tableProvided = false;
-    TimeSeriesTable m_table;
+    // The source table is never modified, so copies of this processor (e.g.,
+    // in copies of a MocoProblem) share it.
+    std::shared_ptr<const TimeSeriesTable> m_table;
 };
 
 /// Apply a low-pass filter to the trajectory.
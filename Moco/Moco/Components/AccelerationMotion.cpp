@@ -81,6 +81,9 @@ const SimTK::Vector& AccelerationMotion::getUDot(
 void AccelerationMotion::setEnabled(
         SimTK::State& state, bool enabled) const {
     for (auto& motion : m_motions) {
+        // Enabling or disabling a Motion invalidates the Instance stage, so
+        // we avoid doing so if the Motion is already in the requested mode.
+        if (motion.isDisabled(state) != enabled) continue;
         if (enabled) {
             motion.enable(state);
         } else {
@@ -52,7 +52,8 @@ public:
     const SimTK::Vector& getUDot(const SimTK::State& state,
             SimTK::MobilizedBodyIndex mobodIdx) const;
     /// Use this to set whether the prescribed acceleration motion is used or
-    /// not.
+    /// not. This does nothing (and does not invalidate the state) if the
+    /// motion is already enabled or disabled as requested.
     void setEnabled(SimTK::State& state, bool enabled) const;
 protected:
 private:
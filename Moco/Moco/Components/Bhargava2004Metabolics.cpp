@@ -176,44 +176,53 @@ void Bhargava2004Metabolics::constructProperties()
 
 void Bhargava2004Metabolics::extendFinalizeFromProperties() {
     if (get_use_smoothing()) {
-        m_tanh_conditional = [](const double& cond, const double& left,
-                const double& right, const double& smoothing, const int&) {
-            const double smoothed_binary = 0.5 + 0.5 * tanh(smoothing * cond);
-            return left + (-left + right) * smoothed_binary;
-        };
         if (get_smoothing_type() == "tanh") {
-            m_conditional = m_tanh_conditional;
-
+            m_smoothing = Smoothing::Tanh;
         } else if (get_smoothing_type() == "huber") {
-            m_conditional = [](const double& cond, const double& left,
-                    const double& right, const double& smoothing,
-                    const int& direction) {
-                const double offset = (direction == 1) ? left : right;
-                const double scale = (right - left) / cond;
-                const double delta = 1.0;
-                const double state = direction * cond;
-                const double shift = 0.5 * (1 / smoothing);
-                const double y = smoothing * (state + shift);
-                double f = 0;
-                if (y < 0) f = offset;
-                else if (y <= delta) f = 0.5 * y * y + offset;
-                else  f = delta * (y - 0.5 * delta) + offset;
-                return scale * (f/smoothing + offset * (1.0 - 1.0/smoothing));
-            };
+            m_smoothing = Smoothing::Huber;
         }
     } else {
-        m_conditional = [](const double& cond, const double& left,
-                const double& right, const double& smoothing, const int&) {
-            if (cond <= 0) {
-                return left;
-            } else {
-                return right;
-            }
-        };
-        m_tanh_conditional = m_conditional;
+        m_smoothing = Smoothing::None;
+    }
+
+    const int numPoints = m_fiberLengthDepCurve.getSize();
+    m_fiberLengthDepCurveX.resize(numPoints);
+    m_fiberLengthDepCurveY.resize(numPoints);
+    m_fiberLengthDepCurveSlope.resize(numPoints);
+    for (int i = 0; i < numPoints; ++i) {
+        m_fiberLengthDepCurveX[i] = m_fiberLengthDepCurve.getX(i);
+        m_fiberLengthDepCurveY[i] = m_fiberLengthDepCurve.getY(i);
+    }
+    // As in PiecewiseLinearFunction, the curve is extrapolated using the
+    // slopes of the first and last segments.
+    for (int i = 0; i < numPoints - 1; ++i) {
+        m_fiberLengthDepCurveSlope[i] =
+                (m_fiberLengthDepCurveY[i + 1] - m_fiberLengthDepCurveY[i]) /
+                (m_fiberLengthDepCurveX[i + 1] - m_fiberLengthDepCurveX[i]);
+    }
+    if (numPoints > 1) {
+        m_fiberLengthDepCurveSlope[numPoints - 1] =
+                m_fiberLengthDepCurveSlope[numPoints - 2];
     }
 }
 
+double Bhargava2004Metabolics::calcFiberLengthDependence(
+        double normFiberLength) const {
+    const auto& x = m_fiberLengthDepCurveX;
+    const auto& y = m_fiberLengthDepCurveY;
+    const auto& slope = m_fiberLengthDepCurveSlope;
+    const int n = (int)x.size();
+    if (normFiberLength < x[0]) {
+        return y[0] + (normFiberLength - x[0]) * slope[0];
+    }
+    if (normFiberLength > x[n - 1]) {
+        return y[n - 1] + (normFiberLength - x[n - 1]) * slope[n - 1];
+    }
+    int k = 0;
+    while (k < n - 2 && normFiberLength >= x[k + 1]) ++k;
+    return y[k] + (normFiberLength - x[k]) * slope[k];
+}
+
 double Bhargava2004Metabolics::getTotalMetabolicRate(
         const SimTK::State& s) const {
     // BASAL METABOLIC RATE (W) (based on whole body mass, not muscle mass).
@@ -249,15 +258,45 @@ double Bhargava2004Metabolics::getMuscleMetabolicRate(
     return getMetabolicRate(s).get(m_muscleIndices.at(channel));
 }
 
+void Bhargava2004Metabolics::Parameters::clear() {
+    muscles.clear();
+    names.clear();
+    muscleMass.clear();
+    ratioSlowTwitchFibers.clear();
+    activationConstantSlowTwitch.clear();
+    activationConstantFastTwitch.clear();
+    maintenanceConstantSlowTwitch.clear();
+    maintenanceConstantFastTwitch.clear();
+}
+
+void Bhargava2004Metabolics::Parameters::append(
+        const Bhargava2004Metabolics_MuscleParameters& mp) {
+    muscles.emplace_back(&mp.getMuscle());
+    names.push_back(mp.getName());
+    muscleMass.push_back(mp.getMuscleMass());
+    ratioSlowTwitchFibers.push_back(mp.get_ratio_slow_twitch_fibers());
+    activationConstantSlowTwitch.push_back(
+            mp.get_activation_constant_slow_twitch());
+    activationConstantFastTwitch.push_back(
+            mp.get_activation_constant_fast_twitch());
+    maintenanceConstantSlowTwitch.push_back(
+            mp.get_maintenance_constant_slow_twitch());
+    maintenanceConstantFastTwitch.push_back(
+            mp.get_maintenance_constant_fast_twitch());
+}
+
 void Bhargava2004Metabolics::extendRealizeTopology(SimTK::State& state)
 const {
     Super::extendRealizeTopology(state);
     m_muscleIndices.clear();
+    m_params.clear();
     for (int i=0; i < getProperty_muscle_parameters().size(); ++i) {
-        const auto& muscle = get_muscle_parameters(i).getMuscle();
+        const auto& muscleParameter = get_muscle_parameters(i);
+        const auto& muscle = muscleParameter.getMuscle();
         if (muscle.get_appliesForce()) {
-            m_muscleIndices[muscle.getAbsolutePathString()] = i;
-            ++i;
+            m_muscleIndices[muscle.getAbsolutePathString()] =
+                    (int)m_params.muscles.size();
+            m_params.append(muscleParameter);
         }
     }
 }
@@ -334,59 +373,200 @@ const SimTK::Vector& Bhargava2004Metabolics::getMechanicalWorkRate(
     return getCacheVariableValue<SimTK::Vector>(s, "mechanical_work_rate");
 }
 
+namespace {
+/// Memory for the muscle quantities used by the metabolics kernel, in
+/// contiguous arrays. This memory is reused across evaluations (and across
+/// components) within a thread to avoid allocating during each evaluation.
+struct MetabolicsWorkspace {
+    std::vector<double> maxIsometricForce;
+    std::vector<double> activation;
+    std::vector<double> excitation;
+    std::vector<double> fiberForcePassive;
+    std::vector<double> fiberForceActive;
+    std::vector<double> normFiberLength;
+    std::vector<double> fiberVelocity;
+    std::vector<double> activeForceLengthMultiplier;
+    void resize(int n) {
+        maxIsometricForce.resize(n);
+        activation.resize(n);
+        excitation.resize(n);
+        fiberForcePassive.resize(n);
+        fiberForceActive.resize(n);
+        normFiberLength.resize(n);
+        fiberVelocity.resize(n);
+        activeForceLengthMultiplier.resize(n);
+    }
+};
+
+MetabolicsWorkspace& updMetabolicsWorkspace() {
+    thread_local MetabolicsWorkspace workspace;
+    return workspace;
+}
+
+inline double stepConditional(
+        const double& cond, const double& left, const double& right) {
+    if (cond <= 0) {
+        return left;
+    } else {
+        return right;
+    }
+}
+
+inline double tanhConditional(const double& cond, const double& left,
+        const double& right, const double& smoothing) {
+    const double smoothed_binary = 0.5 + 0.5 * tanh(smoothing * cond);
+    return left + (-left + right) * smoothed_binary;
+}
+
+inline double huberConditional(const double& cond, const double& left,
+        const double& right, const double& smoothing, const int& direction) {
+    const double offset = (direction == 1) ? left : right;
+    const double scale = (right - left) / cond;
+    const double delta = 1.0;
+    const double state = direction * cond;
+    const double shift = 0.5 * (1 / smoothing);
+    const double y = smoothing * (state + shift);
+    double f = 0;
+    if (y < 0) f = offset;
+    else if (y <= delta) f = 0.5 * y * y + offset;
+    else  f = delta * (y - 0.5 * delta) + offset;
+    return scale * (f/smoothing + offset * (1.0 - 1.0/smoothing));
+}
+} // anonymous namespace
+
 void Bhargava2004Metabolics::calcMetabolicRate(
         const SimTK::State& s, SimTK::Vector& totalRatesForMuscles,
         SimTK::Vector& activationRatesForMuscles,
         SimTK::Vector& maintenanceRatesForMuscles,
         SimTK::Vector& shorteningRatesForMuscles,
         SimTK::Vector& mechanicalWorkRatesForMuscles) const {
-    totalRatesForMuscles.resize((int)m_muscleIndices.size());
-    activationRatesForMuscles.resize((int)m_muscleIndices.size());
-    maintenanceRatesForMuscles.resize((int)m_muscleIndices.size());
-    shorteningRatesForMuscles.resize((int)m_muscleIndices.size());
-    mechanicalWorkRatesForMuscles.resize((int)m_muscleIndices.size());
-    double activationHeatRate, maintenanceHeatRate, shorteningHeatRate;
-    double mechanicalWorkRate;
-    activationHeatRate = maintenanceHeatRate = shorteningHeatRate =
-        mechanicalWorkRate = 0;
-
-    int i = 0;
-    for (const auto& muscleIndex : m_muscleIndices) {
-
-        const auto& muscleParameter =
-            get_muscle_parameters(muscleIndex.second);
-        const auto& muscle = muscleParameter.getMuscle();
+    const int numMuscles = (int)m_params.muscles.size();
+    totalRatesForMuscles.resize(numMuscles);
+    activationRatesForMuscles.resize(numMuscles);
+    maintenanceRatesForMuscles.resize(numMuscles);
+    shorteningRatesForMuscles.resize(numMuscles);
+    mechanicalWorkRatesForMuscles.resize(numMuscles);
+
+    // Gather the muscle quantities into contiguous arrays.
+    auto& ws = updMetabolicsWorkspace();
+    ws.resize(numMuscles);
+    const double effortScale = get_muscle_effort_scaling_factor();
+    for (int i = 0; i < numMuscles; ++i) {
+        const auto& muscle = *m_params.muscles[i];
+        ws.maxIsometricForce[i] = muscle.getMaxIsometricForce();
+        ws.activation[i] = effortScale * muscle.getActivation(s);
+        ws.excitation[i] = effortScale * muscle.getControl(s);
+        ws.fiberForcePassive[i] = muscle.getPassiveFiberForce(s);
+        ws.fiberForceActive[i] = effortScale * muscle.getActiveFiberForce(s);
+        ws.normFiberLength[i] = muscle.getNormalizedFiberLength(s);
+        ws.fiberVelocity[i] = muscle.getFiberVelocity(s);
+        ws.activeForceLengthMultiplier[i] =
+                muscle.getActiveForceLengthMultiplier(s);
+    }
+
+    switch (m_smoothing) {
+    case Smoothing::None:
+        calcMetabolicRateImpl<Smoothing::None>(totalRatesForMuscles,
+                activationRatesForMuscles, maintenanceRatesForMuscles,
+                shorteningRatesForMuscles, mechanicalWorkRatesForMuscles);
+        break;
+    case Smoothing::Tanh:
+        calcMetabolicRateImpl<Smoothing::Tanh>(totalRatesForMuscles,
+                activationRatesForMuscles, maintenanceRatesForMuscles,
+                shorteningRatesForMuscles, mechanicalWorkRatesForMuscles);
+        break;
+    case Smoothing::Huber:
+        calcMetabolicRateImpl<Smoothing::Huber>(totalRatesForMuscles,
+                activationRatesForMuscles, maintenanceRatesForMuscles,
+                shorteningRatesForMuscles, mechanicalWorkRatesForMuscles);
+        break;
+    }
+
+    // NAN CHECKING
+    // ------------------------------------------
+    for (int i = 0; i < numMuscles; ++i) {
+        if (SimTK::isNaN(activationRatesForMuscles[i]))
+            std::cout << "WARNING::" << getName() << ": activationHeatRate ("
+                    << m_params.names[i] << ") = NaN!" << std::endl;
+        if (SimTK::isNaN(maintenanceRatesForMuscles[i]))
+            std::cout << "WARNING::" << getName() << ": maintenanceHeatRate ("
+                    << m_params.names[i] << ") = NaN!" << std::endl;
+        if (SimTK::isNaN(shorteningRatesForMuscles[i]))
+            std::cout << "WARNING::" << getName() << ": shorteningHeatRate ("
+                    << m_params.names[i] << ") = NaN!" << std::endl;
+        if (SimTK::isNaN(mechanicalWorkRatesForMuscles[i]))
+            std::cout << "WARNING::" << getName() << ": mechanicalWorkRate ("
+                    << m_params.names[i] << ") = NaN!" << std::endl;
+    }
+}
 
-        const double maximalIsometricForce = muscle.getMaxIsometricForce();
-        const double activation =
-            get_muscle_effort_scaling_factor() * muscle.getActivation(s);
-        const double excitation =
-            get_muscle_effort_scaling_factor() * muscle.getControl(s);
-        const double fiberForcePassive =  muscle.getPassiveFiberForce(s);
-        const double fiberForceActive =
-            get_muscle_effort_scaling_factor() * muscle.getActiveFiberForce(s);
+template <Bhargava2004Metabolics::Smoothing S>
+void Bhargava2004Metabolics::calcMetabolicRateImpl(
+        SimTK::Vector& totalRatesForMuscles,
+        SimTK::Vector& activationRatesForMuscles,
+        SimTK::Vector& maintenanceRatesForMuscles,
+        SimTK::Vector& shorteningRatesForMuscles,
+        SimTK::Vector& mechanicalWorkRatesForMuscles) const {
+    // The conditional used for the smoothing type, and the tanh conditional
+    // used for the force dependent shortening proportionality constant.
+    const auto conditional = [](const double& cond, const double& left,
+            const double& right, const double& smoothing,
+            const int& direction) {
+        if (S == Smoothing::Tanh) {
+            return tanhConditional(cond, left, right, smoothing);
+        } else if (S == Smoothing::Huber) {
+            return huberConditional(cond, left, right, smoothing, direction);
+        } else {
+            return stepConditional(cond, left, right);
+        }
+    };
+    const auto tanh_conditional = [](const double& cond, const double& left,
+            const double& right, const double& smoothing) {
+        if (S == Smoothing::None) {
+            return stepConditional(cond, left, right);
+        } else {
+            return tanhConditional(cond, left, right, smoothing);
+        }
+    };
+
+    const auto& ws = updMetabolicsWorkspace();
+    const auto& p = m_params;
+    const bool useForceDependentShorteningPropConstant =
+            get_use_force_dependent_shortening_prop_constant();
+    const bool includeNegativeMechanicalWork =
+            get_include_negative_mechanical_work();
+    const bool forbidNegativeTotalPower = get_forbid_negative_total_power();
+    const bool enforceMinimumHeatRatePerMuscle =
+            get_enforce_minimum_heat_rate_per_muscle();
+    const double velocitySmoothing = get_velocity_smoothing();
+    const double powerSmoothing = get_power_smoothing();
+    const double heatRateSmoothing = get_heat_rate_smoothing();
+    // This small constant is added to the fiber velocity to prevent
+    // dividing by 0 (in case the actual fiber velocity is null) when using
+    // the Huber loss smoothing approach, thereby preventing singularities.
+    const double eps = 1e-16;
+
+    const int numMuscles = (int)p.muscles.size();
+    for (int i = 0; i < numMuscles; ++i) {
+        const double muscleMass = p.muscleMass[i];
+        const double activation = ws.activation[i];
+        const double excitation = ws.excitation[i];
+        const double fiberForceActive = ws.fiberForceActive[i];
         const double fiberForceTotal =
-            fiberForceActive + fiberForcePassive;
-        const double fiberLengthNormalized =
-            muscle.getNormalizedFiberLength(s);
-        const double fiberVelocity = muscle.getFiberVelocity(s);
+            fiberForceActive + ws.fiberForcePassive[i];
+        const double fiberVelocity = ws.fiberVelocity[i];
         const double slowTwitchExcitation =
-            muscleParameter.get_ratio_slow_twitch_fibers()
-            * sin(SimTK::Pi/2 * excitation);
+            p.ratioSlowTwitchFibers[i] * sin(SimTK::Pi/2 * excitation);
         const double fastTwitchExcitation =
-            (1 - muscleParameter.get_ratio_slow_twitch_fibers())
+            (1 - p.ratioSlowTwitchFibers[i])
             * (1 - cos(SimTK::Pi/2 * excitation));
-        // This small constant is added to the fiber velocity to prevent
-        // dividing by 0 (in case the actual fiber velocity is null) when using
-        // the Huber loss smoothing approach, thereby preventing singularities.
-        const double eps = 1e-16;
 
         // Get the unnormalized total active force, isometricTotalActiveForce
         // that 'would' be developed at the current activation and fiber length
         // under isometric conditions (i.e., fiberVelocity=0).
         const double isometricTotalActiveForce =
-            activation * muscle.getActiveForceLengthMultiplier(s)
-            * maximalIsometricForce;
+            activation * ws.activeForceLengthMultiplier[i]
+            * ws.maxIsometricForce[i];
 
         // ACTIVATION HEAT RATE (W).
         // -------------------------
@@ -394,22 +574,21 @@ void Bhargava2004Metabolics::calcMetabolicRate(
         // however, in Bhargava et al., (2004) they assume a function here.
         // We will ignore this function and use 1.0 for now.
         const double decay_function_value = 1.0;
-        activationHeatRate =
-            muscleParameter.getMuscleMass() * decay_function_value
-            * ( (muscleParameter.get_activation_constant_slow_twitch()
-                        * slowTwitchExcitation)
-                + (muscleParameter.get_activation_constant_fast_twitch()
+        const double activationHeatRate =
+            muscleMass * decay_function_value
+            * ( (p.activationConstantSlowTwitch[i] * slowTwitchExcitation)
+                + (p.activationConstantFastTwitch[i]
                         * fastTwitchExcitation) );
 
         // MAINTENANCE HEAT RATE (W).
         // --------------------------
-        const double fiber_length_dependence = m_fiberLengthDepCurve.calcValue(
-                    SimTK::Vector(1, fiberLengthNormalized));
-        maintenanceHeatRate =
-            muscleParameter.getMuscleMass() * fiber_length_dependence
-                * ( (muscleParameter.get_maintenance_constant_slow_twitch()
+        const double fiber_length_dependence =
+                calcFiberLengthDependence(ws.normFiberLength[i]);
+        const double maintenanceHeatRate =
+            muscleMass * fiber_length_dependence
+                * ( (p.maintenanceConstantSlowTwitch[i]
                             * slowTwitchExcitation)
-                + (muscleParameter.get_maintenance_constant_fast_twitch()
+                + (p.maintenanceConstantFastTwitch[i]
                             * fastTwitchExcitation) );
 
         // SHORTENING HEAT RATE (W).
@@ -417,7 +596,7 @@ void Bhargava2004Metabolics::calcMetabolicRate(
         //     fiberVelocity>0 as lengthening.
         // ---------------------------------------------------------
         double alpha;
-        if (get_use_force_dependent_shortening_prop_constant()) {
+        if (useForceDependentShorteningPropConstant) {
             // Even when using the Huber loss smoothing approach, we still rely
             // on a tanh approximation for the shortening heat rate when using
             // the force dependent shortening proportional constant. This is
@@ -427,66 +606,51 @@ void Bhargava2004Metabolics::calcMetabolicRate(
             // therefore easier to smooth the transition between both
             // contraction types with a tanh function than with a Huber loss
             // function.
-            alpha = m_tanh_conditional(fiberVelocity + eps,
+            alpha = tanh_conditional(fiberVelocity + eps,
                     (0.16 * isometricTotalActiveForce)
                     + (0.18 * fiberForceTotal),
                     0.157 * fiberForceTotal,
-                    get_velocity_smoothing(),
-                    -1);
+                    velocitySmoothing);
         } else {
             // This simpler value of alpha comes from Frank Anderson's 1999
             // dissertation "A Dynamic Optimization Solution for a Complete
             // Cycle of Normal Gait".
-            alpha = m_conditional(fiberVelocity + eps,
+            alpha = conditional(fiberVelocity + eps,
                     0.25 * fiberForceTotal,
                     0,
-                    get_velocity_smoothing(),
+                    velocitySmoothing,
                     -1);
         }
-        shorteningHeatRate = -alpha * (fiberVelocity + eps);
+        double shorteningHeatRate = -alpha * (fiberVelocity + eps);
 
         // MECHANICAL WORK RATE for the contractile element of the muscle (W).
         // --> note that we define fiberVelocity<0 as shortening and
         //     fiberVelocity>0 as lengthening.
         // -------------------------------------------------------------------
-        if (get_include_negative_mechanical_work())
+        double mechanicalWorkRate;
+        if (includeNegativeMechanicalWork)
         {
             mechanicalWorkRate = -fiberForceActive * fiberVelocity;
         } else {
-            mechanicalWorkRate = m_conditional(fiberVelocity + eps,
+            mechanicalWorkRate = conditional(fiberVelocity + eps,
                     -fiberForceActive * fiberVelocity,
                     0,
-                    get_velocity_smoothing(),
+                    velocitySmoothing,
                     -1);
         }
 
-        // NAN CHECKING
-        // ------------------------------------------
-        if (SimTK::isNaN(activationHeatRate))
-            std::cout << "WARNING::" << getName() << ": activationHeatRate ("
-                    << muscleParameter.getName() << ") = NaN!" << std::endl;
-        if (SimTK::isNaN(maintenanceHeatRate))
-            std::cout << "WARNING::" << getName() << ": maintenanceHeatRate ("
-                    << muscleParameter.getName() << ") = NaN!" << std::endl;
-        if (SimTK::isNaN(shorteningHeatRate))
-            std::cout << "WARNING::" << getName() << ": shorteningHeatRate ("
-                    << muscleParameter.getName() << ") = NaN!" << std::endl;
-        if (SimTK::isNaN(mechanicalWorkRate))
-            std::cout << "WARNING::" << getName() << ": mechanicalWorkRate ("
-                    <<  muscleParameter.getName() << ") = NaN!" << std::endl;
-
         // If necessary, increase the shortening heat rate so that the total
         // power is non-negative.
-        if (get_forbid_negative_total_power()) {
+        if (forbidNegativeTotalPower) {
             const double Edot_W_beforeClamp = activationHeatRate
                 + maintenanceHeatRate + shorteningHeatRate
                 + mechanicalWorkRate;
-            if (get_use_smoothing()) {
-                const double Edot_W_beforeClamp_smoothed = m_conditional(
+            if (S != Smoothing::None) {
+                const double Edot_W_beforeClamp_smoothed = conditional(
                         -Edot_W_beforeClamp,
                         0,
                         Edot_W_beforeClamp,
-                        get_power_smoothing(),
+                        powerSmoothing,
                         1);
                 shorteningHeatRate -= Edot_W_beforeClamp_smoothed;
             } else {
@@ -504,21 +668,21 @@ void Bhargava2004Metabolics::calcMetabolicRate(
         // --------------------------------------------------------------------
         double totalHeatRate = activationHeatRate + maintenanceHeatRate
             + shorteningHeatRate;
-        if (get_use_smoothing()) {
-            if (get_enforce_minimum_heat_rate_per_muscle())
+        if (S != Smoothing::None) {
+            if (enforceMinimumHeatRatePerMuscle)
             {
-                totalHeatRate = m_conditional(
-                        -totalHeatRate + 1.0 * muscleParameter.getMuscleMass(),
+                totalHeatRate = conditional(
+                        -totalHeatRate + 1.0 * muscleMass,
                         totalHeatRate,
-                        1.0 * muscleParameter.getMuscleMass(),
-                        get_heat_rate_smoothing(),
+                        1.0 * muscleMass,
+                        heatRateSmoothing,
                         1);
             }
         } else {
-            if (get_enforce_minimum_heat_rate_per_muscle()
-                    && totalHeatRate < 1.0 * muscleParameter.getMuscleMass())
+            if (enforceMinimumHeatRatePerMuscle
+                    && totalHeatRate < 1.0 * muscleMass)
             {
-                totalHeatRate = 1.0 * muscleParameter.getMuscleMass();
+                totalHeatRate = 1.0 * muscleMass;
             }
         }
 
@@ -531,8 +695,6 @@ void Bhargava2004Metabolics::calcMetabolicRate(
         maintenanceRatesForMuscles[i] = maintenanceHeatRate;
         shorteningRatesForMuscles[i] = shorteningHeatRate;
         mechanicalWorkRatesForMuscles[i] = mechanicalWorkRate;
-
-        ++i;
     }
 }
 
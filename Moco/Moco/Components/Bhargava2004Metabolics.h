@@ -288,13 +288,41 @@ private:
             SimTK::Vector& maintenanceRatesForMuscles,
             SimTK::Vector& shorteningRatesForMuscles,
             SimTK::Vector& mechanicalWorkRatesForMuscles) const;
+    enum class Smoothing { None, Tanh, Huber };
+    template <Smoothing S>
+    void calcMetabolicRateImpl(SimTK::Vector& totalRatesForMuscles,
+            SimTK::Vector& activationRatesForMuscles,
+            SimTK::Vector& maintenanceRatesForMuscles,
+            SimTK::Vector& shorteningRatesForMuscles,
+            SimTK::Vector& mechanicalWorkRatesForMuscles) const;
+    /// Evaluate the fiber length dependence of the maintenance heat rate
+    /// without allocating (as PiecewiseLinearFunction::calcValue() does).
+    double calcFiberLengthDependence(double normFiberLength) const;
+
+    // Maps the path of each muscle to its index in the rate vectors.
     mutable std::unordered_map<std::string, int> m_muscleIndices;
-    using ConditionalFunction =
-            double(const double&, const double&, const double&, const double&,
-                    const int&);
+    // Metabolic parameters of the muscles included in the rate vectors, in
+    // structure-of-arrays form, gathered in extendRealizeTopology(). The
+    // index is the index in the rate vectors.
+    struct Parameters {
+        std::vector<SimTK::ReferencePtr<const Muscle>> muscles;
+        std::vector<std::string> names;
+        std::vector<double> muscleMass;
+        std::vector<double> ratioSlowTwitchFibers;
+        std::vector<double> activationConstantSlowTwitch;
+        std::vector<double> activationConstantFastTwitch;
+        std::vector<double> maintenanceConstantSlowTwitch;
+        std::vector<double> maintenanceConstantFastTwitch;
+        void clear();
+        void append(const Bhargava2004Metabolics_MuscleParameters& mp);
+    };
+    mutable Parameters m_params;
+    Smoothing m_smoothing = Smoothing::None;
     PiecewiseLinearFunction m_fiberLengthDepCurve;
-    mutable std::function<ConditionalFunction> m_conditional;
-    mutable std::function<ConditionalFunction> m_tanh_conditional;
+    // Abscissae, ordinates, and slopes of m_fiberLengthDepCurve.
+    std::vector<double> m_fiberLengthDepCurveX;
+    std::vector<double> m_fiberLengthDepCurveY;
+    std::vector<double> m_fiberLengthDepCurveSlope;
 };
 
 } // namespace OpenSim
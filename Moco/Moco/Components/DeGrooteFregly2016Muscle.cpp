@@ -18,6 +18,8 @@
 
 #include "DeGrooteFregly2016Muscle.h"
 
+#include "DeGrooteFregly2016MuscleGroup.h"
+
 #include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -141,6 +143,8 @@ void DeGrooteFregly2016Muscle::extendFinalizeFromProperties() {
            (1.0 + get_tendon_strain_at_one_norm_force() - c2);
     m_isTendonDynamicsExplicit =
             get_tendon_compliance_dynamics_mode() == "explicit";
+    // A DeGrooteFregly2016MuscleGroup sets this when connecting to the model.
+    m_group.clear();
 }
 
 void DeGrooteFregly2016Muscle::extendAddToSystem(
@@ -328,6 +332,21 @@ void DeGrooteFregly2016Muscle::calcMuscleDynamicsInfoHelper(
         const FiberVelocityInfo& fvi, MuscleDynamicsInfo& mdi,
         const SimTK::Real& normTendonForce = SimTK::NaN) const {
 
+    const auto fiberStiffness = calcFiberStiffness(activation,
+            mli.normFiberLength, fvi.fiberForceVelocityMultiplier);
+    const auto tendonStiffness = calcTendonStiffness(mli.normTendonLength);
+    calcMuscleDynamicsInfoHelper(activation, muscleTendonVelocity,
+            ignoreTendonCompliance, mli, fvi, mdi, normTendonForce,
+            fiberStiffness, tendonStiffness);
+}
+
+void DeGrooteFregly2016Muscle::calcMuscleDynamicsInfoHelper(
+        const SimTK::Real& activation, const SimTK::Real& muscleTendonVelocity,
+        const bool& ignoreTendonCompliance, const MuscleLengthInfo& mli,
+        const FiberVelocityInfo& fvi, MuscleDynamicsInfo& mdi,
+        const SimTK::Real& normTendonForce, const SimTK::Real& fiberStiffness,
+        const SimTK::Real& tendonStiffness) const {
+
     mdi.activation = activation;
 
     SimTK::Real activeFiberForce;
@@ -375,8 +394,7 @@ void DeGrooteFregly2016Muscle::calcMuscleDynamicsInfoHelper(
 
     // Compute stiffness entries.
     // --------------------------
-    mdi.fiberStiffness = calcFiberStiffness(mdi.activation, mli.normFiberLength,
-            fvi.fiberForceVelocityMultiplier);
+    mdi.fiberStiffness = fiberStiffness;
     const auto& partialPennationAnglePartialFiberLength =
             calcPartialPennationAnglePartialFiberLength(mli.fiberLength);
     const auto& partialFiberForceAlongTendonPartialFiberLength =
@@ -388,7 +406,7 @@ void DeGrooteFregly2016Muscle::calcMuscleDynamicsInfoHelper(
             mli.fiberLength, partialFiberForceAlongTendonPartialFiberLength,
             mli.sinPennationAngle, mli.cosPennationAngle,
             partialPennationAnglePartialFiberLength);
-    mdi.tendonStiffness = calcTendonStiffness(mli.normTendonLength);
+    mdi.tendonStiffness = tendonStiffness;
     mdi.muscleStiffness = calcMuscleStiffness(
             mdi.tendonStiffness, mdi.fiberStiffnessAlongTendon);
 
@@ -454,6 +472,11 @@ void DeGrooteFregly2016Muscle::calcMusclePotentialEnergyInfoHelper(
 void DeGrooteFregly2016Muscle::calcMuscleLengthInfo(
         const SimTK::State& s, MuscleLengthInfo& mli) const {
 
+    if (m_group) {
+        m_group->calcMuscleLengthInfos(s, *this, mli);
+        return;
+    }
+
     const auto& muscleTendonLength = getLength(s);
     SimTK::Real normTendonForce = SimTK::NaN;
     if (!get_ignore_tendon_compliance()) {
@@ -474,6 +497,11 @@ void DeGrooteFregly2016Muscle::calcMuscleLengthInfo(
 void DeGrooteFregly2016Muscle::calcFiberVelocityInfo(
         const SimTK::State& s, FiberVelocityInfo& fvi) const {
 
+    if (m_group) {
+        m_group->calcFiberVelocityInfos(s, *this, fvi);
+        return;
+    }
+
     const auto& mli = getMuscleLengthInfo(s);
     const auto& muscleTendonVelocity = getLengtheningSpeed(s);
     const auto& activation = getActivation(s);
@@ -501,6 +529,10 @@ void DeGrooteFregly2016Muscle::calcFiberVelocityInfo(
 
 void DeGrooteFregly2016Muscle::calcMuscleDynamicsInfo(
         const SimTK::State& s, MuscleDynamicsInfo& mdi) const {
+    if (m_group) {
+        m_group->calcMuscleDynamicsInfos(s, *this, mdi);
+        return;
+    }
     const auto& activation = getActivation(s);
     SimTK::Real normTendonForce = SimTK::NaN;
     if (!get_ignore_tendon_compliance()) {
@@ -541,12 +573,32 @@ OpenSim::DeGrooteFregly2016Muscle::calcInextensibleTendonActiveFiberForce(
 
 void DeGrooteFregly2016Muscle::computeInitialFiberEquilibrium(
         SimTK::State& s) const {
-    if (get_ignore_tendon_compliance()) return;
+    solveFiberEquilibrium(s);
+}
 
-    const auto& muscleTendonLength = getLength(s);
-    const auto& muscleTendonVelocity = getLengtheningSpeed(s);
-    const auto& activation = getActivation(s);
+DeGrooteFregly2016Muscle::FiberEquilibriumStatistics
+DeGrooteFregly2016Muscle::solveFiberEquilibrium(SimTK::State& s) const {
+    if (get_ignore_tendon_compliance()) {
+        // There is nothing to solve for.
+        FiberEquilibriumStatistics stats;
+        stats.converged = true;
+        return stats;
+    }
+
+    std::vector<double> normTendonForce(1);
+    std::vector<FiberEquilibriumStatistics> statistics(1);
+    solveFiberEquilibria({this}, {getActivation(s)}, {getLength(s)},
+            {getLengtheningSpeed(s)}, normTendonForce, statistics);
 
+    setNormalizedTendonForce(s, normTendonForce[0]);
+    return statistics[0];
+}
+
+void DeGrooteFregly2016Muscle::calcEquilibriumResidualAndDerivative(
+        const SimTK::Real& activation, const SimTK::Real& muscleTendonLength,
+        const SimTK::Real& muscleTendonVelocity,
+        const SimTK::Real& normTendonForce, SimTK::Real& residual,
+        SimTK::Real& derivative) const {
     // We have to use the implicit form of the model since the explicit form
     // will produce a zero residual for any guess of normalized tendon force.
     // The implicit form requires a value for normalized tendon force
@@ -556,82 +608,112 @@ void DeGrooteFregly2016Muscle::computeInitialFiberEquilibrium(
     MuscleLengthInfo mli;
     FiberVelocityInfo fvi;
     MuscleDynamicsInfo mdi;
+    calcMuscleLengthInfoHelper(muscleTendonLength, false, mli, normTendonForce);
+    calcFiberVelocityInfoHelper(muscleTendonVelocity, activation, false, false,
+            mli, fvi, normTendonForce, normTendonForceDerivative);
+    calcMuscleDynamicsInfoHelper(activation, muscleTendonVelocity, false, mli,
+            fvi, mdi, normTendonForce);
+
+    residual = calcEquilibriumResidual(
+            mdi.tendonForce, mdi.fiberForceAlongTendon);
+    // d(tendonForce)/d(normTendonForce) = maxIsometricForce.
+    // d(fiberLengthAlongTendon)/d(normTendonForce) =
+    //          -tendonSlackLength * d(normTendonLength)/d(normTendonForce).
+    derivative = get_max_isometric_force() +
+                 mdi.fiberStiffnessAlongTendon * get_tendon_slack_length() /
+                         calcTendonForceMultiplierDerivative(
+                                 mli.normTendonLength);
+}
 
-    auto calcResidual = [this, &muscleTendonLength, &muscleTendonVelocity,
-                                &normTendonForceDerivative, &activation, &mli,
-                                &fvi,
-                                &mdi](const SimTK::Real& normTendonForce) {
-        calcMuscleLengthInfoHelper(muscleTendonLength, false, mli,
-                normTendonForce);
-        calcFiberVelocityInfoHelper(muscleTendonVelocity, activation, false,
-                false, mli, fvi, normTendonForce, normTendonForceDerivative);
-        calcMuscleDynamicsInfoHelper(activation, muscleTendonVelocity, false,
-                mli, fvi, mdi, normTendonForce);
-
-        return calcEquilibriumResidual(
-                mdi.tendonForce, mdi.fiberForceAlongTendon);
+void DeGrooteFregly2016Muscle::solveFiberEquilibria(
+        const std::vector<const DeGrooteFregly2016Muscle*>& muscles,
+        const std::vector<double>& activation,
+        const std::vector<double>& muscleTendonLength,
+        const std::vector<double>& muscleTendonVelocity,
+        std::vector<double>& normTendonForce,
+        std::vector<FiberEquilibriumStatistics>& statistics) {
+    // The same tolerance and limit that we previously used with bisection.
+    const double tolerance = 1e-10;
+    const int maxIterations = 100;
+
+    const int n = (int)muscles.size();
+    normTendonForce.resize(n);
+    statistics.assign(n, {});
+    std::vector<double> left(n, m_minNormTendonForce);
+    std::vector<double> right(n, m_maxNormTendonForce);
+    std::vector<double> residualLeft(n);
+    std::vector<double> residual(n);
+    std::vector<double> derivative(n);
+
+    auto evaluate = [&](int i, double x) {
+        muscles[i]->calcEquilibriumResidualAndDerivative(activation[i],
+                muscleTendonLength[i], muscleTendonVelocity[i], x,
+                residual[i], derivative[i]);
     };
 
-    const auto equilNormTendonForce = solveBisection(calcResidual,
-            m_minNormTendonForce, m_maxNormTendonForce, 1e-10, 100);
-
-    setNormalizedTendonForce(s, equilNormTendonForce);
-
-    // TODO not working as well as bisection, revisist later.
-    //const double tolerance = std::max(
-    //        1e-8 * get_max_isometric_force(), SimTK::SignificantReal * 10);
-    //int maxIterations = 1000;
-
-    //try {
-    //    auto result = estimateMuscleFiberState(activation,
-    //            muscleTendonLength, muscleTendonVelocity,
-    //            normTendonForceDerivative, tolerance, maxIterations);
-
-    //    switch (result.first) {
-
-    //    case Success_Converged:
-    //        setNormalizedTendonForce(s, result.second["norm_tendon_force"]);
-    //        setActuation(s, get_max_isometric_force() *
-    //                                result.second["norm_tendon_force"]);
-    //        break;
-
-    //    case Warning_FiberAtLowerBound:
-    //        printf("\n\nDeGrooteFregly2016Muscle static solution:"
-    //               " %s is at its minimum fiber length of %f\n",
-    //                getName().c_str(), result.second["fiber_length"]);
-    //        setNormalizedTendonForce(s, result.second["norm_tendon_force"]);
-    //        setActuation(s, get_max_isometric_force() *
-    //                                result.second["norm_tendon_force"]);
-    //        break;
-
-    //    case Warning_FiberAtUpperBound:
-    //        printf("\n\nDeGrooteFregly2016Muscle static solution:"
-    //               " %s is at its maximum fiber length of %f\n",
-    //                getName().c_str(), result.second["fiber_length"]);
-    //        setNormalizedTendonForce(s, result.second["norm_tendon_force"]);
-    //        setActuation(s, get_max_isometric_force() *
-    //                                result.second["norm_tendon_force"]);
-    //        break;
-
-    //    case Failure_MaxIterationsReached:
-    //        std::ostringstream ss;
-    //        ss << "\n  Solution error " << abs(result.second["solution_error"])
-    //           << " exceeds tolerance of " << tolerance << "\n"
-    //           << "  Newton iterations reached limit of " << maxIterations
-    //           << "\n"
-    //           << "  Activation is " << activation << "\n"
-    //           << "  Fiber length is " << result.second["fiber_length"] << "\n";
-    //        OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, ss.str());
-    //    }
+    // Bracket the root and take a secant step from the bracket as the initial
+    // guess.
+    for (int i = 0; i < n; ++i) {
+        evaluate(i, right[i]);
+        const double residualRight = residual[i];
+        evaluate(i, left[i]);
+        residualLeft[i] = residual[i];
+        OPENSIM_THROW_IF(residualLeft[i] * residualRight >= 0, Exception,
+                "Equilibrium residual for DeGrooteFregly2016Muscle '{}' has "
+                "the same sign at normalized tendon forces of {} and {}.",
+                muscles[i]->getName(), left[i], right[i]);
+        normTendonForce[i] = left[i] - residualLeft[i] * (right[i] - left[i]) /
+                                               (residualRight - residualLeft[i]);
+    }
 
-    //} catch (const std::exception& x) {
-    //    OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate,
-    //            "Internal exception encountered.\n" + std::string{x.what()});
-    //}
+    // Advance all muscles that have not converged.
+    int numActive = n;
+    for (int iter = 0; iter < maxIterations && numActive; ++iter) {
+        numActive = 0;
+        for (int i = 0; i < n; ++i) {
+            auto& stats = statistics[i];
+            if (stats.converged) continue;
+            double& x = normTendonForce[i];
+            evaluate(i, x);
+            ++stats.iterations;
+            stats.residual = residual[i];
+            if (residual[i] == 0) {
+                stats.converged = true;
+                continue;
+            }
+            // Shrink the bracket.
+            if (residual[i] * residualLeft[i] > 0) {
+                left[i] = x;
+                residualLeft[i] = residual[i];
+            } else {
+                right[i] = x;
+            }
+            double next = x - residual[i] / derivative[i];
+            if (!(next > left[i] && next < right[i])) {
+                next = 0.5 * (left[i] + right[i]);
+                ++stats.bisectionSteps;
+            }
+            if (std::abs(next - x) < tolerance ||
+                    right[i] - left[i] < tolerance) {
+                stats.converged = true;
+            } else {
+                ++numActive;
+            }
+            x = next;
+        }
+    }
 
+    for (int i = 0; i < n; ++i) {
+        if (!statistics[i].converged) {
+            log_warn("DeGrooteFregly2016Muscle '{}': fiber equilibrium did "
+                     "not converge in {} iterations (normalized tendon force: "
+                     "{}; residual: {} N).",
+                    muscles[i]->getName(), maxIterations, normTendonForce[i],
+                    statistics[i].residual);
+        }
+    }
 }
 
-
 std::pair<DeGrooteFregly2016Muscle::StatusFromEstimateMuscleFiberState,
         DeGrooteFregly2016Muscle::ValuesFromEstimateMuscleFiberState>
 DeGrooteFregly2016Muscle::estimateMuscleFiberState(const double activation,
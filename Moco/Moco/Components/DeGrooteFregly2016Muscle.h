@@ -27,6 +27,8 @@
 
 namespace OpenSim {
 
+class DeGrooteFregly2016MuscleGroup;
+
 // TODO avoid checking ignore_tendon_compliance() in each function;
 //       might be slow.
 // TODO prohibit fiber length from going below 0.2.
@@ -200,9 +202,32 @@ protected:
 
 public:
     /// Fiber velocity is assumed to be 0.
+    /// This uses solveFiberEquilibrium().
     void computeInitialFiberEquilibrium(SimTK::State& s) const override;
     /// @}
 
+    /// Iteration statistics from solving for fiber equilibrium.
+    struct FiberEquilibriumStatistics {
+        /// Number of residual evaluations after bracketing the root.
+        int iterations = 0;
+        /// Number of iterations that took a bisection step because the Newton
+        /// step left the bracket or was not well-defined.
+        int bisectionSteps = 0;
+        /// Equilibrium residual (N) at the solution.
+        double residual = SimTK::NaN;
+        bool converged = false;
+    };
+
+    /// Set the normalized tendon force in the state such that the tendon and
+    /// fiber forces are in equilibrium, assuming the derivative of normalized
+    /// tendon force is zero. This uses a safeguarded Newton method: Newton
+    /// steps (using calcEquilibriumResidualAndDerivative()) are taken within a
+    /// bracket on the normalized tendon force, and the method falls back to
+    /// bisection when the Newton step leaves the bracket. If tendon compliance
+    /// is ignored, this does nothing (and reports convergence).
+    /// @see DeGrooteFregly2016MuscleGroup::solveFiberEquilibria()
+    FiberEquilibriumStatistics solveFiberEquilibrium(SimTK::State& s) const;
+
     /// @name Get methods.
     /// @{
 
@@ -641,6 +666,19 @@ public:
         return tendonForce - fiberForceAlongTendon;
     }
 
+    /// The equilibrium residual (see getEquilibriumResidual()) and its
+    /// derivative with respect to normalized tendon force, with the derivative
+    /// of normalized tendon force set to zero. The derivative is
+    ///     maxIsometricForce + fiberStiffnessAlongTendon *
+    ///         tendonSlackLength / tendonForceMultiplierDerivative,
+    /// since the fiber length along the tendon decreases as the tendon
+    /// stretches. This requires tendon compliance.
+    void calcEquilibriumResidualAndDerivative(const SimTK::Real& activation,
+            const SimTK::Real& muscleTendonLength,
+            const SimTK::Real& muscleTendonVelocity,
+            const SimTK::Real& normTendonForce, SimTK::Real& residual,
+            SimTK::Real& derivative) const;
+
     /// @copydoc getLinearizedEquilibriumResidualDerivative()
     SimTK::Real calcLinearizedEquilibriumResidualDerivative(
             const SimTK::Real muscleTendonVelocity,
@@ -709,6 +747,15 @@ private:
             const bool& ignoreTendonCompliance, const MuscleLengthInfo& mli,
             const FiberVelocityInfo& fvi, MuscleDynamicsInfo& mdi,
             const SimTK::Real& normTendonForce) const;
+    /// This variant accepts the fiber and tendon stiffnesses instead of
+    /// computing them; this is used by DeGrooteFregly2016MuscleGroup.
+    void calcMuscleDynamicsInfoHelper(const SimTK::Real& activation,
+            const SimTK::Real& muscleTendonVelocity,
+            const bool& ignoreTendonCompliance, const MuscleLengthInfo& mli,
+            const FiberVelocityInfo& fvi, MuscleDynamicsInfo& mdi,
+            const SimTK::Real& normTendonForce,
+            const SimTK::Real& fiberStiffness,
+            const SimTK::Real& tendonStiffness) const;
     void calcMusclePotentialEnergyInfoHelper(const bool& ignoreTendonCompliance,
             const MuscleLengthInfo& mli, MusclePotentialEnergyInfo& mpei) const;
 
@@ -751,6 +798,17 @@ private:
         double normalized_tendon_force;
     };
 
+    /// Solve for the equilibrium normalized tendon force of multiple muscles,
+    /// advancing the safeguarded Newton iterations of all muscles together.
+    /// The inputs and outputs are indexed by muscle.
+    static void solveFiberEquilibria(
+            const std::vector<const DeGrooteFregly2016Muscle*>& muscles,
+            const std::vector<double>& activation,
+            const std::vector<double>& muscleTendonLength,
+            const std::vector<double>& muscleTendonVelocity,
+            std::vector<double>& normTendonForce,
+            std::vector<FiberEquilibriumStatistics>& statistics);
+
     std::pair<StatusFromEstimateMuscleFiberState,
             ValuesFromEstimateMuscleFiberState>
     estimateMuscleFiberState(const double activation, 
@@ -833,6 +891,11 @@ private:
     SimTK::Real m_kT = SimTK::NaN;
     bool m_isTendonDynamicsExplicit = true;
 
+    // If this muscle belongs to a DeGrooteFregly2016MuscleGroup, the group
+    // computes this muscle's length, velocity, and dynamics info.
+    friend DeGrooteFregly2016MuscleGroup;
+    mutable SimTK::ReferencePtr<const DeGrooteFregly2016MuscleGroup> m_group;
+
     // Indices for MuscleDynamicsInfo::userDefinedDynamicsExtras.
     constexpr static int m_mdi_passiveFiberElasticForce = 0;
     constexpr static int m_mdi_passiveFiberDampingForce = 1;
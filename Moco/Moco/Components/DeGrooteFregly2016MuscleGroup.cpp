@@ -0,0 +1,509 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: DeGrooteFregly2016MuscleGroup.cpp                            *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016MuscleGroup.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace OpenSim;
+
+using DGF = DeGrooteFregly2016Muscle;
+
+namespace {
+/// Memory for the inputs and outputs of the batched curve evaluations. The
+/// loops below operate on these contiguous arrays so that the compiler can
+/// vectorize them. This memory is reused across evaluations (and across
+/// groups) within a thread to avoid allocating during each evaluation.
+struct Workspace {
+    std::vector<double> muscleTendonLength;
+    std::vector<double> muscleTendonVelocity;
+    std::vector<double> activation;
+    std::vector<double> normTendonForce;
+    std::vector<double> normTendonForceDerivative;
+    std::vector<double> normTendonLength;
+    std::vector<double> tendonLength;
+    std::vector<double> fiberLengthAlongTendon;
+    std::vector<double> fiberLength;
+    std::vector<double> normFiberLength;
+    std::vector<double> cosPennationAngle;
+    std::vector<double> sinPennationAngle;
+    std::vector<double> pennationAngle;
+    std::vector<double> passiveForceMultiplier;
+    std::vector<double> activeForceMultiplier;
+    std::vector<double> forceVelocityMultiplier;
+    std::vector<double> normFiberVelocity;
+    std::vector<double> fiberVelocity;
+    std::vector<double> fiberVelocityAlongTendon;
+    std::vector<double> tendonVelocity;
+    std::vector<double> normTendonVelocity;
+    std::vector<double> pennationAngularVelocity;
+    std::vector<double> fiberStiffness;
+    std::vector<double> tendonStiffness;
+    // The indices of the muscles evaluated by each calculation. These are
+    // separate because evaluating velocity info may first evaluate length
+    // info, etc.
+    std::vector<int> lengthIndices;
+    std::vector<int> velocityIndices;
+    std::vector<int> dynamicsIndices;
+    void resize(int n) {
+        for (auto* v : {&muscleTendonLength, &muscleTendonVelocity,
+                     &activation, &normTendonForce, &normTendonForceDerivative,
+                     &normTendonLength, &tendonLength, &fiberLengthAlongTendon,
+                     &fiberLength, &normFiberLength, &cosPennationAngle,
+                     &sinPennationAngle, &pennationAngle,
+                     &passiveForceMultiplier, &activeForceMultiplier,
+                     &forceVelocityMultiplier, &normFiberVelocity,
+                     &fiberVelocity, &fiberVelocityAlongTendon, &tendonVelocity,
+                     &normTendonVelocity, &pennationAngularVelocity,
+                     &fiberStiffness, &tendonStiffness}) {
+            v->resize(n);
+        }
+    }
+};
+thread_local Workspace workspace;
+} // namespace
+
+void DeGrooteFregly2016MuscleGroup::Parameters::resize(int n) {
+    for (auto* v : {&maxIsometricForce, &optimalFiberLength,
+                 &tendonSlackLength, &fiberWidth, &squareFiberWidth,
+                 &maxContractionVelocity, &kT, &activeForceWidthScale,
+                 &passiveForceScale, &passiveFiberStrain, &passiveForceOffset,
+                 &passiveForceDenominator}) {
+        v->resize(n);
+    }
+    ignoreTendonCompliance.resize(n);
+    isTendonDynamicsExplicit.resize(n);
+}
+
+void DeGrooteFregly2016MuscleGroup::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    m_muscles.clear();
+    // Order the muscles so that those using explicit tendon compliance dynamics
+    // come first; the fiber velocity calculation differs between these muscles
+    // and the others, and each set is then a contiguous range.
+    for (const bool explicitTendonDynamics : {true, false}) {
+        for (auto& muscle : model.updComponentList<DGF>()) {
+            if ((muscle.m_isTendonDynamicsExplicit &&
+                        !muscle.get_ignore_tendon_compliance()) ==
+                    explicitTendonDynamics) {
+                muscle.m_group.reset(this);
+                m_muscles.emplace_back(&muscle);
+            }
+        }
+    }
+
+    const int numMuscles = (int)m_muscles.size();
+    m_params.resize(numMuscles);
+    for (int i = 0; i < numMuscles; ++i) {
+        const auto& muscle = m_muscles[i].getRef();
+        m_params.maxIsometricForce[i] = muscle.get_max_isometric_force();
+        m_params.optimalFiberLength[i] = muscle.get_optimal_fiber_length();
+        m_params.tendonSlackLength[i] = muscle.get_tendon_slack_length();
+        m_params.fiberWidth[i] = muscle.m_fiberWidth;
+        m_params.squareFiberWidth[i] = muscle.m_squareFiberWidth;
+        m_params.maxContractionVelocity[i] =
+                muscle.m_maxContractionVelocityInMetersPerSecond;
+        m_params.kT[i] = muscle.m_kT;
+        m_params.activeForceWidthScale[i] =
+                muscle.get_active_force_width_scale();
+        m_params.passiveForceScale[i] =
+                muscle.get_ignore_passive_fiber_force() ? 0.0 : 1.0;
+        const double e0 = muscle.get_passive_fiber_strain_at_one_norm_force();
+        m_params.passiveFiberStrain[i] = e0;
+        m_params.passiveForceOffset[i] =
+                exp(DGF::kPE * (DGF::m_minNormFiberLength - 1.0) / e0);
+        m_params.passiveForceDenominator[i] =
+                exp(DGF::kPE) - m_params.passiveForceOffset[i];
+        m_params.ignoreTendonCompliance[i] =
+                muscle.get_ignore_tendon_compliance();
+        m_params.isTendonDynamicsExplicit[i] =
+                muscle.m_isTendonDynamicsExplicit &&
+                !muscle.get_ignore_tendon_compliance();
+    }
+}
+
+std::vector<std::string> DeGrooteFregly2016MuscleGroup::getMuscleNames() const {
+    std::vector<std::string> names;
+    for (const auto& muscle : m_muscles) {
+        names.push_back(muscle->getAbsolutePathString());
+    }
+    return names;
+}
+
+std::vector<DGF::FiberEquilibriumStatistics>
+DeGrooteFregly2016MuscleGroup::solveFiberEquilibria(SimTK::State& s) const {
+    std::vector<const DGF*> muscles;
+    std::vector<double> activation;
+    std::vector<double> muscleTendonLength;
+    std::vector<double> muscleTendonVelocity;
+    std::vector<int> indices;
+    for (int i = 0; i < (int)m_muscles.size(); ++i) {
+        const auto& muscle = m_muscles[i].getRef();
+        if (muscle.get_ignore_tendon_compliance()) continue;
+        muscles.push_back(&muscle);
+        activation.push_back(muscle.getActivation(s));
+        muscleTendonLength.push_back(muscle.getLength(s));
+        muscleTendonVelocity.push_back(muscle.getLengtheningSpeed(s));
+        indices.push_back(i);
+    }
+    std::vector<double> normTendonForce;
+    std::vector<DGF::FiberEquilibriumStatistics> compliantStatistics;
+    DGF::solveFiberEquilibria(muscles, activation, muscleTendonLength,
+            muscleTendonVelocity, normTendonForce, compliantStatistics);
+
+    // There is nothing to solve for muscles with rigid tendons.
+    std::vector<DGF::FiberEquilibriumStatistics> statistics(m_muscles.size());
+    for (auto& stats : statistics) stats.converged = true;
+    for (int k = 0; k < (int)muscles.size(); ++k) {
+        muscles[k]->setNormalizedTendonForce(s, normTendonForce[k]);
+        statistics[indices[k]] = compliantStatistics[k];
+    }
+    return statistics;
+}
+
+void DeGrooteFregly2016MuscleGroup::findStaleMuscles(const SimTK::State& s,
+        const DGF& caller, const std::string& cacheVariable,
+        std::vector<int>& indices) const {
+    indices.clear();
+    for (int i = 0; i < (int)m_muscles.size(); ++i) {
+        const auto& muscle = m_muscles[i].getRef();
+        if (&muscle == &caller ||
+                !muscle.isCacheVariableValid(s, cacheVariable)) {
+            indices.push_back(i);
+        }
+    }
+}
+
+void DeGrooteFregly2016MuscleGroup::calcMuscleLengthInfos(
+        const SimTK::State& s, const DGF& caller,
+        DGF::MuscleLengthInfo& callerMLI) const {
+    using SimTK::square;
+    auto& w = workspace;
+    const auto& p = m_params;
+    // Only the muscles whose info is not yet computed are evaluated. The
+    // workspace index k corresponds to muscle index idx[k].
+    auto& idx = w.lengthIndices;
+    findStaleMuscles(s, caller, "lengthInfo", idx);
+    const int m = (int)idx.size();
+    w.resize(m);
+
+    // Gather inputs.
+    // --------------
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        const auto& muscle = m_muscles[i].getRef();
+        w.muscleTendonLength[k] = muscle.getLength(s);
+        // For a rigid tendon, use a value that keeps log() below finite.
+        w.normTendonForce[k] = p.ignoreTendonCompliance[i]
+                                       ? DGF::c1 - DGF::c3
+                                       : muscle.getNormalizedTendonForce(s);
+    }
+
+    // Tendon.
+    // -------
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        w.normTendonLength[k] =
+                log((1.0 / DGF::c1) * (w.normTendonForce[k] + DGF::c3)) /
+                        p.kT[i] +
+                DGF::c2;
+    }
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        if (p.ignoreTendonCompliance[i]) w.normTendonLength[k] = 1.0;
+        w.tendonLength[k] = p.tendonSlackLength[i] * w.normTendonLength[k];
+    }
+
+    // Fiber and pennation.
+    // --------------------
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        w.fiberLengthAlongTendon[k] =
+                w.muscleTendonLength[k] - w.tendonLength[k];
+        w.fiberLength[k] = sqrt(square(w.fiberLengthAlongTendon[k]) +
+                                p.squareFiberWidth[i]);
+        w.normFiberLength[k] = w.fiberLength[k] / p.optimalFiberLength[i];
+        w.cosPennationAngle[k] =
+                w.fiberLengthAlongTendon[k] / w.fiberLength[k];
+        w.sinPennationAngle[k] = p.fiberWidth[i] / w.fiberLength[k];
+    }
+    for (int k = 0; k < m; ++k) {
+        w.pennationAngle[k] = asin(w.sinPennationAngle[k]);
+    }
+
+    // Multipliers.
+    // ------------
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        w.passiveForceMultiplier[k] =
+                p.passiveForceScale[i] *
+                (exp(DGF::kPE * (w.normFiberLength[k] - 1.0) /
+                         p.passiveFiberStrain[i]) -
+                        p.passiveForceOffset[i]) /
+                p.passiveForceDenominator[i];
+    }
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        const double x = (w.normFiberLength[k] - 1.0) /
+                                 p.activeForceWidthScale[i] +
+                         1.0;
+        w.activeForceMultiplier[k] =
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b11, DGF::b21, DGF::b31, DGF::b41) +
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b12, DGF::b22, DGF::b32, DGF::b42) +
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b13, DGF::b23, DGF::b33, DGF::b43);
+    }
+
+    // Scatter outputs.
+    // ----------------
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        const auto& muscle = m_muscles[i].getRef();
+        const bool isCaller = &muscle == &caller;
+        auto& mli = isCaller ? callerMLI : muscle.updMuscleLengthInfo(s);
+        mli.normTendonLength = w.normTendonLength[k];
+        mli.tendonStrain = w.normTendonLength[k] - 1.0;
+        mli.tendonLength = w.tendonLength[k];
+        mli.fiberLengthAlongTendon = w.fiberLengthAlongTendon[k];
+        mli.fiberLength = w.fiberLength[k];
+        mli.normFiberLength = w.normFiberLength[k];
+        mli.cosPennationAngle = w.cosPennationAngle[k];
+        mli.sinPennationAngle = w.sinPennationAngle[k];
+        mli.pennationAngle = w.pennationAngle[k];
+        mli.fiberPassiveForceLengthMultiplier = w.passiveForceMultiplier[k];
+        mli.fiberActiveForceLengthMultiplier = w.activeForceMultiplier[k];
+        if (!isCaller) muscle.markCacheVariableValid(s, "lengthInfo");
+
+        if (mli.tendonLength < p.tendonSlackLength[i]) {
+            log_info("DeGrooteFregly2016Muscle '{}' is buckling (length < "
+                     "tendon_slack_length) at time {} s.",
+                    muscle.getName(), s.getTime());
+        }
+    }
+}
+
+void DeGrooteFregly2016MuscleGroup::calcFiberVelocityInfos(
+        const SimTK::State& s, const DGF& caller,
+        DGF::FiberVelocityInfo& callerFVI) const {
+    using SimTK::square;
+    auto& w = workspace;
+    const auto& p = m_params;
+    auto& idx = w.velocityIndices;
+    findStaleMuscles(s, caller, "velInfo", idx);
+    const int m = (int)idx.size();
+
+    // Ensure the length info is available for these muscles (this may invoke
+    // calcMuscleLengthInfos(), which uses the workspace).
+    for (int k = 0; k < m; ++k) m_muscles[idx[k]]->getMuscleLengthInfo(s);
+    w.resize(m);
+
+    // Gather inputs.
+    // --------------
+    // The muscles are ordered such that those using explicit tendon
+    // compliance dynamics come first, so workspace indices [0, numExplicit)
+    // are for these muscles.
+    int numExplicit = 0;
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        const auto& muscle = m_muscles[i].getRef();
+        const auto& mli = muscle.getMuscleLengthInfo(s);
+        w.muscleTendonVelocity[k] = muscle.getLengtheningSpeed(s);
+        w.activation[k] = muscle.getActivation(s);
+        w.normTendonLength[k] = mli.normTendonLength;
+        w.fiberLength[k] = mli.fiberLength;
+        w.fiberLengthAlongTendon[k] = mli.fiberLengthAlongTendon;
+        w.cosPennationAngle[k] = mli.cosPennationAngle;
+        w.passiveForceMultiplier[k] = mli.fiberPassiveForceLengthMultiplier;
+        w.activeForceMultiplier[k] = mli.fiberActiveForceLengthMultiplier;
+        if (p.isTendonDynamicsExplicit[i]) {
+            w.normTendonForce[k] = muscle.getNormalizedTendonForce(s);
+            ++numExplicit;
+        } else {
+            // A rigid tendon has zero velocity.
+            w.normTendonForceDerivative[k] =
+                    p.ignoreTendonCompliance[i]
+                            ? 0.0
+                            : muscle.getNormalizedTendonForceDerivative(s);
+        }
+    }
+
+    // Explicit tendon compliance dynamics: invert the force-velocity curve.
+    // ---------------------------------------------------------------------
+    for (int k = 0; k < numExplicit; ++k) {
+        const double normFiberForce =
+                w.normTendonForce[k] / w.cosPennationAngle[k];
+        w.forceVelocityMultiplier[k] =
+                (normFiberForce - w.passiveForceMultiplier[k]) /
+                (w.activation[k] * w.activeForceMultiplier[k]);
+    }
+    for (int k = 0; k < numExplicit; ++k) {
+        w.normFiberVelocity[k] =
+                (sinh(1.0 / DGF::d1 *
+                          (w.forceVelocityMultiplier[k] - DGF::d4)) -
+                        DGF::d3) /
+                DGF::d2;
+    }
+    for (int k = 0; k < numExplicit; ++k) {
+        const int i = idx[k];
+        w.fiberVelocity[k] =
+                w.normFiberVelocity[k] * p.maxContractionVelocity[i];
+        w.fiberVelocityAlongTendon[k] =
+                w.fiberVelocity[k] / w.cosPennationAngle[k];
+        w.tendonVelocity[k] =
+                w.muscleTendonVelocity[k] - w.fiberVelocityAlongTendon[k];
+        w.normTendonVelocity[k] =
+                w.tendonVelocity[k] / p.tendonSlackLength[i];
+    }
+
+    // Implicit tendon compliance dynamics or rigid tendon.
+    // ----------------------------------------------------
+    for (int k = numExplicit; k < m; ++k) {
+        const int i = idx[k];
+        w.normTendonVelocity[k] =
+                w.normTendonForceDerivative[k] /
+                (DGF::c1 * p.kT[i] *
+                        exp(p.kT[i] * (w.normTendonLength[k] - DGF::c2)));
+    }
+    for (int k = numExplicit; k < m; ++k) {
+        const int i = idx[k];
+        w.tendonVelocity[k] = p.tendonSlackLength[i] * w.normTendonVelocity[k];
+        w.fiberVelocityAlongTendon[k] =
+                w.muscleTendonVelocity[k] - w.tendonVelocity[k];
+        w.fiberVelocity[k] =
+                w.fiberVelocityAlongTendon[k] * w.cosPennationAngle[k];
+        w.normFiberVelocity[k] =
+                w.fiberVelocity[k] / p.maxContractionVelocity[i];
+    }
+    for (int k = numExplicit; k < m; ++k) {
+        const double tempV = DGF::d2 * w.normFiberVelocity[k] + DGF::d3;
+        w.forceVelocityMultiplier[k] =
+                DGF::d1 * log(tempV + sqrt(square(tempV) + 1.0)) + DGF::d4;
+    }
+
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        const double tanPennationAngle =
+                p.fiberWidth[i] / w.fiberLengthAlongTendon[k];
+        w.pennationAngularVelocity[k] =
+                -w.fiberVelocity[k] / w.fiberLength[k] * tanPennationAngle;
+    }
+
+    // Scatter outputs.
+    // ----------------
+    for (int k = 0; k < m; ++k) {
+        const auto& muscle = m_muscles[idx[k]].getRef();
+        const bool isCaller = &muscle == &caller;
+        auto& fvi = isCaller ? callerFVI : muscle.updFiberVelocityInfo(s);
+        fvi.fiberForceVelocityMultiplier = w.forceVelocityMultiplier[k];
+        fvi.normFiberVelocity = w.normFiberVelocity[k];
+        fvi.fiberVelocity = w.fiberVelocity[k];
+        fvi.fiberVelocityAlongTendon = w.fiberVelocityAlongTendon[k];
+        fvi.tendonVelocity = w.tendonVelocity[k];
+        fvi.normTendonVelocity = w.normTendonVelocity[k];
+        fvi.pennationAngularVelocity = w.pennationAngularVelocity[k];
+        if (!isCaller) muscle.markCacheVariableValid(s, "velInfo");
+
+        if (fvi.normFiberVelocity < -1.0) {
+            log_info("DeGrooteFregly2016Muscle '{}' is exceeding maximum "
+                     "contraction velocity at time {} s.",
+                    muscle.getName(), s.getTime());
+        }
+    }
+}
+
+void DeGrooteFregly2016MuscleGroup::calcMuscleDynamicsInfos(
+        const SimTK::State& s, const DGF& caller,
+        DGF::MuscleDynamicsInfo& callerMDI) const {
+    auto& w = workspace;
+    const auto& p = m_params;
+    auto& idx = w.dynamicsIndices;
+    findStaleMuscles(s, caller, "dynamicsInfo", idx);
+    const int m = (int)idx.size();
+
+    // Ensure the velocity info is available for these muscles (this may
+    // invoke calcMuscleLengthInfos() and calcFiberVelocityInfos()).
+    for (int k = 0; k < m; ++k) m_muscles[idx[k]]->getFiberVelocityInfo(s);
+    w.resize(m);
+
+    // Gather inputs.
+    // --------------
+    for (int k = 0; k < m; ++k) {
+        const auto& muscle = m_muscles[idx[k]].getRef();
+        const auto& mli = muscle.getMuscleLengthInfo(s);
+        w.activation[k] = muscle.getActivation(s);
+        w.normFiberLength[k] = mli.normFiberLength;
+        w.normTendonLength[k] = mli.normTendonLength;
+        w.forceVelocityMultiplier[k] =
+                muscle.getFiberVelocityInfo(s).fiberForceVelocityMultiplier;
+    }
+
+    // Stiffnesses; see calcFiberStiffness() and calcTendonStiffness().
+    // ----------------------------------------------------------------
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        const double scale = p.activeForceWidthScale[i];
+        const double x = (w.normFiberLength[k] - 1.0) / scale + 1.0;
+        const double activeForceMultiplierDerivative =
+                (1.0 / scale) *
+                (DGF::calcGaussianLikeCurveDerivative(
+                         x, DGF::b11, DGF::b21, DGF::b31, DGF::b41) +
+                        DGF::calcGaussianLikeCurveDerivative(
+                                x, DGF::b12, DGF::b22, DGF::b32, DGF::b42) +
+                        DGF::calcGaussianLikeCurveDerivative(
+                                x, DGF::b13, DGF::b23, DGF::b33, DGF::b43));
+        const double e0 = p.passiveFiberStrain[i];
+        const double passiveForceMultiplierDerivative =
+                p.passiveForceScale[i] * DGF::kPE *
+                exp(DGF::kPE * (w.normFiberLength[k] - 1.0) / e0) /
+                (e0 * p.passiveForceDenominator[i]);
+        w.fiberStiffness[k] =
+                p.maxIsometricForce[i] / p.optimalFiberLength[i] *
+                (w.activation[k] * activeForceMultiplierDerivative *
+                                w.forceVelocityMultiplier[k] +
+                        passiveForceMultiplierDerivative);
+    }
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        w.tendonStiffness[k] =
+                p.maxIsometricForce[i] / p.tendonSlackLength[i] * DGF::c1 *
+                p.kT[i] * exp(p.kT[i] * (w.normTendonLength[k] - DGF::c2));
+    }
+
+    // Assemble the remaining (inexpensive) entries for each muscle.
+    // -------------------------------------------------------------
+    for (int k = 0; k < m; ++k) {
+        const int i = idx[k];
+        const auto& muscle = m_muscles[i].getRef();
+        const bool isCaller = &muscle == &caller;
+        auto& mdi = isCaller ? callerMDI : muscle.updMuscleDynamicsInfo(s);
+        const bool ignoreTendonCompliance = p.ignoreTendonCompliance[i];
+        muscle.calcMuscleDynamicsInfoHelper(w.activation[k],
+                muscle.getLengtheningSpeed(s), ignoreTendonCompliance,
+                muscle.getMuscleLengthInfo(s), muscle.getFiberVelocityInfo(s),
+                mdi,
+                ignoreTendonCompliance ? SimTK::NaN
+                                       : muscle.getNormalizedTendonForce(s),
+                w.fiberStiffness[k],
+                ignoreTendonCompliance ? SimTK::Infinity
+                                       : w.tendonStiffness[k]);
+        if (!isCaller) muscle.markCacheVariableValid(s, "dynamicsInfo");
+    }
+}
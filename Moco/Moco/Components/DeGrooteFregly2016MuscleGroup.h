@@ -0,0 +1,126 @@
+#ifndef MOCO_DEGROOTEFREGLY2016MUSCLEGROUP_H
+#define MOCO_DEGROOTEFREGLY2016MUSCLEGROUP_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: DeGrooteFregly2016MuscleGroup.h                              *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016Muscle.h"
+
+#include <OpenSim/Simulation/Model/ModelComponent.h>
+
+namespace OpenSim {
+
+/// This component evaluates the MuscleLengthInfo, FiberVelocityInfo, and
+/// MuscleDynamicsInfo of all DeGrooteFregly2016Muscle%s in a model at once,
+/// rather than one muscle at a time. Add this component to a model that
+/// contains many DeGrooteFregly2016Muscle%s to speed up the evaluation of the
+/// muscles' curves (exp, log, etc.).
+///
+/// When any muscle's length, velocity, or dynamics info is requested, this
+/// component gathers the inputs of every muscle whose info is not yet
+/// computed into contiguous arrays, evaluates the curves for only these
+/// muscles in simple loops that the compiler can vectorize, and writes the
+/// results into each muscle's cache entry. The results are the same as those
+/// computed by each muscle on its own.
+///
+/// This component has no properties; the muscle parameters are gathered from
+/// the muscles whenever the model's system is created. Only one such
+/// component should be added to a model.
+///
+/// @code
+/// model.addComponent(new DeGrooteFregly2016MuscleGroup());
+/// @endcode
+///
+/// @underdevelopment
+class OSIMMOCO_API DeGrooteFregly2016MuscleGroup : public ModelComponent {
+    OpenSim_DECLARE_CONCRETE_OBJECT(
+            DeGrooteFregly2016MuscleGroup, ModelComponent);
+
+public:
+    DeGrooteFregly2016MuscleGroup() = default;
+
+    /// The number of muscles whose evaluation is batched by this component.
+    int getNumMuscles() const { return (int)m_muscles.size(); }
+
+    /// Set the normalized tendon force of all muscles with compliant tendons
+    /// such that their fibers and tendons are in equilibrium. This is
+    /// equivalent to invoking
+    /// DeGrooteFregly2016Muscle::solveFiberEquilibrium() on each muscle, but
+    /// the Newton iterations of all muscles advance together. The state must
+    /// be realized to Stage::Velocity. The returned statistics are ordered as
+    /// getMuscleNames().
+    std::vector<DeGrooteFregly2016Muscle::FiberEquilibriumStatistics>
+    solveFiberEquilibria(SimTK::State& s) const;
+
+    /// The absolute paths of the muscles in this group, in the order used
+    /// internally.
+    std::vector<std::string> getMuscleNames() const;
+
+protected:
+    void extendConnectToModel(Model& model) override;
+
+private:
+    friend DeGrooteFregly2016Muscle;
+
+    /// The indices (into m_muscles) of `caller` and of the muscles whose
+    /// cache variable `cacheVariable` is not valid.
+    void findStaleMuscles(const SimTK::State& s,
+            const DeGrooteFregly2016Muscle& caller,
+            const std::string& cacheVariable, std::vector<int>& indices) const;
+    /// Compute the MuscleLengthInfo of all muscles whose MuscleLengthInfo is
+    /// not already valid. The info for `caller` is written to `callerMLI`
+    /// rather than to its cache entry.
+    void calcMuscleLengthInfos(const SimTK::State& s,
+            const DeGrooteFregly2016Muscle& caller,
+            DeGrooteFregly2016Muscle::MuscleLengthInfo& callerMLI) const;
+    void calcFiberVelocityInfos(const SimTK::State& s,
+            const DeGrooteFregly2016Muscle& caller,
+            DeGrooteFregly2016Muscle::FiberVelocityInfo& callerFVI) const;
+    void calcMuscleDynamicsInfos(const SimTK::State& s,
+            const DeGrooteFregly2016Muscle& caller,
+            DeGrooteFregly2016Muscle::MuscleDynamicsInfo& callerMDI) const;
+
+    std::vector<SimTK::ReferencePtr<const DeGrooteFregly2016Muscle>>
+            m_muscles;
+
+    // Muscle parameters, in structure-of-arrays form. The index is the index
+    // of the muscle in m_muscles.
+    struct Parameters {
+        std::vector<double> maxIsometricForce;
+        std::vector<double> optimalFiberLength;
+        std::vector<double> tendonSlackLength;
+        std::vector<double> fiberWidth;
+        std::vector<double> squareFiberWidth;
+        std::vector<double> maxContractionVelocity;
+        std::vector<double> kT;
+        std::vector<double> activeForceWidthScale;
+        // Multiplies the passive force-length curve; 0 if the passive fiber
+        // force is ignored.
+        std::vector<double> passiveForceScale;
+        std::vector<double> passiveFiberStrain;
+        std::vector<double> passiveForceOffset;
+        std::vector<double> passiveForceDenominator;
+        std::vector<char> ignoreTendonCompliance;
+        std::vector<char> isTendonDynamicsExplicit;
+        void resize(int n);
+    };
+    Parameters m_params;
+};
+
+} // namespace OpenSim
+
+#endif // MOCO_DEGROOTEFREGLY2016MUSCLEGROUP_H
@@ -64,34 +64,19 @@ public:
             coefficients(coefficients), dimension(dimension), order(order) {
         OPENSIM_THROW_IF(dimension < 0 || dimension > 4, Exception,
                 "Expected dimension >= 0 && <=4 but got {}.", dimension);
-        std::array<int, 4> nq {{0, 0, 0, 0}};
-        int coeff_nr = 0;
-        for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
-            int nq2_s;
-            if (dimension < 2) nq2_s = 0;
-            else nq2_s = order - nq[0];
-            for (nq[1] = 0; nq[1] < nq2_s + 1; ++nq[1]) {
-                int nq3_s;
-                if (dimension < 3) nq3_s = 0;
-                else nq3_s = order - nq[0] - nq[1];
-                for (nq[2] = 0; nq[2] < nq3_s + 1; ++nq[2]) {
-                    int nq4_s;
-                    if (dimension < 4) nq4_s = 0;
-                    else nq4_s = order - nq[0] - nq[1] - nq[2];
-                    for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) {
-                        ++coeff_nr;
-                    }
-                }
-            }
-        }
+        exponents = createExponents(dimension, order);
+        const int coeff_nr = (int)exponents.size();
         OPENSIM_THROW_IF(coefficients.size() != coeff_nr, Exception,
                 "Expected {} coefficients but got {}.", coeff_nr,
                 coefficients.size());
     }
-    T calcValue(const SimTK::Vector& x) const override {
+    /// The powers of each dependent component for each term of the
+    /// polynomial, in the order of the coefficients (see the table above).
+    /// Powers for components beyond the dimension are zero.
+    static std::vector<std::array<int, 4>> createExponents(
+            int dimension, int order) {
+        std::vector<std::array<int, 4>> exponents;
         std::array<int, 4> nq {{0, 0, 0, 0}};
-        T value = static_cast<T>(0);
-        int coeff_nr = 0;
         for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
             int nq2_s;
             if (dimension < 2) nq2_s = 0;
@@ -105,83 +90,48 @@ public:
                     if (dimension < 4) nq4_s = 0;
                     else nq4_s = order - nq[0] - nq[1] - nq[2];
                     for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) {
-                        T valueP = static_cast<T>(1);
-                        for (int i = 0; i < dimension; ++i) {
-                            valueP *= std::pow(x[i], nq[i]);
-                        }
-                        value += valueP * coefficients[coeff_nr];
-                        ++coeff_nr;
+                        exponents.push_back(nq);
                     }
                 }
             }
         }
-        return value;
+        return exponents;
+    }
+    T calcValue(const SimTK::Vector& x) const override {
+        switch (dimension) {
+        case 0: return calcValueImpl<0>(x);
+        case 1: return calcValueImpl<1>(x);
+        case 2: return calcValueImpl<2>(x);
+        case 3: return calcValueImpl<3>(x);
+        default: return calcValueImpl<4>(x);
+        }
     }
     T calcDerivative(const SimTK::Array_<int>& derivComponent,
                      const SimTK::Vector& x) const override {
-        std::array<int, 4> nq {{0, 0, 0, 0}};
-        T value = static_cast<T>(0);
-        int nqNonNegative;
-        int coeff_nr = 0;
-        for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
-            int nq2_s;
-            if (dimension < 2) nq2_s = 0;
-            else nq2_s = order - nq[0];
-            for (nq[1] = 0; nq[1] < nq2_s + 1; ++nq[1]) {
-                int nq3_s;
-                if (dimension < 3) nq3_s = 0;
-                else nq3_s = order - nq[0] - nq[1];
-                for (nq[2] = 0; nq[2] < nq3_s + 1; ++nq[2]) {
-                    int nq4_s;
-                    if (dimension < 4) nq4_s = 0;
-                    else nq4_s = order - nq[0] - nq[1] - nq[2];
-                    for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) {
-                        if (derivComponent[0] == 0) {
-                            nqNonNegative = nq[0] - 1;
-                            if (nqNonNegative < 0) nqNonNegative = 0;
-                            T valueP = nq[0] * std::pow(x[0], nqNonNegative);
-                            for (int i = 0; i < dimension; ++i) {
-                                if (i == derivComponent[0]) continue;
-                                valueP *= std::pow(x[i], nq[i]);
-                            }
-                            value += valueP * coefficients[coeff_nr];
-                        }
-                        else if (derivComponent[0] == 1) {
-                            nqNonNegative = nq[1] - 1;
-                            if (nqNonNegative < 0) nqNonNegative = 0;
-                            T valueP = nq[1] * std::pow(x[1], nqNonNegative);
-                            for (int i = 0; i < dimension; ++i) {
-                                if (i == derivComponent[0]) continue;
-                                valueP *= std::pow(x[i], nq[i]);
-                            }
-                            value += valueP * coefficients[coeff_nr];
-                        }
-                        else if (derivComponent[0] == 2) {
-                            nqNonNegative = nq[2] - 1;
-                            if (nqNonNegative < 0) nqNonNegative = 0;
-                            T valueP = nq[2] * std::pow(x[2], nqNonNegative);
-                            for (int i = 0; i < dimension; ++i) {
-                                if (i == derivComponent[0]) continue;
-                                valueP *= std::pow(x[i], nq[i]);
-                            }
-                            value += valueP * coefficients[coeff_nr];
-                        }
-                        else if (derivComponent[0] == 3) {
-                            nqNonNegative = nq[3] - 1;
-                            if (nqNonNegative < 0) nqNonNegative = 0;
-                            T valueP = nq[3] * std::pow(x[3], nqNonNegative);
-                            for (int i = 0; i < dimension; ++i) {
-                                if (i == derivComponent[0]) continue;
-                                valueP *= std::pow(x[i], nq[i]);
-                            }
-                            value += valueP * coefficients[coeff_nr];
-                        }
-                        ++coeff_nr;
-                    }
-                }
-            }
+        if (derivComponent[0] < 0 || derivComponent[0] >= dimension) {
+            return static_cast<T>(0);
+        }
+        switch (dimension) {
+        case 1: return calcDerivativeImpl<1>(derivComponent[0], x);
+        case 2: return calcDerivativeImpl<2>(derivComponent[0], x);
+        case 3: return calcDerivativeImpl<3>(derivComponent[0], x);
+        default: return calcDerivativeImpl<4>(derivComponent[0], x);
+        }
+    }
+    /// Compute the value of the polynomial and its first derivative with
+    /// respect to each dependent component, in a single pass over the terms.
+    /// This is cheaper than invoking calcValue() and calcDerivative() for
+    /// each component. The gradient is resized to the dimension.
+    T calcValueAndGradient(
+            const SimTK::Vector& x, SimTK::Vector_<T>& gradient) const {
+        gradient.resize(dimension);
+        switch (dimension) {
+        case 0: return calcValueImpl<0>(x);
+        case 1: return calcValueAndGradientImpl<1>(x, gradient);
+        case 2: return calcValueAndGradientImpl<2>(x, gradient);
+        case 3: return calcValueAndGradientImpl<3>(x, gradient);
+        default: return calcValueAndGradientImpl<4>(x, gradient);
         }
-        return value;
     }
     int getArgumentSize() const override {
         return dimension;
@@ -197,9 +147,106 @@ public:
         return calcDerivative(SimTK::ArrayViewConst_<int>(derivComponent), x);
     }
 private:
+    // Polynomials of up to this order use power tables on the stack.
+    static constexpr int maxStackOrder = 15;
+
+    /// Table of powers, such that powers[i * (order + 1) + k] is x[i]^k.
+    /// Each power is obtained from the previous power with a single
+    /// multiplication.
+    class PowerTable {
+    public:
+        template <int Dim>
+        void compute(const SimTK::Vector& x, int order) {
+            stride = order + 1;
+            if (order > maxStackOrder) {
+                heapPowers.resize(Dim * stride);
+                powers = heapPowers.data();
+            } else {
+                powers = stackPowers.data();
+            }
+            for (int i = 0; i < Dim; ++i) {
+                T* p = powers + i * stride;
+                p[0] = static_cast<T>(1);
+                for (int k = 1; k < stride; ++k) p[k] = p[k - 1] * x[i];
+            }
+        }
+        const T& operator()(int i, int k) const {
+            return powers[i * stride + k];
+        }
+    private:
+        std::array<T, 4 * (maxStackOrder + 1)> stackPowers;
+        std::vector<T> heapPowers;
+        T* powers = nullptr;
+        int stride = 0;
+    };
+
+    template <int Dim>
+    T calcValueImpl(const SimTK::Vector& x) const {
+        PowerTable powers;
+        powers.template compute<Dim>(x, order);
+        T value = static_cast<T>(0);
+        for (int icoeff = 0; icoeff < (int)exponents.size(); ++icoeff) {
+            const auto& nq = exponents[icoeff];
+            T valueP = coefficients[icoeff];
+            for (int i = 0; i < Dim; ++i) valueP *= powers(i, nq[i]);
+            value += valueP;
+        }
+        return value;
+    }
+    template <int Dim>
+    T calcDerivativeImpl(int derivComponent, const SimTK::Vector& x) const {
+        PowerTable powers;
+        powers.template compute<Dim>(x, order);
+        T value = static_cast<T>(0);
+        for (int icoeff = 0; icoeff < (int)exponents.size(); ++icoeff) {
+            const auto& nq = exponents[icoeff];
+            if (nq[derivComponent] == 0) continue;
+            T valueP = nq[derivComponent] * coefficients[icoeff];
+            for (int i = 0; i < Dim; ++i) {
+                valueP *= powers(i, i == derivComponent ? nq[i] - 1 : nq[i]);
+            }
+            value += valueP;
+        }
+        return value;
+    }
+    template <int Dim>
+    T calcValueAndGradientImpl(
+            const SimTK::Vector& x, SimTK::Vector_<T>& gradient) const {
+        PowerTable powers;
+        powers.template compute<Dim>(x, order);
+        T value = static_cast<T>(0);
+        std::array<T, Dim> grad;
+        grad.fill(static_cast<T>(0));
+        for (int icoeff = 0; icoeff < (int)exponents.size(); ++icoeff) {
+            const auto& nq = exponents[icoeff];
+            // The product of the powers of all components except one, for
+            // each component, from prefix and suffix products.
+            std::array<T, Dim + 1> prefix;
+            std::array<T, Dim + 1> suffix;
+            prefix[0] = static_cast<T>(1);
+            suffix[Dim] = static_cast<T>(1);
+            for (int i = 0; i < Dim; ++i) {
+                prefix[i + 1] = prefix[i] * powers(i, nq[i]);
+            }
+            for (int i = Dim - 1; i >= 0; --i) {
+                suffix[i] = suffix[i + 1] * powers(i, nq[i]);
+            }
+            const T& coeff = coefficients[icoeff];
+            value += coeff * prefix[Dim];
+            for (int i = 0; i < Dim; ++i) {
+                if (nq[i] == 0) continue;
+                grad[i] += coeff * nq[i] * powers(i, nq[i] - 1) * prefix[i] *
+                           suffix[i + 1];
+            }
+        }
+        for (int i = 0; i < Dim; ++i) gradient[i] = grad[i];
+        return value;
+    }
+
     SimTK::Vector_<T> coefficients;
     int dimension;
     int order;
+    std::vector<std::array<int, 4>> exponents;
 };
 
 class OSIMMOCO_API MultivariatePolynomialFunction : public Function {
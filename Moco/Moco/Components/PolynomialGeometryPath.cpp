@@ -0,0 +1,303 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: PolynomialGeometryPath.cpp                                   *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "PolynomialGeometryPath.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace OpenSim;
+
+PolynomialGeometryPath::PolynomialGeometryPath() { constructProperties(); }
+
+PolynomialGeometryPath::PolynomialGeometryPath(const GeometryPath& path)
+        : GeometryPath(path) {
+    constructProperties();
+}
+
+void PolynomialGeometryPath::constructProperties() {
+    constructProperty_coordinate_paths();
+    constructProperty_length_function(MultivariatePolynomialFunction());
+}
+
+void PolynomialGeometryPath::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+    const auto& lengthFunction = get_length_function();
+    OPENSIM_THROW_IF_FRMOBJ(lengthFunction.getDimension() !=
+                                    getProperty_coordinate_paths().size(),
+            Exception,
+            "Expected the dimension of the length_function ({}) to equal "
+            "the number of coordinate_paths ({}).",
+            lengthFunction.getDimension(),
+            getProperty_coordinate_paths().size());
+    m_lengthFunction = std::make_shared<SimTKMultivariatePolynomial<double>>(
+            lengthFunction.getCoefficients(), lengthFunction.getDimension(),
+            lengthFunction.getOrder());
+}
+
+void PolynomialGeometryPath::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+    m_coordinates.clear();
+    for (int i = 0; i < getProperty_coordinate_paths().size(); ++i) {
+        m_coordinates.emplace_back(
+                &model.getComponent<Coordinate>(get_coordinate_paths(i)));
+    }
+}
+
+void PolynomialGeometryPath::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+    addCacheVariable<SimTK::Vector>("length_gradient",
+            SimTK::Vector((int)m_coordinates.size(), 0.0),
+            SimTK::Stage::Position);
+}
+
+void PolynomialGeometryPath::computeLengthAndGradient(
+        const SimTK::State& s) const {
+    if (isCacheVariableValid(s, "length_gradient")) return;
+    const int numCoords = (int)m_coordinates.size();
+    SimTK::Vector x(numCoords);
+    for (int i = 0; i < numCoords; ++i) {
+        x[i] = m_coordinates[i]->getValue(s);
+    }
+    auto& gradient = updCacheVariableValue<SimTK::Vector>(s, "length_gradient");
+    const double length = m_lengthFunction->calcValueAndGradient(x, gradient);
+    markCacheVariableValid(s, "length_gradient");
+
+    // Marking the current path as valid prevents GeometryPath from computing
+    // the path (and the length) from the path points.
+    setLength(s, length);
+    markCacheVariableValid(s, "current_path");
+}
+
+const SimTK::Vector& PolynomialGeometryPath::getLengthGradient(
+        const SimTK::State& s) const {
+    computeLengthAndGradient(s);
+    return getCacheVariableValue<SimTK::Vector>(s, "length_gradient");
+}
+
+void PolynomialGeometryPath::extendRealizePosition(
+        const SimTK::State& s) const {
+    Super::extendRealizePosition(s);
+    computeLengthAndGradient(s);
+}
+
+void PolynomialGeometryPath::extendRealizeVelocity(
+        const SimTK::State& s) const {
+    Super::extendRealizeVelocity(s);
+    const auto& gradient = getLengthGradient(s);
+    double speed = 0;
+    for (int i = 0; i < (int)m_coordinates.size(); ++i) {
+        speed += gradient[i] * m_coordinates[i]->getSpeedValue(s);
+    }
+    setLengtheningSpeed(s, speed);
+}
+
+double PolynomialGeometryPath::computeMomentArm(
+        const SimTK::State& s, const Coordinate& coord) const {
+    for (int i = 0; i < (int)m_coordinates.size(); ++i) {
+        if (m_coordinates[i].get() == &coord) {
+            return -getLengthGradient(s)[i];
+        }
+    }
+    return 0;
+}
+
+void PolynomialGeometryPath::addInEquivalentForces(const SimTK::State& s,
+        const double& tension, SimTK::Vector_<SimTK::SpatialVec>&,
+        SimTK::Vector& mobilityForces) const {
+    // The generalized force is the tension times the moment arm.
+    const auto& gradient = getLengthGradient(s);
+    const auto& matter = getModel().getMatterSubsystem();
+    for (int i = 0; i < (int)m_coordinates.size(); ++i) {
+        const auto& coord = *m_coordinates[i];
+        matter.addInMobilityForce(s,
+                SimTK::MobilizedBodyIndex(coord.getBodyIndex()),
+                SimTK::MobilizerUIndex(coord.getMobilizerQIndex()),
+                -tension * gradient[i], mobilityForces);
+    }
+}
+
+PolynomialGeometryPath PolynomialGeometryPath::fit(const Model& model,
+        const SimTK::State& stateIn, const GeometryPath& path, int order,
+        int numSamplesPerCoordinate, FittingError& error) {
+    OPENSIM_THROW_IF(order < 0, Exception,
+            "Expected order to be non-negative, but got {}.", order);
+    OPENSIM_THROW_IF(numSamplesPerCoordinate < 2, Exception,
+            "Expected numSamplesPerCoordinate to be at least 2, but got {}.",
+            numSamplesPerCoordinate);
+    SimTK::State state = stateIn;
+
+    // Determine the coordinates spanned by the path.
+    std::vector<const Coordinate*> coords;
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        if (coord.getLocked(state)) continue;
+        const double defaultValue = coord.getValue(state);
+        const double min = coord.getRangeMin();
+        const double max = coord.getRangeMax();
+        bool spanned = false;
+        for (const double value : {min, 0.5 * (min + max), max}) {
+            coord.setValue(state, value, false);
+            model.realizePosition(state);
+            if (std::abs(path.computeMomentArm(state, coord)) > 1e-8) {
+                spanned = true;
+                break;
+            }
+        }
+        coord.setValue(state, defaultValue, false);
+        if (!spanned) continue;
+        OPENSIM_THROW_IF(coord.isDependent(state), Exception,
+                "Path '{}' spans coordinate '{}', which is dependent, but "
+                "dependent coordinates are not supported.",
+                path.getAbsolutePathString(), coord.getAbsolutePathString());
+        coords.push_back(&coord);
+    }
+    const int numCoords = (int)coords.size();
+    OPENSIM_THROW_IF(numCoords > 4, Exception,
+            "Path '{}' spans {} coordinates, but at most 4 coordinates are "
+            "supported.",
+            path.getAbsolutePathString(), numCoords);
+    // A path that spans no coordinates has a constant length.
+    if (numCoords == 0) order = 0;
+
+    const auto exponents =
+            SimTKMultivariatePolynomial<double>::createExponents(
+                    numCoords, order);
+    const int numCoeffs = (int)exponents.size();
+    int numSamples = 1;
+    for (int ic = 0; ic < numCoords; ++ic) {
+        numSamples *= numSamplesPerCoordinate;
+    }
+
+    // Each sample contributes a row for the length and a row for the
+    // derivative of the length with respect to each coordinate (the negative
+    // of the moment arm).
+    const int numRowsPerSample = 1 + numCoords;
+    SimTK::Matrix A(numSamples * numRowsPerSample, numCoeffs, 0.0);
+    SimTK::Vector b(numSamples * numRowsPerSample, 0.0);
+    std::array<double, 4> x{{0, 0, 0, 0}};
+    for (int isample = 0; isample < numSamples; ++isample) {
+        // Convert the sample index into a grid index for each coordinate.
+        int remainder = isample;
+        for (int ic = numCoords - 1; ic >= 0; --ic) {
+            const int igrid = remainder % numSamplesPerCoordinate;
+            remainder /= numSamplesPerCoordinate;
+            const auto& coord = *coords[ic];
+            const double min = coord.getRangeMin();
+            const double max = coord.getRangeMax();
+            x[ic] = min + igrid * (max - min) / (numSamplesPerCoordinate - 1);
+            coord.setValue(state, x[ic], false);
+        }
+        model.realizePosition(state);
+
+        const int row = isample * numRowsPerSample;
+        b[row] = path.getLength(state);
+        for (int ic = 0; ic < numCoords; ++ic) {
+            b[row + 1 + ic] = -path.computeMomentArm(state, *coords[ic]);
+        }
+        for (int icoeff = 0; icoeff < numCoeffs; ++icoeff) {
+            const auto& exponent = exponents[icoeff];
+            double term = 1;
+            for (int ic = 0; ic < numCoords; ++ic) {
+                term *= std::pow(x[ic], exponent[ic]);
+            }
+            A(row, icoeff) = term;
+            for (int ic = 0; ic < numCoords; ++ic) {
+                if (exponent[ic] == 0) continue;
+                double derivative = exponent[ic];
+                for (int jc = 0; jc < numCoords; ++jc) {
+                    derivative *= std::pow(x[jc],
+                            jc == ic ? exponent[jc] - 1 : exponent[jc]);
+                }
+                A(row + 1 + ic, icoeff) = derivative;
+            }
+        }
+    }
+
+    SimTK::FactorQTZ qtz(A);
+    SimTK::Vector coefficients;
+    qtz.solve(b, coefficients);
+
+    const SimTK::Vector residual = A * coefficients - b;
+    error = FittingError();
+    error.numSamples = numSamples;
+    double lengthSumSquares = 0;
+    double momentArmSumSquares = 0;
+    error.lengthMax = 0;
+    error.momentArmMax = 0;
+    for (int isample = 0; isample < numSamples; ++isample) {
+        const int row = isample * numRowsPerSample;
+        lengthSumSquares += SimTK::square(residual[row]);
+        error.lengthMax = std::max(error.lengthMax, std::abs(residual[row]));
+        for (int ic = 0; ic < numCoords; ++ic) {
+            const double value = residual[row + 1 + ic];
+            momentArmSumSquares += SimTK::square(value);
+            error.momentArmMax = std::max(error.momentArmMax, std::abs(value));
+        }
+    }
+    error.lengthRMS = std::sqrt(lengthSumSquares / numSamples);
+    error.momentArmRMS = numCoords ? std::sqrt(momentArmSumSquares /
+                                               (numSamples * numCoords))
+                                   : 0;
+
+    PolynomialGeometryPath polynomialPath(path);
+    for (const auto* coord : coords) {
+        polynomialPath.append_coordinate_paths(coord->getAbsolutePathString());
+    }
+    polynomialPath.set_length_function(
+            MultivariatePolynomialFunction(coefficients, numCoords, order));
+    return polynomialPath;
+}
+
+void PolynomialGeometryPath::replacePaths(
+        Model& model, int order, int numSamplesPerCoordinate) {
+    const SimTK::State state = model.initSystem();
+
+    // Fit all paths before editing the model, since editing the model
+    // invalidates the system.
+    auto& muscles = model.updMuscles();
+    std::vector<std::unique_ptr<PolynomialGeometryPath>> polynomialPaths(
+            muscles.getSize());
+    for (int im = 0; im < muscles.getSize(); ++im) {
+        const auto& muscle = muscles.get(im);
+        FittingError error;
+        try {
+            polynomialPaths[im] = OpenSim::make_unique<PolynomialGeometryPath>(
+                    fit(model, state, muscle.getGeometryPath(), order,
+                            numSamplesPerCoordinate, error));
+        } catch (const Exception& e) {
+            log_warn("Could not fit a polynomial to the path of muscle '{}'; "
+                     "keeping its original path. {}",
+                    muscle.getName(), e.getMessage());
+            continue;
+        }
+        log_info("Fit a polynomial to the path of muscle '{}' ({} "
+                 "coordinates, {} samples): length error RMS {} m, max {} m; "
+                 "moment arm error RMS {} m, max {} m.",
+                muscle.getName(),
+                polynomialPaths[im]->getProperty_coordinate_paths().size(),
+                error.numSamples, error.lengthRMS, error.lengthMax,
+                error.momentArmRMS, error.momentArmMax);
+    }
+
+    for (int im = 0; im < muscles.getSize(); ++im) {
+        if (!polynomialPaths[im]) continue;
+        muscles.get(im).updProperty_GeometryPath().setValue(
+                *polynomialPaths[im]);
+    }
+    model.finalizeFromProperties();
+}
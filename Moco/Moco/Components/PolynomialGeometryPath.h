@@ -0,0 +1,139 @@
+#ifndef MOCO_POLYNOMIALGEOMETRYPATH_H
+#define MOCO_POLYNOMIALGEOMETRYPATH_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: PolynomialGeometryPath.h                                     *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MultivariatePolynomialFunction.h"
+
+#include <OpenSim/Simulation/Model/GeometryPath.h>
+
+namespace OpenSim {
+
+class Coordinate;
+
+/// A GeometryPath whose length is a multivariate polynomial of the values of
+/// up to four coordinates. The lengthening speed is the time derivative of
+/// the polynomial, the moment arm about each coordinate is the negative
+/// partial derivative of the polynomial with respect to the coordinate, and
+/// the tension in the path is applied to the model as generalized forces
+/// (tension times moment arm) rather than as forces on the path points.
+/// Evaluating the polynomial is much cheaper than computing the path through
+/// its path points and wrap objects, which speeds up the evaluation of models
+/// with many muscles.
+///
+/// The path points and wrap objects of the path are retained (for example,
+/// from the path from which the polynomial was fit) but are not used to
+/// compute the length, speed, moment arms, or forces, and are not
+/// visualized.
+///
+/// Use fit() or ModOpReplacePathsWithPolynomials to create a polynomial that
+/// approximates an existing path.
+///
+/// @note The length and lengthening speed are computed when the state is
+/// realized to Stage::Position and Stage::Velocity, respectively. Components
+/// that obtain the length of the path within their own realizePosition()
+/// obtain the length computed from the path points.
+///
+/// @underdevelopment
+class OSIMMOCO_API PolynomialGeometryPath : public GeometryPath {
+    OpenSim_DECLARE_CONCRETE_OBJECT(PolynomialGeometryPath, GeometryPath);
+
+public:
+    OpenSim_DECLARE_LIST_PROPERTY(coordinate_paths, std::string,
+            "Absolute paths to the coordinates on which the length of the "
+            "path depends, in the order of the dimensions of the "
+            "length_function.");
+    OpenSim_DECLARE_PROPERTY(length_function, MultivariatePolynomialFunction,
+            "The length of the path as a function of the values of the "
+            "coordinates in coordinate_paths.");
+
+    PolynomialGeometryPath();
+    /// Retain the path points and wrap objects of the provided path.
+    explicit PolynomialGeometryPath(const GeometryPath& path);
+
+    /// The error of the fit of a polynomial path to an existing path,
+    /// evaluated at the samples used for the fit.
+    struct FittingError {
+        int numSamples = 0;
+        /// Root-mean-square error in the length.
+        double lengthRMS = SimTK::NaN;
+        /// Maximum absolute error in the length.
+        double lengthMax = SimTK::NaN;
+        /// Root-mean-square error in the moment arms, across all spanned
+        /// coordinates.
+        double momentArmRMS = SimTK::NaN;
+        /// Maximum absolute error in the moment arms.
+        double momentArmMax = SimTK::NaN;
+    };
+
+    /// Fit a polynomial path to the provided path, which must be part of the
+    /// provided model. The coordinates spanned by the path are those about
+    /// which the path has a nonzero moment arm at the minimum, middle, or
+    /// maximum of the coordinate's range; locked coordinates are not
+    /// considered. The length and moment arms of the path are sampled on a
+    /// grid with numSamplesPerCoordinate samples across the range of each
+    /// spanned coordinate, and the coefficients of a polynomial of the given
+    /// order are fit to the lengths and moment arms, in a least-squares
+    /// sense. Other coordinates take their values from the provided state.
+    /// The state is realized to Stage::Position within this function.
+    /// @throws Exception if the path spans more than 4 coordinates or spans
+    /// a dependent coordinate.
+    static PolynomialGeometryPath fit(const Model& model,
+            const SimTK::State& state, const GeometryPath& path, int order,
+            int numSamplesPerCoordinate, FittingError& error);
+
+    /// Replace the GeometryPath of every Muscle in the model with a
+    /// PolynomialGeometryPath created with fit(). The fitting error for each
+    /// muscle is logged. The paths of muscles that cannot be fit (see fit())
+    /// are not replaced, and a warning is logged.
+    static void replacePaths(
+            Model& model, int order, int numSamplesPerCoordinate);
+
+    /// The partial derivatives of the length of the path with respect to the
+    /// values of the coordinates in coordinate_paths. The state must be
+    /// realized to Stage::Position.
+    const SimTK::Vector& getLengthGradient(const SimTK::State& s) const;
+
+    double computeMomentArm(const SimTK::State& s,
+            const Coordinate& coord) const override;
+    void addInEquivalentForces(const SimTK::State& state,
+            const double& tension,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const override;
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendRealizePosition(const SimTK::State& s) const override;
+    void extendRealizeVelocity(const SimTK::State& s) const override;
+
+private:
+    void constructProperties();
+    void computeLengthAndGradient(const SimTK::State& s) const;
+
+    // Created from length_function in extendFinalizeFromProperties().
+    std::shared_ptr<const SimTKMultivariatePolynomial<double>>
+            m_lengthFunction;
+    SimTK::ResetOnCopy<std::vector<SimTK::ReferencePtr<const Coordinate>>>
+            m_coordinates;
+};
+
+} // namespace OpenSim
+
+#endif // MOCO_POLYNOMIALGEOMETRYPATH_H
@@ -92,7 +92,7 @@ casadi::Sparsity Function::get_jacobian_sparsity() const {
         }
 
         // Evaluate the function.
-        std::vector<casadi::DM> out = this->eval(in);
+        std::vector<casadi::DM> out = this->evalImpl(in);
 
         // Create output.
         y = casadi::DM::veccat(out);
@@ -100,6 +100,8 @@ casadi::Sparsity Function::get_jacobian_sparsity() const {
 
     const VectorDM x0s = getSubsetPointsForSparsityDetection();
 
+    OpenSim::SolverTimers::ScopedTimer timer(
+            m_casProblem->getTimers(), m_sparsityTimerIndex);
     return calcJacobianSparsityWithPerturbation(
             x0s, (int)this->nnz_out(), function);
 }
@@ -111,11 +113,20 @@ void Function::constructFunction(const Problem* casProblem,
     m_casProblem = casProblem;
     m_finite_difference_scheme = finiteDiffScheme;
     m_fullPointsForSparsityDetection = pointsForSparsityDetection;
+    m_timerIndex = casProblem->updTimers().addSection(name);
+    m_sparsityTimerIndex =
+            casProblem->updTimers().addSection("sparsity_detection");
     casadi::Dict opts;
     setCommonOptions(opts);
     this->construct(name, opts);
 }
 
+VectorDM Function::eval(const VectorDM& args) const {
+    OpenSim::SolverTimers::ScopedTimer timer(
+            m_casProblem->getTimers(), m_timerIndex);
+    return evalImpl(args);
+}
+
 casadi::Sparsity Function::get_sparsity_in(casadi_int i) {
     if (i == 0) {
         return casadi::Sparsity::dense(1, 1);
@@ -134,7 +145,7 @@ casadi::Sparsity Function::get_sparsity_in(casadi_int i) {
     }
 }
 
-VectorDM PathConstraint::eval(const VectorDM& args) const {
+VectorDM PathConstraint::evalImpl(const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(sparsity_out(0))};
@@ -142,7 +153,7 @@ VectorDM PathConstraint::eval(const VectorDM& args) const {
     return out;
 }
 
-VectorDM CostIntegrand::eval(const VectorDM& args) const {
+VectorDM CostIntegrand::evalImpl(const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(casadi::Sparsity::scalar())};
@@ -150,7 +161,8 @@ VectorDM CostIntegrand::eval(const VectorDM& args) const {
     return out;
 }
 
-VectorDM EndpointConstraintIntegrand::eval(const VectorDM& args) const {
+VectorDM EndpointConstraintIntegrand::evalImpl(
+        const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
                                    args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(casadi::Sparsity::scalar())};
@@ -188,7 +200,7 @@ casadi::Sparsity Endpoint::get_sparsity_in(casadi_int i) {
         return casadi::Sparsity(0, 0);
     }
 }
-VectorDM Cost::eval(const VectorDM& args) const {
+VectorDM Cost::evalImpl(const VectorDM& args) const {
     Problem::CostInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5).scalar(), args.at(6), args.at(7),
             args.at(8), args.at(9), args.at(10), args.at(11).scalar()};
@@ -196,7 +208,7 @@ VectorDM Cost::eval(const VectorDM& args) const {
     m_casProblem->calcCost(m_index, input, out.at(0));
     return out;
 }
-VectorDM EndpointConstraint::eval(const VectorDM& args) const {
+VectorDM EndpointConstraint::evalImpl(const VectorDM& args) const {
     Problem::CostInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5).scalar(), args.at(6), args.at(7),
             args.at(8), args.at(9), args.at(10), args.at(11).scalar()};
@@ -230,7 +242,7 @@ casadi::Sparsity MultibodySystemExplicit<CalcKCErrors>::get_sparsity_out(
 }
 
 template <bool CalcKCErrors>
-VectorDM MultibodySystemExplicit<CalcKCErrors>::eval(
+VectorDM MultibodySystemExplicit<CalcKCErrors>::evalImpl(
         const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
@@ -283,13 +295,51 @@ casadi::DM VelocityCorrection::getSubsetPoint(
             fullPoint.at(slacks)(Slice(), itime), fullPoint.at(parameters)});
 }
 
-VectorDM VelocityCorrection::eval(const VectorDM& args) const {
+VectorDM VelocityCorrection::evalImpl(const VectorDM& args) const {
     VectorDM out{casadi::DM(sparsity_out(0))};
     m_casProblem->calcVelocityCorrection(
             args.at(0).scalar(), args.at(1), args.at(2), args.at(3), out[0]);
     return out;
 }
 
+casadi::Sparsity ShootingSegment::get_sparsity_in(casadi_int i) {
+    if (i == 0 || i == 1) {
+        return casadi::Sparsity::dense(1, 1);
+    } else if (i == 2) {
+        return casadi::Sparsity::dense(m_casProblem->getNumStates(), 1);
+    } else if (i == 3) {
+        return casadi::Sparsity::dense(m_casProblem->getNumControls(), 1);
+    } else if (i == 4) {
+        return casadi::Sparsity::dense(m_casProblem->getNumParameters(), 1);
+    } else {
+        return casadi::Sparsity(0, 0);
+    }
+}
+
+casadi::Sparsity ShootingSegment::get_sparsity_out(casadi_int i) {
+    if (i == 0) {
+        return casadi::Sparsity::dense(m_casProblem->getNumStates(), 1);
+    } else {
+        return casadi::Sparsity(0, 0);
+    }
+}
+
+casadi::DM ShootingSegment::getSubsetPoint(
+        const VariablesDM& fullPoint) const {
+    int itime = 0;
+    using casadi::Slice;
+    return casadi::DM::vertcat({fullPoint.at(initial_time),
+            fullPoint.at(final_time), fullPoint.at(states)(Slice(), itime),
+            fullPoint.at(controls)(Slice(), itime), fullPoint.at(parameters)});
+}
+
+VectorDM ShootingSegment::evalImpl(const VectorDM& args) const {
+    VectorDM out{casadi::DM(sparsity_out(0))};
+    m_casProblem->calcShootingSegment(args.at(0).scalar(), args.at(1).scalar(),
+            args.at(2), args.at(3), args.at(4), out[0]);
+    return out;
+}
+
 template <bool CalcKCErrors>
 casadi::Sparsity MultibodySystemImplicit<CalcKCErrors>::get_sparsity_out(
         casadi_int i) {
@@ -315,7 +365,7 @@ casadi::Sparsity MultibodySystemImplicit<CalcKCErrors>::get_sparsity_out(
 }
 
 template <bool CalcKCErrors>
-VectorDM MultibodySystemImplicit<CalcKCErrors>::eval(
+VectorDM MultibodySystemImplicit<CalcKCErrors>::evalImpl(
         const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
@@ -62,8 +62,12 @@ public:
         return !m_fullPointsForSparsityDetection->empty();
     }
     casadi::Sparsity get_jacobian_sparsity() const override;
+    /// Evaluate the function and record the time spent in the Problem's
+    /// timers. Derived classes implement evalImpl().
+    VectorDM eval(const VectorDM& args) const override final;
 
 protected:
+    virtual VectorDM evalImpl(const VectorDM& args) const = 0;
     const Problem* m_casProblem;
 
 private:
@@ -88,6 +92,8 @@ private:
     }
 
     std::string m_finite_difference_scheme = "central";
+    int m_timerIndex = -1;
+    int m_sparsityTimerIndex = -1;
 
     std::shared_ptr<const std::vector<VariablesDM>>
             m_fullPointsForSparsityDetection;
@@ -117,7 +123,7 @@ public:
         } else
             return casadi::Sparsity(0, 0);
     }
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 
 protected:
     int m_index = -1;
@@ -154,12 +160,12 @@ protected:
 
 class CostIntegrand : public Integrand {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 class EndpointConstraintIntegrand : public Integrand {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 /// This function takes initial states/controls, final states/controls, and an
@@ -241,13 +247,13 @@ protected:
 /// This invokes CasOC::Problem::calcCost().
 class Cost : public Endpoint {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 /// This invokes CasOC::Problem::calcEndpointConstraint().
 class EndpointConstraint : public Endpoint {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 
 };
 
@@ -267,7 +273,7 @@ public:
         }
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 /// This function should compute a velocity correction term to make feasible
@@ -293,7 +299,36 @@ public:
     }
     casadi::Sparsity get_sparsity_in(casadi_int i) override final;
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
+    casadi::DM getSubsetPoint(const VariablesDM& fullPoint) const override;
+};
+
+/// This function integrates the dynamics across a single mesh interval, from
+/// the states at the start of the interval, holding the controls constant. It
+/// is used by multiple-shooting transcription.
+class ShootingSegment : public Function {
+public:
+    casadi_int get_n_in() override final { return 5; }
+    casadi_int get_n_out() override final { return 1; }
+    std::string get_name_in(casadi_int i) override final {
+        switch (i) {
+        case 0: return "initial_time";
+        case 1: return "final_time";
+        case 2: return "initial_states";
+        case 3: return "controls";
+        case 4: return "parameters";
+        default: OPENSIM_THROW(OpenSim::Exception, "Internal error.");
+        }
+    }
+    std::string get_name_out(casadi_int i) override final {
+        switch (i) {
+        case 0: return "final_states";
+        default: OPENSIM_THROW(OpenSim::Exception, "Internal error.");
+        }
+    }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override final;
+    casadi::Sparsity get_sparsity_out(casadi_int i) override final;
+    VectorDM evalImpl(const VectorDM& args) const override;
     casadi::DM getSubsetPoint(const VariablesDM& fullPoint) const override;
 };
 
@@ -310,7 +345,7 @@ class MultibodySystemImplicit : public Function {
         }
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 } // namespace CasOC
@@ -0,0 +1,232 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: CasOCLegendreGaussRadau.cpp                                  *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "CasOCLegendreGaussRadau.h"
+
+#include <algorithm>
+#include <cmath>
+
+using casadi::DM;
+using casadi::MX;
+using casadi::Slice;
+
+namespace {
+
+/// Evaluate the Legendre polynomials P_{n-1}(x) and P_n(x) (n >= 1) and their
+/// derivatives using Bonnet's recursion formula.
+void calcLegendrePolynomials(int n, double x, double& Pnm1, double& Pn,
+        double& dPnm1, double& dPn) {
+    Pnm1 = 1;
+    Pn = x;
+    dPnm1 = 0;
+    dPn = 1;
+    for (int k = 2; k <= n; ++k) {
+        const double Pk = ((2 * k - 1) * x * Pn - (k - 1) * Pnm1) / k;
+        const double dPk = k * Pn + x * dPn;
+        Pnm1 = Pn;
+        Pn = Pk;
+        dPnm1 = dPn;
+        dPn = dPk;
+    }
+}
+
+/// Compute the d flipped Legendre-Gauss-Radau points on (0, 1] and their
+/// quadrature weights. The LGR points on [-1, 1) are -1 and the roots of
+/// P_{d-1}(x) + P_d(x), which we find with Newton's method. The flipped points
+/// are mapped to (0, 1] via tau = (1 - x) / 2 so that the last collocation
+/// point is the end of the mesh interval.
+void calcFlippedLGRPoints(int degree, std::vector<double>& points,
+        std::vector<double>& weights) {
+    const int d = degree;
+    double Pdm1, Pd, dPdm1, dPd;
+    std::vector<double> x(d);
+    x[0] = -1;
+    for (int k = 1; k < d; ++k) {
+        // Initial guess from the Chebyshev-Gauss-Radau points.
+        double xk = -std::cos(2.0 * SimTK::Pi * k / (2 * d - 1));
+        for (int iter = 0; iter < 100; ++iter) {
+            calcLegendrePolynomials(d, xk, Pdm1, Pd, dPdm1, dPd);
+            const double delta = (Pdm1 + Pd) / (dPdm1 + dPd);
+            xk -= delta;
+            if (std::abs(delta) < 1e-15) break;
+        }
+        x[k] = xk;
+    }
+
+    points.resize(d);
+    weights.resize(d);
+    for (int k = 0; k < d; ++k) {
+        calcLegendrePolynomials(d, x[k], Pdm1, Pd, dPdm1, dPd);
+        points[k] = 0.5 * (1 - x[k]);
+        // The weights on [-1, 1] are (1 - x) / (d^2 P_{d-1}(x)^2); we halve
+        // them for the interval [0, 1].
+        weights[k] = 0.5 * (1 - x[k]) / (d * d * Pdm1 * Pdm1);
+    }
+
+    // The roots x are in increasing order, so the flipped points are in
+    // decreasing order.
+    std::reverse(points.begin(), points.end());
+    std::reverse(weights.begin(), weights.end());
+    // Avoid roundoff so that the last collocation point coincides with the
+    // end of the mesh interval.
+    points.back() = 1.0;
+}
+
+/// Compute the matrix that maps the values of a polynomial at the nodes
+/// {0, points} to the derivatives of the polynomial at the nodes `points`,
+/// using the barycentric form of Lagrange interpolation.
+DM calcDifferentiationMatrix(const std::vector<double>& points) {
+    const int d = (int)points.size();
+    std::vector<double> nodes(d + 1);
+    nodes[0] = 0;
+    std::copy(points.begin(), points.end(), nodes.begin() + 1);
+
+    std::vector<double> barycentric(d + 1, 1.0);
+    for (int k = 0; k <= d; ++k) {
+        for (int j = 0; j <= d; ++j) {
+            if (j != k) barycentric[k] /= (nodes[k] - nodes[j]);
+        }
+    }
+
+    DM D = DM::zeros(d, d + 1);
+    for (int j = 1; j <= d; ++j) {
+        double diagonal = 0;
+        for (int k = 0; k <= d; ++k) {
+            if (k == j) continue;
+            const double value = barycentric[k] / barycentric[j] /
+                                 (nodes[j] - nodes[k]);
+            D(j - 1, k) = value;
+            diagonal -= value;
+        }
+        D(j - 1, j) = diagonal;
+    }
+    return D;
+}
+
+/// Compute the values of the Lagrange basis polynomials for the nodes
+/// `points` at 0.
+std::vector<double> calcLagrangeBasisAtZero(const std::vector<double>& points) {
+    const int d = (int)points.size();
+    std::vector<double> values(d, 1.0);
+    for (int k = 0; k < d; ++k) {
+        for (int j = 0; j < d; ++j) {
+            if (j != k) values[k] *= (0 - points[j]) / (points[k] - points[j]);
+        }
+    }
+    return values;
+}
+
+} // anonymous namespace
+
+namespace CasOC {
+
+LegendreGaussRadau::LegendreGaussRadau(
+        const Solver& solver, const Problem& problem)
+        : Transcription(solver, problem),
+          m_degree(solver.getPseudospectralDegree()) {
+
+    OPENSIM_THROW_IF(m_degree < 1, OpenSim::Exception,
+            "Expected the pseudospectral degree to be at least 1, but got {}.",
+            m_degree);
+    OPENSIM_THROW_IF(problem.getEnforceConstraintDerivatives(),
+            OpenSim::Exception,
+            "Enforcing kinematic constraint derivatives "
+            "not supported with Legendre-Gauss-Radau transcription.");
+
+    calcFlippedLGRPoints(m_degree, m_points, m_quadratureWeights);
+    m_differentiationMatrix = calcDifferentiationMatrix(m_points);
+    m_initialControlCoefficients = calcLagrangeBasisAtZero(m_points);
+
+    const auto& mesh = m_solver.getMesh();
+    const int numMeshIntervals = (int)mesh.size() - 1;
+    casadi::DM grid = casadi::DM::zeros(1, m_degree * numMeshIntervals + 1);
+    grid(0) = mesh[0];
+    for (int imesh = 0; imesh < numMeshIntervals; ++imesh) {
+        const double h = mesh[imesh + 1] - mesh[imesh];
+        for (int j = 0; j < m_degree - 1; ++j) {
+            grid(m_degree * imesh + j + 1) = mesh[imesh] + m_points[j] * h;
+        }
+        grid(m_degree * (imesh + 1)) = mesh[imesh + 1];
+    }
+    // Constrain the control at the initial time; see
+    // calcInterpolatingControlsImpl().
+    casadi::DM pointsForInterpControls = casadi::DM::zeros(1, 1);
+    pointsForInterpControls(0) = mesh[0];
+    createVariablesAndSetBounds(grid, m_degree * m_problem.getNumStates(),
+            pointsForInterpControls);
+}
+
+DM LegendreGaussRadau::createQuadratureCoefficientsImpl() const {
+
+    // The duration of each mesh interval.
+    const DM mesh(m_solver.getMesh());
+    const DM meshIntervals = mesh(Slice(1, m_numMeshPoints)) -
+                             mesh(Slice(0, m_numMeshPoints - 1));
+    // The start point of each mesh interval is not an LGR point, so the
+    // integrand at the first grid point has no weight.
+    DM quadCoeffs(m_numGridPoints, 1);
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        for (int j = 0; j < m_degree; ++j) {
+            quadCoeffs(m_degree * imesh + j + 1) +=
+                    m_quadratureWeights[j] * meshIntervals(imesh);
+        }
+    }
+    return quadCoeffs;
+}
+
+DM LegendreGaussRadau::createMeshIndicesImpl() const {
+    DM indices = DM::zeros(1, m_numGridPoints);
+    for (int i = 0; i < m_numGridPoints; i += m_degree) { indices(i) = 1; }
+    return indices;
+}
+
+void LegendreGaussRadau::calcDefectsImpl(const casadi::MX& x,
+        const casadi::MX& xdot, casadi::MX& defects) const {
+    // For more information, see doxygen documentation for the class.
+
+    const int NS = m_problem.getNumStates();
+    const MX D = m_differentiationMatrix;
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        const int igrid = m_degree * imesh;
+        const auto h = m_times(igrid + m_degree) - m_times(igrid);
+        const auto x_i = x(Slice(), Slice(igrid, igrid + m_degree + 1));
+        const auto xdot_i =
+                xdot(Slice(), Slice(igrid + 1, igrid + m_degree + 1));
+
+        // The columns of this matrix are the defects at each collocation
+        // point; we stack the columns so that all defects for a collocation
+        // point are grouped together.
+        defects(Slice(), imesh) = MX::reshape(
+                MX::mtimes(x_i, D.T()) - h * xdot_i, NS * m_degree, 1);
+    }
+}
+
+void LegendreGaussRadau::calcInterpolatingControlsImpl(
+        const casadi::MX& controls, casadi::MX& interpControls) const {
+    if (m_problem.getNumControls()) {
+        // The initial control must lie on the polynomial through the controls
+        // at the collocation points of the first mesh interval.
+        MX extrapolated = MX::zeros(m_problem.getNumControls(), 1);
+        for (int j = 0; j < m_degree; ++j) {
+            extrapolated += m_initialControlCoefficients[j] *
+                            controls(Slice(), j + 1);
+        }
+        interpControls(Slice(), 0) = controls(Slice(), 0) - extrapolated;
+    }
+}
+
+} // namespace CasOC
@@ -0,0 +1,88 @@
+#ifndef MOCO_CASOCLEGENDREGAUSSRADAU_H
+#define MOCO_CASOCLEGENDREGAUSSRADAU_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: CasOCLegendreGaussRadau.h                                    *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CasOCTranscription.h"
+
+namespace CasOC {
+
+/// Enforce the differential equations in the problem using a
+/// Legendre-Gauss-Radau (LGR) pseudospectral approximation. Within each mesh
+/// interval, the states are approximated by a Lagrange polynomial of degree d
+/// (Solver::getPseudospectralDegree()) and the integral in the objective
+/// function is approximated by Gauss-Radau quadrature. This scheme is of
+/// order 2d - 1; with few mesh intervals, it can achieve the same accuracy as
+/// trapezoidal or Hermite-Simpson transcription with many mesh intervals.
+///
+/// Grid points.
+/// ------------
+/// Each mesh interval contains d collocation points: the d flipped LGR points
+/// mapped onto the interval. The last collocation point in each interval is
+/// the interval's end mesh point. The start mesh point of the first interval
+/// is not a collocation point.
+///
+/// Defect constraints.
+/// -------------------
+/// For each state variable, there are d defect constraints per mesh interval,
+/// one per collocation point. The derivative of the interpolating polynomial
+/// through the start mesh point and the d collocation points must equal the
+/// state derivative at each collocation point. The derivatives of the
+/// polynomial are computed using a differentiation matrix.
+///
+/// Kinematic constraints and path constraints.
+/// -------------------------------------------
+/// Path constraint errors are enforced only at the mesh points. Kinematic
+/// constraints are not supported.
+///
+/// Controls.
+/// ---------
+/// Controls are variables at every grid point. The control at the initial
+/// time affects neither the defects nor the quadrature, so we constrain it to
+/// equal the value at the initial time of the Lagrange polynomial through the
+/// controls at the d collocation points of the first mesh interval.
+class LegendreGaussRadau : public Transcription {
+public:
+    LegendreGaussRadau(const Solver& solver, const Problem& problem);
+
+private:
+    casadi::DM createQuadratureCoefficientsImpl() const override;
+    casadi::DM createMeshIndicesImpl() const override;
+    void calcDefectsImpl(const casadi::MX& x, const casadi::MX& xdot,
+            casadi::MX& defects) const override;
+    void calcInterpolatingControlsImpl(const casadi::MX& controls,
+            casadi::MX& interpControls) const override;
+
+    int m_degree;
+    /// The flipped LGR points on (0, 1] (the last point is 1).
+    std::vector<double> m_points;
+    /// The LGR quadrature weights for m_points, scaled to the interval [0, 1].
+    std::vector<double> m_quadratureWeights;
+    /// Row j contains the coefficients that give the derivative (with respect
+    /// to normalized time on [0, 1]) of the interpolating polynomial at
+    /// collocation point j from the polynomial's values at the start of the
+    /// mesh interval and at the d collocation points. Dimensions: d x (d + 1).
+    casadi::DM m_differentiationMatrix;
+    /// The values of the Lagrange basis polynomials for the nodes m_points at
+    /// the start of the mesh interval. Used to extrapolate the initial control.
+    std::vector<double> m_initialControlCoefficients;
+};
+
+} // namespace CasOC
+
+#endif // MOCO_CASOCLEGENDREGAUSSRADAU_H
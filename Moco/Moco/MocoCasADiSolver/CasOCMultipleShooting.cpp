@@ -0,0 +1,94 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: CasOCMultipleShooting.cpp                                    *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "CasOCMultipleShooting.h"
+
+using casadi::DM;
+using casadi::MX;
+using casadi::MXVector;
+using casadi::Slice;
+
+namespace CasOC {
+
+MultipleShooting::MultipleShooting(const Solver& solver, const Problem& problem)
+        : Transcription(solver, problem) {
+
+    OPENSIM_THROW_IF(problem.getNumKinematicConstraintEquations(),
+            OpenSim::Exception,
+            "Kinematic constraints not supported with "
+            "multiple-shooting transcription.");
+    OPENSIM_THROW_IF(problem.isDynamicsModeImplicit() ||
+                             problem.getNumAuxiliaryResidualEquations(),
+            OpenSim::Exception,
+            "Implicit dynamics not supported with "
+            "multiple-shooting transcription.");
+    OPENSIM_THROW_IF(problem.isPrescribedKinematics(), OpenSim::Exception,
+            "Prescribed kinematics not supported with "
+            "multiple-shooting transcription.");
+    // The shooting segments are integrated by the Problem, which CasADi
+    // cannot code-generate.
+    OPENSIM_THROW_IF(solver.getJitTranscription(), OpenSim::Exception,
+            "Just-in-time compilation of the transcription is not supported "
+            "with multiple-shooting transcription.");
+
+    // The segments span entire mesh intervals, so their derivatives are
+    // dense; sparsity detection is not necessary.
+    m_shootingSegmentFunc = OpenSim::make_unique<ShootingSegment>();
+    m_shootingSegmentFunc->constructFunction(&m_problem, "shooting_segment",
+            m_solver.getFiniteDifferenceScheme(),
+            std::make_shared<const std::vector<VariablesDM>>());
+
+    createVariablesAndSetBounds(
+            m_solver.getMesh(), m_problem.getNumStates());
+}
+
+DM MultipleShooting::createQuadratureCoefficientsImpl() const {
+    // Grid points and mesh points are synonymous; use the trapezoidal rule.
+    const int numMeshPoints = m_numGridPoints;
+    const DM meshIntervals = m_grid(Slice(1, numMeshPoints)) -
+                             m_grid(Slice(0, numMeshPoints - 1));
+    DM quadCoeffs(numMeshPoints, 1);
+    quadCoeffs(Slice(0, numMeshPoints - 1)) = 0.5 * meshIntervals;
+    quadCoeffs(Slice(1, numMeshPoints)) += 0.5 * meshIntervals;
+    return quadCoeffs;
+}
+
+DM MultipleShooting::createMeshIndicesImpl() const {
+    return DM::ones(1, m_numGridPoints);
+}
+
+void MultipleShooting::calcDefectsImpl(const casadi::MX& x,
+        const casadi::MX& /*xdot*/, casadi::MX& defects) const {
+    // For more information, see doxygen documentation for the class.
+
+    const int N = m_numMeshIntervals;
+    const auto parallelism = m_solver.getParallelism();
+    const auto segments = m_shootingSegmentFunc->map(
+            N, parallelism.first, parallelism.second);
+
+    const Slice starts(0, N);
+    const Slice ends(1, N + 1);
+    MXVector out;
+    segments.call(MXVector{m_times(Slice(), starts), m_times(Slice(), ends),
+                          x(Slice(), starts),
+                          getVariable(controls)(Slice(), starts),
+                          getVariable(parameters)},
+            out);
+    defects = x(Slice(), ends) - out.at(0);
+}
+
+} // namespace CasOC
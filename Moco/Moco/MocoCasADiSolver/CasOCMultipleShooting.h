@@ -0,0 +1,59 @@
+#ifndef MOCO_CASOCMULTIPLESHOOTING_H
+#define MOCO_CASOCMULTIPLESHOOTING_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: CasOCMultipleShooting.h                                      *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CasOCTranscription.h"
+
+namespace CasOC {
+
+/// Enforce the differential equations in the problem using multiple shooting.
+/// Each mesh interval is a shooting segment: the problem integrates the
+/// dynamics across the segment (Problem::calcShootingSegment()) from the
+/// states at the start of the interval, holding the controls at their values
+/// at the start of the interval. The NLP variables are the states and
+/// controls at the mesh points only.
+///
+/// The segments are evaluated with the parallelism set in the Solver, so the
+/// segments are integrated concurrently. The integral in the objective
+/// function is approximated by trapezoidal quadrature over the mesh points.
+///
+/// Defect constraints.
+/// -------------------
+/// For each state variable, there is one defect constraint per mesh interval:
+/// the difference between the state at the end of the interval and the
+/// integrated state.
+///
+/// This scheme supports only explicit dynamics without kinematic constraints,
+/// implicit auxiliary dynamics, or prescribed kinematics.
+class MultipleShooting : public Transcription {
+public:
+    MultipleShooting(const Solver& solver, const Problem& problem);
+
+private:
+    casadi::DM createQuadratureCoefficientsImpl() const override;
+    casadi::DM createMeshIndicesImpl() const override;
+    void calcDefectsImpl(const casadi::MX& x, const casadi::MX& xdot,
+            casadi::MX& defects) const override;
+
+    std::unique_ptr<ShootingSegment> m_shootingSegmentFunc;
+};
+
+} // namespace CasOC
+
+#endif // MOCO_CASOCMULTIPLESHOOTING_H
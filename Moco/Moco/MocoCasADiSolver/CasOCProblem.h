@@ -94,9 +94,15 @@ struct EndpointInfo {
 
 struct CostInfo : EndpointInfo {
     CostInfo(std::string name, int num_outputs,
-            std::unique_ptr<Integrand> ifunc, std::unique_ptr<Endpoint> efunc)
+            std::unique_ptr<Integrand> ifunc, std::unique_ptr<Endpoint> efunc,
+            double weight)
             : EndpointInfo(std::move(name), num_outputs, std::move(ifunc),
-                      std::move(efunc)) {}
+                      std::move(efunc)),
+              weight(weight) {}
+    /// The transcription multiplies the cost by this weight. The weight is a
+    /// parameter of the NLP (rather than part of the cost function) so that it
+    /// can change without re-transcribing the problem.
+    double weight;
 };
 
 struct EndpointConstraintInfo : EndpointInfo {
@@ -244,8 +250,10 @@ protected:
     void addParameter(std::string name, Bounds bounds) {
         m_paramInfos.push_back({std::move(name), std::move(bounds)});
     }
-    /// Add a cost term to the problem.
-    void addCost(std::string name, int numIntegrals, int numOutputs) {
+    /// Add a cost term to the problem. The value computed by calcCost() is
+    /// multiplied by the weight.
+    void addCost(std::string name, int numIntegrals, int numOutputs,
+            double weight = 1) {
         OPENSIM_THROW_IF(numIntegrals < 0 || numIntegrals > 1,
                 OpenSim::Exception, "numIntegrals must be 0 or 1.");
         std::unique_ptr<CostIntegrand> integrand_function;
@@ -254,7 +262,7 @@ protected:
         }
         m_costInfos.emplace_back(std::move(name), numOutputs,
                 std::move(integrand_function),
-                OpenSim::make_unique<Cost>());
+                OpenSim::make_unique<Cost>(), weight);
     }
     /// Add an endpoint constraint to the problem.
     void addEndpointConstraint(
@@ -302,6 +310,35 @@ protected:
         m_numAuxiliaryResiduals = (int)names.size();
     }
 
+    // Interface for modifying the problem between solves. These functions
+    // change bounds and cost weights without changing the structure of the
+    // problem. Use them before Solver::resolve() to solve the problem again
+    // without re-transcribing it.
+    void setStateBounds(int index, Bounds bounds, Bounds initialBounds,
+            Bounds finalBounds) {
+        clipEndpointBounds(bounds, initialBounds);
+        clipEndpointBounds(bounds, finalBounds);
+        auto& info = m_stateInfos.at(index);
+        info.bounds = std::move(bounds);
+        info.initialBounds = std::move(initialBounds);
+        info.finalBounds = std::move(finalBounds);
+    }
+    void setControlBounds(int index, Bounds bounds, Bounds initialBounds,
+            Bounds finalBounds) {
+        clipEndpointBounds(bounds, initialBounds);
+        clipEndpointBounds(bounds, finalBounds);
+        auto& info = m_controlInfos.at(index);
+        info.bounds = std::move(bounds);
+        info.initialBounds = std::move(initialBounds);
+        info.finalBounds = std::move(finalBounds);
+    }
+    void setParameterBounds(int index, Bounds bounds) {
+        m_paramInfos.at(index).bounds = std::move(bounds);
+    }
+    void setCostWeight(int index, double weight) {
+        m_costInfos.at(index).weight = weight;
+    }
+
 public:
     /// Kinematic constraint errors should be ordered as so:
     /// - position-level constraints
@@ -319,6 +356,18 @@ public:
             const casadi::DM& parameters,
             casadi::DM& velocity_correction) const = 0;
 
+    /// Integrate the differential equations from initialTime to finalTime,
+    /// starting from `states` and holding the controls constant, and store
+    /// the states at finalTime in `finalStates`. Only multiple-shooting
+    /// transcription uses this function.
+    virtual void calcShootingSegment(const double& /*initialTime*/,
+            const double& /*finalTime*/, const casadi::DM& /*states*/,
+            const casadi::DM& /*controls*/, const casadi::DM& /*parameters*/,
+            casadi::DM& /*finalStates*/) const {
+        OPENSIM_THROW(OpenSim::Exception,
+                "This problem does not support multiple shooting.");
+    }
+
     virtual void calcCostIntegrand(int /*costIndex*/,
             const ContinuousInput& /*input*/, double& /*integrand*/) const {}
     virtual void calcCost(int /*costIndex*/, const CostInput& /*input*/,
@@ -338,10 +387,24 @@ public:
     void intermediateCallbackWithIterate(const CasOC::Iterate& it) const {
         intermediateCallbackWithIterateImpl(it);
     }
+    bool requestStop(
+            double objective, double infeasibility, int iteration) const {
+        return requestStopImpl(objective, infeasibility, iteration);
+    }
     /// This is invoked once for each iterate in the optimization process.
     virtual void intermediateCallbackImpl() const {}
+    /// This is invoked once for each iterate with the current value of the
+    /// objective, the largest constraint violation of the iterate, and the
+    /// number of iterations so far in the current optimization. Return true
+    /// to stop the optimization (unsuccessfully).
+    virtual bool requestStopImpl(double /*objective*/,
+            double /*infeasibility*/, int /*iteration*/) const {
+        return false;
+    }
     /// Process an intermediate iterate. The frequency with which this is
-    /// evaluated is governed by Solver::getOutputInterval().
+    /// evaluated is governed by Solver::getOutputInterval(). This is invoked
+    /// on a thread other than the optimizer's (one iterate at a time), so it
+    /// must not modify state shared with the rest of the problem.
     virtual void intermediateCallbackWithIterateImpl(
             const CasOC::Iterate&) const {}
     /// @}
@@ -598,6 +661,12 @@ public:
     }
     /// @}
 
+    /// The number of evaluations of, and time spent in, each Function and
+    /// each phase of the solve. The Functions add their sections in
+    /// initialize().
+    const OpenSim::SolverTimers& getTimers() const { return m_timers; }
+    OpenSim::SolverTimers& updTimers() const { return m_timers; }
+
 private:
     /// Clip endpoint to be as strict as b.
     void clipEndpointBounds(const Bounds& b, Bounds& endpoint) {
@@ -636,6 +705,7 @@ private:
     std::unique_ptr<MultibodySystemImplicit<false>>
             m_implicitMultibodyFuncIgnoringConstraints;
     std::unique_ptr<VelocityCorrection> m_velocityCorrectionFunc;
+    mutable OpenSim::SolverTimers m_timers;
 };
 
 } // namespace CasOC
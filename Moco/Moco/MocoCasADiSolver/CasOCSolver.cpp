@@ -17,6 +17,8 @@
 
 #include "../MocoUtilities.h"
 #include "CasOCHermiteSimpson.h"
+#include "CasOCLegendreGaussRadau.h"
+#include "CasOCMultipleShooting.h"
 #include "CasOCProblem.h"
 #include "CasOCTranscription.h"
 #include "CasOCTrapezoidal.h"
@@ -25,12 +27,20 @@ using OpenSim::Exception;
 
 namespace CasOC {
 
+Solver::~Solver() = default;
+
 std::unique_ptr<Transcription> Solver::createTranscription() const {
     std::unique_ptr<Transcription> transcription;
     if (m_transcriptionScheme == "trapezoidal") {
         transcription = OpenSim::make_unique<Trapezoidal>(*this, m_problem);
     } else if (m_transcriptionScheme == "hermite-simpson") {
         transcription = OpenSim::make_unique<HermiteSimpson>(*this, m_problem);
+    } else if (m_transcriptionScheme == "legendre-gauss-radau") {
+        transcription =
+                OpenSim::make_unique<LegendreGaussRadau>(*this, m_problem);
+    } else if (m_transcriptionScheme == "multiple-shooting") {
+        transcription =
+                OpenSim::make_unique<MultipleShooting>(*this, m_problem);
     } else {
         OPENSIM_THROW(Exception, "Unknown transcription scheme '{}'.",
                 m_transcriptionScheme);
@@ -43,9 +53,10 @@ Iterate Solver::createInitialGuessFromBounds() const {
     return transcription->createInitialGuessFromBounds();
 }
 
-Iterate Solver::createRandomIterateWithinBounds() const {
+Iterate Solver::createRandomIterateWithinBounds(
+        const SimTK::Random* randGen) const {
     auto transcription = createTranscription();
-    return transcription->createRandomIterateWithinBounds();
+    return transcription->createRandomIterateWithinBounds(randGen);
 }
 
 void Solver::setSparsityDetection(const std::string& setting) {
@@ -68,7 +79,7 @@ void Solver::setParallelism(std::string parallelism, int numThreads) {
 }
 
 Solution Solver::solve(const Iterate& guess) const {
-    auto transcription = createTranscription();
+    m_transcription = createTranscription();
     auto pointsForSparsityDetection =
             std::make_shared<std::vector<VariablesDM>>();
     if (m_sparsity_detection == "initial-guess") {
@@ -80,7 +91,7 @@ Solution Solver::solve(const Iterate& guess) const {
         randGen->setSeed(0);
         for (int i = 0; i < m_sparsity_detection_random_count; ++i) {
             pointsForSparsityDetection->push_back(
-                    transcription->createRandomIterateWithinBounds(
+                    m_transcription->createRandomIterateWithinBounds(
                                          randGen.get())
                             .variables);
         }
@@ -88,7 +99,12 @@ Solution Solver::solve(const Iterate& guess) const {
     m_problem.initialize(m_finite_difference_scheme,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
                     pointsForSparsityDetection));
-    return transcription->solve(guess);
+    return m_transcription->solve(guess);
+}
+
+Solution Solver::resolve(const Iterate& guess) const {
+    if (!m_transcription) return solve(guess);
+    return m_transcription->solve(guess);
 }
 
 } // namespace CasOC
@@ -35,6 +35,7 @@ class Transcription;
 class Solver {
 public:
     Solver(const Problem& problem) : m_problem(problem) {}
+    ~Solver();
     void setNumMeshIntervals(int numMeshIntervals) {
         for (int i = 0; i < (numMeshIntervals + 1); ++i) {
             m_mesh.push_back(i / (double)(numMeshIntervals));
@@ -49,6 +50,12 @@ public:
     const std::string& getTranscriptionScheme() const {
         return m_transcriptionScheme;
     }
+    /// The degree of the interpolating polynomial in each mesh interval for
+    /// the "legendre-gauss-radau" transcription scheme (default: 3).
+    void setPseudospectralDegree(int degree) {
+        m_pseudospectralDegree = degree;
+    }
+    int getPseudospectralDegree() const { return m_pseudospectralDegree; }
     std::string getDynamicsMode() const { return m_problem.getDynamicsMode(); }
     void setMinimizeLagrangeMultipliers(bool tf) {
         m_minimizeLagrangeMultipliers = tf;
@@ -154,6 +161,15 @@ public:
         return std::make_pair(m_parallelism, m_numThreads);
     }
 
+    /// Code-generate C code for the symbolic parts of the transcription
+    /// (defects, quadrature, and control interpolation) and compile it
+    /// just-in-time with the system's C compiler, instead of evaluating these
+    /// expressions with CasADi's virtual machine. The functions provided by
+    /// the Problem are unaffected.
+    /// @note Default is false.
+    void setJitTranscription(bool tf) { m_jitTranscription = tf; }
+    bool getJitTranscription() const { return m_jitTranscription; }
+
     void setPluginOptions(casadi::Dict opts) {
         m_pluginOptions = std::move(opts);
     }
@@ -167,9 +183,20 @@ public:
     /// The contents of this iterate depends on the transcription scheme.
     Iterate createInitialGuessFromBounds() const;
     /// The contents of this iterate depends on the transcription scheme.
-    Iterate createRandomIterateWithinBounds() const;
+    /// See Transcription::createRandomIterateWithinBounds() for the
+    /// requirements on the random number generator.
+    Iterate createRandomIterateWithinBounds(
+            const SimTK::Random* randGen = nullptr) const;
 
+    /// Transcribe the problem into a nonlinear program (NLP) and solve it. The
+    /// NLP is kept for use by resolve().
     Solution solve(const Iterate& guess) const;
+    /// Solve the NLP created by the most recent call to solve() again, without
+    /// transcribing the problem or constructing the NLP solver. Between the
+    /// two calls, you may change the variable bounds and cost weights of the
+    /// Problem, but not its structure, and you may not change the settings of
+    /// this Solver. If solve() has not been called, this calls solve().
+    Solution resolve(const Iterate& guess) const;
 
 private:
     std::unique_ptr<Transcription> createTranscription() const;
@@ -177,6 +204,7 @@ private:
     const Problem& m_problem;
     std::vector<double> m_mesh;
     std::string m_transcriptionScheme = "hermite-simpson";
+    int m_pseudospectralDegree = 3;
     bool m_minimizeLagrangeMultipliers = false;
     double m_lagrangeMultiplierWeight = 1.0;
     bool m_minimizeImplicitMultibodyAccelerations = false;
@@ -193,9 +221,12 @@ private:
     int m_sparsity_detection_random_count = 3;
     std::string m_parallelism = "serial";
     int m_numThreads = 1;
+    bool m_jitTranscription = false;
     casadi::Dict m_pluginOptions;
     casadi::Dict m_solverOptions;
     std::string m_optimSolver;
+
+    mutable std::unique_ptr<Transcription> m_transcription;
 };
 
 } // namespace CasOC
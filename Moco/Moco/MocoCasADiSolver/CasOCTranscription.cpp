@@ -27,7 +27,11 @@ namespace CasOC {
 // http://casadi.sourceforge.net/api/html/d7/df0/solvers_2callback_8py-example.html
 
 /// This class allows us to observe intermediate iterates throughout the
-/// optimization.
+/// optimization. Processing an intermediate iterate (e.g., converting it and
+/// writing it to a file) happens on a separate thread, so the optimizer only
+/// pays for copying the variables. At most maxPendingIterates iterates wait to
+/// be processed; if processing cannot keep up with the optimizer, the oldest
+/// pending iterate is dropped.
 class NlpsolCallback : public casadi::Callback {
 public:
     NlpsolCallback(const Transcription& transcription, const Problem& problem,
@@ -35,7 +39,10 @@ public:
             casadi_int outputInterval)
             : m_transcription(transcription), m_problem(problem),
               m_numVariables(numVariables), m_numConstraints(numConstraints),
-              m_callbackInterval(outputInterval) {
+              m_callbackInterval(outputInterval),
+              m_writer([this](PendingIterate& pending) {
+                  processIterate(pending);
+              }, maxPendingIterates) {
         construct("NlpsolCallback", {});
     }
     casadi_int get_n_in() override { return casadi::nlpsol_n_out(); }
@@ -58,28 +65,86 @@ public:
     }
     std::vector<DM> eval(const std::vector<DM>& args) const override {
         if (m_callbackInterval > 0 && evalCount % m_callbackInterval == 0) {
-            Iterate iterate = m_problem.createIterate<Iterate>();
-            iterate.variables = m_transcription.expandVariables(args.at(0));
-            iterate.times =
-                    m_transcription.createTimes(iterate.variables[initial_time],
-                            iterate.variables[final_time]);
-            iterate.iteration = evalCount;
-            m_problem.intermediateCallbackWithIterate(iterate);
+            // This rethrows any exception from processing an earlier
+            // iterate, which stops the optimization.
+            m_writer.push({args.at(0), evalCount});
         }
         m_problem.intermediateCallback();
         ++evalCount;
-        return {0};
+        // The optimizer stops if the return value is nonzero. The objective
+        // and the constraints are the second and third outputs of nlpsol().
+        const double objective = args.at(1).scalar();
+        const double infeasibility = calcInfeasibility(args.at(2));
+        const bool stop = m_problem.requestStop(
+                objective, infeasibility, m_solveIteration++);
+        return {stop ? 1 : 0};
+    }
+
+    /// Prepare for a new optimization whose constraints have the provided
+    /// bounds.
+    void startSolve(DM constraintsLower, DM constraintsUpper) {
+        m_constraintsLower = std::move(constraintsLower);
+        m_constraintsUpper = std::move(constraintsUpper);
+        m_solveIteration = 0;
+    }
+
+    /// Wait until all pending iterates have been processed. If processing an
+    /// iterate failed (and the exception was not already thrown from eval()),
+    /// the exception is rethrown if `rethrow` is true.
+    void flushIterates(bool rethrow = true) const {
+        const int numDropped = m_writer.flush();
+        if (numDropped) {
+            OpenSim::log_warn("Skipped {} intermediate iterate(s) because "
+                              "processing them could not keep up with the "
+                              "optimizer; consider a larger output interval.",
+                    numDropped);
+        }
+        const auto exception = m_writer.takeException();
+        if (exception && rethrow) std::rethrow_exception(exception);
     }
 
 private:
+    struct PendingIterate {
+        DM x;
+        int iteration;
+    };
+    static constexpr int maxPendingIterates = 4;
+
+    /// The largest violation of the constraint bounds.
+    double calcInfeasibility(const DM& g) const {
+        if (g.is_empty()) return 0;
+        const DM violation = DM::fmax(
+                m_constraintsLower - g, g - m_constraintsUpper);
+        return std::max(0.0, double(DM::mmax(violation)));
+    }
+
+    void processIterate(const PendingIterate& pending) const {
+        Iterate iterate = m_problem.createIterate<Iterate>();
+        iterate.variables = m_transcription.expandVariables(pending.x);
+        iterate.times = m_transcription.createTimes(
+                iterate.variables[initial_time], iterate.variables[final_time]);
+        iterate.iteration = pending.iteration;
+        m_problem.intermediateCallbackWithIterate(iterate);
+    }
+
     const Transcription& m_transcription;
     const Problem& m_problem;
     casadi_int m_numVariables;
     casadi_int m_numConstraints;
     casadi_int m_callbackInterval;
     mutable int evalCount = 0;
+    mutable int m_solveIteration = 0;
+    DM m_constraintsLower;
+    DM m_constraintsUpper;
+
+    // Processes iterates on a separate thread. This is the last member so
+    // that pending iterates are processed before the other members are
+    // destroyed.
+    mutable OpenSim::BackgroundProcessor<PendingIterate> m_writer;
 };
 
+Transcription::~Transcription() = default;
+
 void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
         int numDefectsPerMeshInterval,
         const casadi::DM& pointsForInterpControls) {
@@ -140,11 +205,6 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
             "slacks", m_problem.getNumSlacks(), m_numMeshInteriorPoints);
     m_vars[parameters] = MX::sym("parameters", m_problem.getNumParameters(), 1);
 
-    m_paramsTrajGrid = MX::repmat(m_vars[parameters], 1, m_numGridPoints);
-    m_paramsTrajMesh = MX::repmat(m_vars[parameters], 1, m_numMeshPoints);
-    m_paramsTrajMeshInterior =
-            MX::repmat(m_vars[parameters], 1, m_numMeshInteriorPoints);
-
     m_meshIndicesMap = createMeshIndices();
     std::vector<int> meshIndicesVector;
     std::vector<int> meshInteriorIndicesVector;
@@ -170,8 +230,10 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
     m_meshInteriorIndices =
             makeTimeIndices(meshInteriorIndicesVector);
 
-    // Set variable bounds.
-    // --------------------
+    setVariableBoundsFromProblem();
+}
+
+void Transcription::setVariableBoundsFromProblem() {
     auto initializeBounds = [&](VariablesDM& bounds) {
         for (auto& kv : m_vars) {
             bounds[kv.first] = DM(kv.second.rows(), kv.second.columns());
@@ -446,7 +508,14 @@ void Transcription::transcribe() {
 }
 
 void Transcription::setObjectiveAndEndpointConstraints() {
-    DM quadCoeffs = this->createQuadratureCoefficients();
+    m_quadratureCoefficients = this->createQuadratureCoefficients();
+    if (m_solver.getJitTranscription()) {
+        const MX integrandTraj = MX::sym("integrand", 1, m_numGridPoints);
+        m_quadratureFunc = casadi::Function("quadrature",
+                {m_vars[initial_time], m_vars[final_time], integrandTraj},
+                {m_duration * dot(m_quadratureCoefficients.T(), integrandTraj)},
+                createJitOptions());
+    }
 
     // Objective.
     // ----------
@@ -474,6 +543,10 @@ void Transcription::setObjectiveAndEndpointConstraints() {
         m_objectiveTermNames.push_back("auxiliary_derivatives");
     }
     m_objectiveTerms = MX::zeros((int)m_objectiveTermNames.size(), 1);
+    // The weights on the objective terms are parameters of the NLP so that
+    // they can change without re-transcribing the problem.
+    m_objectiveWeights =
+            MX::sym("objective_weights", (int)m_objectiveTermNames.size(), 1);
 
     int iterm = 0;
     for (int ic = 0; ic < m_problem.getNumCosts(); ++ic) {
@@ -490,7 +563,7 @@ void Transcription::setObjectiveAndEndpointConstraints() {
                     {states, controls, multipliers, derivatives}, m_gridIndices)
                     .at(0);
 
-            integral = m_duration * dot(quadCoeffs.T(), integrandTraj);
+            integral = calcIntegral(integrandTraj);
         } else {
             integral = MX::nan(1, 1);
         }
@@ -513,22 +586,17 @@ void Transcription::setObjectiveAndEndpointConstraints() {
     // Minimize Lagrange multipliers if specified by the solver.
     if (minimizeLagrangeMultipliers) {
         const auto mults = m_vars[multipliers];
-        const double multiplierWeight = m_solver.getLagrangeMultiplierWeight();
         // Sum across constraints of each multiplier element squared.
         MX integrandTraj = MX::sum1(MX::sq(mults));
-        m_objectiveTerms(iterm++) = multiplierWeight * m_duration *
-                       dot(quadCoeffs.T(), integrandTraj);
+        m_objectiveTerms(iterm++) = calcIntegral(integrandTraj);
     }
 
     // Minimize generalized accelerations.
     if (minimizeAccelerations) {
         const auto& numAccels = m_problem.getNumAccelerations();
         const auto accels = m_vars[derivatives](Slice(0, numAccels), Slice());
-        const double accelWeight =
-                m_solver.getImplicitMultibodyAccelerationsWeight();
         MX integrandTraj = MX::sum1(MX::sq(accels));
-        m_objectiveTerms(iterm++) = accelWeight * m_duration *
-                       dot(quadCoeffs.T(), integrandTraj);
+        m_objectiveTerms(iterm++) = calcIntegral(integrandTraj);
     }
 
     // Minimize auxiliary derivatives.
@@ -537,11 +605,8 @@ void Transcription::setObjectiveAndEndpointConstraints() {
         const auto& numAuxDerivs = m_problem.getNumAuxiliaryResidualEquations();
         const auto auxDerivs = m_vars[derivatives](
                 Slice(numAccels, numAccels + numAuxDerivs), Slice());
-        const double auxDerivWeight =
-                m_solver.getImplicitAuxiliaryDerivativesWeight();
         MX integrandTraj = MX::sum1(MX::sq(auxDerivs));
-        m_objectiveTerms(iterm++) = auxDerivWeight * m_duration *
-                       dot(quadCoeffs.T(), integrandTraj);
+        m_objectiveTerms(iterm++) = calcIntegral(integrandTraj);
     }
 
 
@@ -561,7 +626,7 @@ void Transcription::setObjectiveAndEndpointConstraints() {
                     {states, controls, multipliers, derivatives}, m_gridIndices)
                                        .at(0);
 
-            integral = m_duration * dot(quadCoeffs.T(), integrandTraj);
+            integral = calcIntegral(integrandTraj);
         } else {
             integral = MX::nan(1, 1);
         }
@@ -584,11 +649,80 @@ void Transcription::setObjectiveAndEndpointConstraints() {
     }
 }
 
+void Transcription::calcDefects() {
+    if (!m_solver.getJitTranscription()) {
+        calcDefectsImpl(m_vars[states], m_xdot, m_constraints.defects);
+        return;
+    }
+    // The defects are a function of time and the states and their
+    // derivatives. The state derivatives are computed by Problem functions
+    // that cannot be compiled, so the compiled function takes the state
+    // derivatives as an input.
+    const MX xdot = MX::sym("xdot", m_xdot.rows(), m_xdot.columns());
+    MX defects = MX(m_constraints.defects.sparsity());
+    calcDefectsImpl(m_vars[states], xdot, defects);
+    casadi::Function defectsFunc("defects",
+            {m_vars[initial_time], m_vars[final_time], m_vars[states], xdot},
+            {defects}, createJitOptions());
+    m_constraints.defects =
+            defectsFunc(MXVector{m_vars[initial_time], m_vars[final_time],
+                                m_vars[states], densify(m_xdot)})
+                    .at(0);
+}
+
+void Transcription::calcInterpolatingControls() {
+    if (!m_solver.getJitTranscription() ||
+            m_constraints.interp_controls.is_empty()) {
+        calcInterpolatingControlsImpl(
+                m_vars[controls], m_constraints.interp_controls);
+        return;
+    }
+    MX interpControls = MX(m_constraints.interp_controls.sparsity());
+    calcInterpolatingControlsImpl(m_vars[controls], interpControls);
+    casadi::Function interpControlsFunc("interp_controls", {m_vars[controls]},
+            {interpControls}, createJitOptions());
+    m_constraints.interp_controls =
+            interpControlsFunc(MXVector{m_vars[controls]}).at(0);
+}
+
+casadi::MX Transcription::calcIntegral(const casadi::MX& integrandTraj) const {
+    if (m_quadratureFunc.is_null()) {
+        return m_duration * dot(m_quadratureCoefficients.T(), integrandTraj);
+    }
+    return m_quadratureFunc(MXVector{m_vars.at(initial_time),
+                                    m_vars.at(final_time), integrandTraj})
+            .at(0);
+}
+
+casadi::Dict Transcription::createJitOptions() const {
+    // The "shell" compiler invokes the system's C compiler and loads the
+    // resulting shared library into this process.
+    casadi::Dict options;
+    options["jit"] = true;
+    options["compiler"] = "shell";
+    options["jit_options"] =
+            casadi::Dict{{"flags", std::vector<std::string>{"-O3"}}};
+    // Also compile the derivatives of these functions.
+    casadi::Dict derivativeOptions = options;
+    options["der_options"] = derivativeOptions;
+    return options;
+}
+
 Solution Transcription::solve(const Iterate& guessOrig) {
 
     // Define the NLP.
     // ---------------
-    transcribe();
+    // The NLP is constructed only once. When solving again, only the variable
+    // bounds and the objective weights (which are NLP parameters) may differ.
+    auto& timers = m_problem.updTimers();
+    if (m_nlpFunc.is_null()) {
+        OpenSim::SolverTimers::ScopedTimer timer(
+                timers, timers.addSection("nlp_setup"));
+        transcribe();
+        createNlpFunction();
+    } else {
+        setVariableBoundsFromProblem();
+    }
 
     // Resample the guess.
     // -------------------
@@ -627,8 +761,89 @@ Solution Transcription::solve(const Iterate& guessOrig) {
                 m_numMeshInteriorPoints, slacks.size2());
     }
 
-    // Create the CasADi NLP function.
-    // -------------------------------
+    // Run the optimization (evaluate the CasADi NLP function).
+    // --------------------------------------------------------
+    // The inputs and outputs of nlpFunc are numeric (casadi::DM).
+    const casadi::DM objectiveWeights = createObjectiveWeights();
+    const casadi::DM lbg = flattenConstraints(m_constraintsLowerBounds);
+    const casadi::DM ubg = flattenConstraints(m_constraintsUpperBounds);
+    m_callback->startSolve(lbg, ubg);
+    casadi::DMDict nlpResult;
+    try {
+        nlpResult = m_nlpFunc(
+                casadi::DMDict{{"x0", flattenVariables(guess.variables)},
+                        {"p", objectiveWeights},
+                        {"lbx", flattenVariables(m_lowerBounds)},
+                        {"ubx", flattenVariables(m_upperBounds)},
+                        {"lbg", lbg}, {"ubg", ubg}});
+    } catch (...) {
+        // Finish processing intermediate iterates while this transcription is
+        // still intact.
+        m_callback->flushIterates(false);
+        throw;
+    }
+    m_callback->flushIterates();
+
+    // Create a CasOC::Solution.
+    // -------------------------
+    Solution solution = m_problem.createIterate<Solution>();
+    const auto finalVariables = nlpResult.at("x");
+    solution.variables = expandVariables(finalVariables);
+    solution.objective = nlpResult.at("f").scalar();
+
+    casadi::DMVector finalVarsDMV{finalVariables};
+    casadi::DMVector objectiveOut;
+    m_objectiveTermsFunc.call(finalVarsDMV, objectiveOut);
+    const casadi::DM weightedObjectiveTerms =
+            objectiveWeights * objectiveOut[0];
+    solution.objective_breakdown =
+            expandObjectiveTerms(weightedObjectiveTerms);
+
+    solution.times = createTimes(
+            solution.variables[initial_time], solution.variables[final_time]);
+    solution.stats = m_nlpFunc.stats();
+    addOptimizerTimings(solution.stats);
+
+    // Print breakdown of objective.
+    printObjectiveBreakdown(solution, weightedObjectiveTerms);
+
+    if (!solution.stats.at("success")) {
+
+        // For some reason, nlpResult.at("g") is all 0. So we calculate the
+        // constraints ourselves.
+        casadi::DMVector constraintsOut;
+        m_constraintsFunc.call(finalVarsDMV, constraintsOut);
+        printConstraintValues(solution, expandConstraints(constraintsOut[0]));
+    }
+    return solution;
+}
+
+void Transcription::addOptimizerTimings(const casadi::Dict& stats) const {
+    // The optimizer reports the number of evaluations of, and the time spent
+    // in, the NLP functions that it invokes. The time spent in the optimizer
+    // itself (e.g., in the linear solver) is the remainder of the total time.
+    auto& timers = m_problem.updTimers();
+    auto getStat = [&stats](const std::string& key) {
+        const auto it = stats.find(key);
+        return it == stats.end() ? 0.0 : it->second.to_double();
+    };
+    double functionsTime = 0;
+    for (const std::string& name :
+            {"nlp_f", "nlp_grad_f", "nlp_g", "nlp_jac_g", "nlp_hess_l"}) {
+        const auto numCalls = (long long)getStat("n_call_" + name);
+        if (!numCalls) continue;
+        const double time = getStat("t_wall_" + name);
+        functionsTime += time;
+        timers.add(timers.addSection(name), SimTK::secToNs(time), numCalls);
+    }
+    const double totalTime = getStat("t_wall_total");
+    if (totalTime > 0) {
+        timers.add(timers.addSection("optimizer_other"),
+                SimTK::secToNs(std::max(0.0, totalTime - functionsTime)));
+    }
+}
+
+void Transcription::createNlpFunction() {
     // Option handling is copied from casadi::OptiNode::solver().
     casadi::Dict options = m_solver.getPluginOptions();
     if (!options.empty()) {
@@ -643,16 +858,18 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     auto g = flattenConstraints(m_constraints);
     casadi_int numConstraints = g.numel();
 
-    NlpsolCallback callback(*this, m_problem, numVariables, numConstraints,
-            m_solver.getCallbackInterval());
-    options["iteration_callback"] = callback;
+    // The callback must outlive the NLP function.
+    m_callback = OpenSim::make_unique<NlpsolCallback>(*this, m_problem,
+            numVariables, numConstraints, m_solver.getCallbackInterval());
+    options["iteration_callback"] = *m_callback;
 
     // The inputs to nlpsol() are symbolic (casadi::MX).
     casadi::MXDict nlp;
     nlp.emplace(std::make_pair("x", x));
+    nlp.emplace(std::make_pair("p", m_objectiveWeights));
     // The objective symbolic variable holds an expression graph including
     // all the calculations performed on the variables x.
-    casadi::MX objective = MX::sum1(m_objectiveTerms);
+    casadi::MX objective = MX::dot(m_objectiveWeights, m_objectiveTerms);
     if (m_objectiveTerms.numel() == 0) {
         objective = 0;
     }
@@ -675,49 +892,32 @@ Solution Transcription::solve(const Iterate& guessOrig) {
         jacobian.sparsity().to_file(
                 prefix + "constraint_Jacobian_sparsity.mtx");
     }
-    const casadi::Function nlpFunc =
-            casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
-
-    // Run the optimization (evaluate the CasADi NLP function).
-    // --------------------------------------------------------
-    // The inputs and outputs of nlpFunc are numeric (casadi::DM).
-    const casadi::DMDict nlpResult =
-            nlpFunc(casadi::DMDict{{"x0", flattenVariables(guess.variables)},
-                    {"lbx", flattenVariables(m_lowerBounds)},
-                    {"ubx", flattenVariables(m_upperBounds)},
-                    {"lbg", flattenConstraints(m_constraintsLowerBounds)},
-                    {"ubg", flattenConstraints(m_constraintsUpperBounds)}});
+    m_nlpFunc = casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
 
-    // Create a CasOC::Solution.
-    // -------------------------
-    Solution solution = m_problem.createIterate<Solution>();
-    const auto finalVariables = nlpResult.at("x");
-    solution.variables = expandVariables(finalVariables);
-    solution.objective = nlpResult.at("f").scalar();
-
-    casadi::DMVector finalVarsDMV{finalVariables};
-    casadi::Function objectiveFunc("objective", {x}, {m_objectiveTerms});
-    casadi::DMVector objectiveOut;
-    objectiveFunc.call(finalVarsDMV, objectiveOut);
-    solution.objective_breakdown = expandObjectiveTerms(objectiveOut[0]);
-
-    solution.times = createTimes(
-            solution.variables[initial_time], solution.variables[final_time]);
-    solution.stats = nlpFunc.stats();
-
-    // Print breakdown of objective.
-    printObjectiveBreakdown(solution, objectiveOut[0]);
-
-    if (!solution.stats.at("success")) {
+    m_objectiveTermsFunc =
+            casadi::Function("objective", {x}, {m_objectiveTerms});
+    m_constraintsFunc = casadi::Function("constraints", {x}, {g});
+}
 
-        // For some reason, nlpResult.at("g") is all 0. So we calculate the
-        // constraints ourselves.
-        casadi::Function constraintFunc("constraints", {x}, {g});
-        casadi::DMVector constraintsOut;
-        constraintFunc.call(finalVarsDMV, constraintsOut);
-        printConstraintValues(solution, expandConstraints(constraintsOut[0]));
+casadi::DM Transcription::createObjectiveWeights() const {
+    casadi::DM weights((int)m_objectiveTermNames.size(), 1);
+    int iterm = 0;
+    for (const auto& info : m_problem.getCostInfos()) {
+        weights(iterm++) = info.weight;
     }
-    return solution;
+    for (; iterm < (int)m_objectiveTermNames.size(); ++iterm) {
+        const auto& name = m_objectiveTermNames[iterm];
+        if (name == "multipliers") {
+            weights(iterm) = m_solver.getLagrangeMultiplierWeight();
+        } else if (name == "accelerations") {
+            weights(iterm) = m_solver.getImplicitMultibodyAccelerationsWeight();
+        } else if (name == "auxiliary_derivatives") {
+            weights(iterm) = m_solver.getImplicitAuxiliaryDerivativesWeight();
+        } else {
+            OPENSIM_THROW(OpenSim::Exception, "Internal error.");
+        }
+    }
+    return weights;
 }
 
 void Transcription::printConstraintValues(const Iterate& it,
@@ -1198,15 +1398,9 @@ casadi::MXVector Transcription::evalOnTrajectory(
             mxIn[i + 1] = m_vars.at(inputs[i])(Slice(), timeIndices);
         }
     }
-    if (&timeIndices == &m_gridIndices) {
-        mxIn[mxIn.size() - 1] = m_paramsTrajGrid;
-    } else if (&timeIndices == &m_meshIndices) {
-        mxIn[mxIn.size() - 1] = m_paramsTrajMesh;
-    } else if (&timeIndices == &m_meshInteriorIndices) {
-        mxIn[mxIn.size() - 1] = m_paramsTrajMeshInterior;
-    } else {
-        OPENSIM_THROW(OpenSim::Exception, "Internal error.");
-    }
+    // The parameters are the same at every point. We pass a single column
+    // and CasADi broadcasts it to all points of the mapped function.
+    mxIn[mxIn.size() - 1] = m_vars.at(parameters);
     MXVector mxOut;
     trajFunc.call(mxIn, mxOut);
     return mxOut;
@@ -22,6 +22,8 @@
 
 namespace CasOC {
 
+class NlpsolCallback;
+
 /// This is the base class for transcription schemes that convert a
 /// CasOC::Problem into a general nonlinear programming problem. If you are
 /// creating a new derived class, make sure to override all virtual functions
@@ -30,7 +32,7 @@ class Transcription {
 public:
     Transcription(const Solver& solver, const Problem& problem)
             : m_solver(solver), m_problem(problem) {}
-    virtual ~Transcription() = default;
+    virtual ~Transcription();
     Iterate createInitialGuessFromBounds() const;
     /// Use the provided random number generator to generate an iterate.
     /// Random::Uniform is used if a generator is not provided. The generator
@@ -60,6 +62,10 @@ public:
         return meshIndices;
     }
 
+    /// The first call transcribes the problem and constructs the NLP solver.
+    /// Subsequent calls reuse the NLP solver; only the variable bounds and
+    /// cost weights are updated from the Problem. The cost weights are
+    /// parameters of the NLP.
     Solution solve(const Iterate& guessOrig);
 
 protected:
@@ -73,6 +79,9 @@ protected:
             int numDefectsPerMeshInterval,
             const casadi::DM& pointsForInterpControls = casadi::DM());
 
+    /// The NLP variables created by createVariablesAndSetBounds().
+    const casadi::MX& getVariable(Var var) const { return m_vars.at(var); }
+
     /// We assume all functions depend on time and parameters.
     /// "inputs" is prepended by time and postpended (?) by parameters.
     casadi::MXVector evalOnTrajectory(const casadi::Function& pointFunction,
@@ -128,9 +137,6 @@ protected:
 
 private:
     VariablesMX m_vars;
-    casadi::MX m_paramsTrajGrid;
-    casadi::MX m_paramsTrajMesh;
-    casadi::MX m_paramsTrajMeshInterior;
     VariablesDM m_lowerBounds;
     VariablesDM m_upperBounds;
 
@@ -141,13 +147,22 @@ private:
 
     casadi::MX m_xdot; // State derivatives.
 
+    casadi::DM m_quadratureCoefficients;
+    casadi::Function m_quadratureFunc;
+
     casadi::MX m_objectiveTerms;
+    casadi::MX m_objectiveWeights;
     std::vector<std::string> m_objectiveTermNames;
 
     Constraints<casadi::MX> m_constraints;
     Constraints<casadi::DM> m_constraintsLowerBounds;
     Constraints<casadi::DM> m_constraintsUpperBounds;
 
+    std::unique_ptr<NlpsolCallback> m_callback;
+    casadi::Function m_nlpFunc;
+    casadi::Function m_objectiveTermsFunc;
+    casadi::Function m_constraintsFunc;
+
 private:
     /// Override this function in your derived class to compute a vector of
     /// quadrature coeffecients (of length m_numGridPoints) required to set the
@@ -168,15 +183,25 @@ private:
                 "Must provide constraints for interpolating controls.")
     }
 
+    /// Set m_lowerBounds and m_upperBounds from the bounds in the Problem.
+    void setVariableBoundsFromProblem();
     void transcribe();
     void setObjectiveAndEndpointConstraints();
-    void calcDefects() {
-        calcDefectsImpl(m_vars.at(states), m_xdot, m_constraints.defects);
-    }
-    void calcInterpolatingControls() {
-        calcInterpolatingControlsImpl(
-                m_vars.at(controls), m_constraints.interp_controls);
-    }
+    /// Create the NLP solver function from the transcribed problem.
+    void createNlpFunction();
+    /// Record the optimizer's function evaluation statistics in the
+    /// Problem's timers.
+    void addOptimizerTimings(const casadi::Dict& stats) const;
+    /// The values for the NLP parameters m_objectiveWeights.
+    casadi::DM createObjectiveWeights() const;
+    void calcDefects();
+    void calcInterpolatingControls();
+    /// Integrate the provided row vector of integrand values (one per grid
+    /// point) over the phase using the quadrature coefficients.
+    casadi::MX calcIntegral(const casadi::MX& integrandTraj) const;
+    /// Options for a casadi::Function that CasADi code-generates and compiles
+    /// just-in-time; see Solver::setJitTranscription().
+    casadi::Dict createJitOptions() const;
 
     /// Use this function to ensure you iterate through variables in the same
     /// order.
@@ -32,6 +32,12 @@ using casadi::Sparsity;
 
 using namespace OpenSim;
 
+struct MocoCasADiSolver::CachedTranscription {
+    std::string fingerprint;
+    std::unique_ptr<MocoCasOCProblem> casProblem;
+    std::unique_ptr<CasOC::Solver> casSolver;
+};
+
 MocoCasADiSolver::MocoCasADiSolver() { constructProperties(); }
 
 void MocoCasADiSolver::constructProperties() {
@@ -41,11 +47,16 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_optim_finite_difference_scheme("central");
     constructProperty_parallel();
     constructProperty_output_interval(0);
+    constructProperty_output_interval_format("sto");
 
     constructProperty_minimize_implicit_multibody_accelerations(false);
     constructProperty_implicit_multibody_accelerations_weight(1.0);
     constructProperty_minimize_implicit_auxiliary_derivatives(false);
     constructProperty_implicit_auxiliary_derivatives_weight(1.0);
+    constructProperty_jit_transcription(false);
+    constructProperty_pseudospectral_degree(3);
+    constructProperty_shooting_integrator_num_steps(10);
+    constructProperty_reuse_transcription(false);
 }
 
 MocoTrajectory MocoCasADiSolver::createGuess(const std::string& type) const {
@@ -72,6 +83,15 @@ MocoTrajectory MocoCasADiSolver::createGuess(const std::string& type) const {
     }
 }
 
+MocoTrajectory MocoCasADiSolver::createRandomGuess(int seed) const {
+    auto casProblem = createCasOCProblem();
+    auto casSolver = createCasOCSolver(*casProblem);
+    SimTK::Random::Uniform randGen(-1, 1);
+    randGen.setSeed(seed);
+    return convertToMocoTrajectory(
+            casSolver->createRandomIterateWithinBounds(&randGen));
+}
+
 void MocoCasADiSolver::setGuess(MocoTrajectory guess) {
     // Ensure the guess is compatible with this solver/problem.
     checkGuess(guess);
@@ -124,8 +144,49 @@ const MocoTrajectory& MocoCasADiSolver::getGuess() const {
     return m_guessToUse.getRef();
 }
 
-std::unique_ptr<MocoCasOCProblem> MocoCasADiSolver::createCasOCProblem() const {
+std::string MocoCasADiSolver::createTranscriptionFingerprint() const {
+    // Goal weights and the bounds on time, states, controls, and parameters
+    // are left out; changing these does not require re-transcribing.
+    // Reference data provided to goals in memory is not part of the goals'
+    // properties, so we include a hash of each goal's processed reference
+    // data.
     const auto& problemRep = getProblemRep();
+    std::unique_ptr<MocoCasADiSolver> solver(clone());
+    solver->set_guess_file("");
+    std::string fingerprint = solver->dump();
+    fingerprint += problemRep.getModelBase().dump();
+    for (const auto& name : problemRep.createCostNames()) {
+        std::unique_ptr<MocoGoal> cost(problemRep.getCost(name).clone());
+        cost->setWeight(1);
+        fingerprint += cost->dump();
+        fingerprint += std::to_string(
+                problemRep.getCost(name).calcReferenceDataHash());
+    }
+    for (const auto& name : problemRep.createEndpointConstraintNames()) {
+        const auto& constraint = problemRep.getEndpointConstraint(name);
+        fingerprint += constraint.dump();
+        fingerprint += std::to_string(constraint.calcReferenceDataHash());
+    }
+    for (const auto& name : problemRep.createPathConstraintNames()) {
+        fingerprint += problemRep.getPathConstraint(name).dump();
+    }
+    for (const auto& name : problemRep.createParameterNames()) {
+        std::unique_ptr<MocoParameter> param(
+                problemRep.getParameter(name).clone());
+        param->setBounds(MocoBounds());
+        fingerprint += param->dump();
+    }
+    for (const auto& name : problemRep.createKinematicConstraintNames()) {
+        const auto& kc = problemRep.getKinematicConstraint(name);
+        fingerprint += kc.getConstraintInfo().dump();
+        for (const auto& info : problemRep.getMultiplierInfos(name)) {
+            fingerprint += info.dump();
+        }
+    }
+    return fingerprint;
+}
+
+int MocoCasADiSolver::getNumThreads() const {
     int parallel = 1;
     int parallelEV = getMocoParallelEnvironmentVariable();
     if (getProperty_parallel().size()) {
@@ -141,6 +202,12 @@ std::unique_ptr<MocoCasOCProblem> MocoCasADiSolver::createCasOCProblem() const {
     } else {
         numThreads = parallel;
     }
+    return numThreads;
+}
+
+std::unique_ptr<MocoCasOCProblem> MocoCasADiSolver::createCasOCProblem() const {
+    const auto& problemRep = getProblemRep();
+    const int numThreads = getNumThreads();
 
     checkPropertyInSet(
             *this, getProperty_multibody_dynamics_mode(), {"explicit", "implicit"});
@@ -155,7 +222,8 @@ std::unique_ptr<MocoCasOCProblem> MocoCasADiSolver::createCasOCProblem() const {
                              model.getWorkingState()),
             Exception, "Quaternions are not supported.");
     return OpenSim::make_unique<MocoCasOCProblem>(*this, problemRep,
-            createProblemRepJar(numThreads), get_multibody_dynamics_mode());
+            createProblemRepJar(numThreads),
+            get_multibody_dynamics_mode());
 }
 
 std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
@@ -167,12 +235,18 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     Dict solverOptions;
     checkPropertyInSet(*this, getProperty_optim_solver(), {"ipopt", "snopt"});
     checkPropertyInSet(*this, getProperty_transcription_scheme(),
-            {"trapezoidal", "hermite-simpson"});
+            {"trapezoidal", "hermite-simpson", "legendre-gauss-radau",
+                    "multiple-shooting"});
     OPENSIM_THROW_IF(casProblem.getNumKinematicConstraintEquations() != 0 &&
-                             get_transcription_scheme() == "trapezoidal",
+                             get_transcription_scheme() != "hermite-simpson",
             OpenSim::Exception,
-            "Kinematic constraints not supported with "
-            "trapezoidal transcription.");
+            "Kinematic constraints not supported with {} transcription.",
+            get_transcription_scheme());
+    checkPropertyInRangeOrSet(*this, getProperty_pseudospectral_degree(), 1,
+            std::numeric_limits<int>::max(), {});
+    checkPropertyInRangeOrSet(*this,
+            getProperty_shooting_integrator_num_steps(), 1,
+            std::numeric_limits<int>::max(), {});
     // Enforcing constraint derivatives is only supported when Hermite-Simpson
     // is set as the transcription scheme.
     if (casProblem.getNumKinematicConstraintEquations() != 0) {
@@ -256,6 +330,8 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
             {"central", "forward", "backward"});
     casSolver->setFiniteDifferenceScheme(get_optim_finite_difference_scheme());
 
+    checkPropertyInSet(
+            *this, getProperty_output_interval_format(), {"sto", "traj"});
     casSolver->setCallbackInterval(get_output_interval());
 
     Dict pluginOptions;
@@ -271,6 +347,7 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
         casSolver->setMesh(mesh);
     }
     casSolver->setTranscriptionScheme(get_transcription_scheme());
+    casSolver->setPseudospectralDegree(get_pseudospectral_degree());
     casSolver->setMinimizeLagrangeMultipliers(
             get_minimize_lagrange_multipliers());
     casSolver->setLagrangeMultiplierWeight(get_lagrange_multiplier_weight());
@@ -298,6 +375,7 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     casSolver->setImplicitAuxiliaryDerivativesWeight(
             get_implicit_auxiliary_derivatives_weight());
 
+    casSolver->setJitTranscription(get_jit_transcription());
     casSolver->setOptimSolver(get_optim_solver());
     casSolver->setInterpolateControlMidpoints(
             get_interpolate_control_midpoints());
@@ -319,10 +397,37 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
         log_info(std::string(72, '-'));
         getProblemRep().printDescription();
     }
-    auto casProblem = createCasOCProblem();
-    auto casSolver = createCasOCSolver(*casProblem);
+    // Reuse the transcription from the previous solve if only goal weights or
+    // variable bounds have changed since then.
+    std::string fingerprint;
+    bool reuseTranscription = false;
+    if (get_reuse_transcription()) {
+        fingerprint = createTranscriptionFingerprint();
+        reuseTranscription = m_cachedTranscription &&
+                             m_cachedTranscription->fingerprint == fingerprint;
+    }
+    std::shared_ptr<CachedTranscription> transcription;
+    if (reuseTranscription) {
+        transcription = m_cachedTranscription;
+        transcription->casProblem->updateBoundsAndWeights(getProblemRep());
+    } else {
+        transcription = std::make_shared<CachedTranscription>();
+        transcription->fingerprint = std::move(fingerprint);
+        transcription->casProblem = createCasOCProblem();
+        transcription->casSolver =
+                createCasOCSolver(*transcription->casProblem);
+        if (get_reuse_transcription()) {
+            m_cachedTranscription = transcription;
+        }
+    }
+    const auto& casProblem = transcription->casProblem;
+    const auto& casSolver = transcription->casSolver;
+    casProblem->updTimers().reset();
     if (get_verbosity()) {
         log_info("Number of threads: {}", casProblem->getJarSize());
+        if (reuseTranscription) {
+            log_info("Reusing the transcription from the previous solve.");
+        }
     }
 
     MocoTrajectory guess = getGuess();
@@ -334,16 +439,21 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     }
 
     // Temporarily disable printing of negative muscle force warnings so the
-    // log isn't flooded while computing finite differences.
-    Logger::Level origLoggerLevel = Logger::getLevel();
-    Logger::setLevel(Logger::Level::Warn);
+    // log isn't flooded while computing finite differences. The level is
+    // process-wide, so leave it alone if it is already set (e.g., by
+    // MocoStudy::solveMultiStart(), which solves on multiple threads).
+    const Logger::Level origLoggerLevel = Logger::getLevel();
+    const bool changeLoggerLevel = origLoggerLevel != Logger::Level::Warn;
+    if (changeLoggerLevel) Logger::setLevel(Logger::Level::Warn);
     CasOC::Solution casSolution;
     try {
-        casSolution = casSolver->solve(casGuess);
+        casSolution = reuseTranscription ? casSolver->resolve(casGuess)
+                                         : casSolver->solve(casGuess);
     } catch (...) {
-        OpenSim::Logger::setLevel(origLoggerLevel);
+        if (changeLoggerLevel) OpenSim::Logger::setLevel(origLoggerLevel);
+        throw;
     }
-    OpenSim::Logger::setLevel(origLoggerLevel);
+    if (changeLoggerLevel) OpenSim::Logger::setLevel(origLoggerLevel);
 
     MocoSolution mocoSolution =
             convertToMocoTrajectory<MocoSolution>(casSolution);
@@ -397,10 +507,16 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     setSolutionStats(mocoSolution, casSolution.stats.at("success"),
             casSolution.objective, casSolution.stats.at("return_status"),
             casSolution.stats.at("iter_count"), SimTK::nsToSec(elapsed),
-            casSolution.objective_breakdown);
+            casSolution.objective_breakdown,
+            casProblem->getTimers().getTimings());
 
     if (get_verbosity()) {
         log_info(std::string(72, '-'));
+        log_info("Copies of the problem created: {} (at most {} in use at "
+                 "once).",
+                casProblem->getJarNumCreated(),
+                casProblem->getJarHighWaterMark());
+        mocoSolution.printTimingBreakdown();
         log_info("Elapsed real time: {}.", stopwatch.formatNs(elapsed));
         log_info(getMocoFormattedDateTime(false, "%c"));
         if (mocoSolution) {
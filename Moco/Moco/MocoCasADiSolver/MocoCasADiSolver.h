@@ -20,6 +20,8 @@
 
 #include "../MocoDirectCollocationSolver.h"
 
+#include <functional>
+
 namespace CasOC {
 class Solver;
 } // namespace CasOC
@@ -34,9 +36,10 @@ class MocoCasOCProblem;
 /// solve your MocoProblem more quickly that MocoTropterSolver. In general,
 /// we hope that the feature sets of MocoCasADiSolver and MocoTropterSolver
 /// are the same.
-/// Note, however, that parameter optimization problems are implemented much
-/// less efficiently in this solver; for parameter optimization, first try
-/// MocoTropterSolver.
+/// Note, however, that parameter optimization problems may be solved less
+/// efficiently in this solver, as the derivatives with respect to each
+/// parameter require evaluating the problem at every grid point; for
+/// parameter optimization, also try MocoTropterSolver.
 ///
 /// Sparsity
 /// ========
@@ -103,6 +106,20 @@ class MocoCasOCProblem;
 /// Model::initSystem(). To protect against this, ensure that you obtain the
 /// same results whether this setting is true or false.
 ///
+/// Solving a problem many times
+/// =============================
+/// Transcribing the problem and constructing the nonlinear program (NLP) can
+/// be a sizable portion of the total time for a solve. If you solve the same
+/// problem many times, changing only goal weights or variable bounds
+/// (e.g., in a study of the sensitivity of the solution to goal weights),
+/// enable the `reuse_transcription` property. The solver then keeps the NLP
+/// between calls to MocoStudy::solve() and, if only goal weights or the bounds
+/// on time, states, controls, or parameters changed, solves the existing NLP
+/// again with the new weights (which are parameters of the NLP) and bounds.
+/// Any other change to the problem (including to reference data provided to
+/// goals in memory) or to this solver's properties causes the problem to be
+/// transcribed again. Copying the solver discards the NLP.
+///
 /// @note The software license of CasADi (LGPL) is more restrictive than that of
 /// the rest of Moco (Apache 2.0).
 /// @note This solver currently only supports systems for which \f$ \dot{q} = u
@@ -139,7 +156,15 @@ public:
             "Write intermediate trajectories to file. 0, the default, "
             "indicates no intermediate trajectories are saved, 1 indicates "
             "each iteration is saved, 5 indicates every fifth iteration is "
-            "saved, etc.");
+            "saved, etc. Files are written in the background; if writing "
+            "cannot keep up with the optimizer, some iterations are "
+            "skipped.");
+    OpenSim_DECLARE_PROPERTY(output_interval_format, std::string,
+            "File format of the intermediate trajectories written according "
+            "to 'output_interval': 'sto' (default) for text files, or 'traj' "
+            "for binary files that are smaller and faster to write. Both "
+            "formats can be read with MocoTrajectory or used as a guess "
+            "file.");
 
     OpenSim_DECLARE_PROPERTY(minimize_implicit_multibody_accelerations, bool,
             "Minimize the integral of the squared acceleration continuous "
@@ -157,6 +182,24 @@ public:
             "The weight on the cost term added if "
             "'minimize_implicit_auxiliary_derivatives' is enabled."
             "Default: 1.0.");
+    OpenSim_DECLARE_PROPERTY(jit_transcription, bool,
+            "Generate C code for the defect constraints, quadrature, and "
+            "control interpolation, and compile it with the system's C "
+            "compiler when solving. This reduces overhead for problems with "
+            "many mesh points and inexpensive dynamics, but compiling takes "
+            "time and requires a C compiler (default: false).");
+    OpenSim_DECLARE_PROPERTY(pseudospectral_degree, int,
+            "The degree of the polynomial that approximates the states in "
+            "each mesh interval if 'transcription_scheme' is "
+            "'legendre-gauss-radau' (default: 3).");
+    OpenSim_DECLARE_PROPERTY(shooting_integrator_num_steps, int,
+            "The number of fixed-size integration steps that propagate the "
+            "dynamics across each mesh interval if 'transcription_scheme' is "
+            "'multiple-shooting' (default: 10).");
+    OpenSim_DECLARE_PROPERTY(reuse_transcription, bool,
+            "Keep the transcribed problem between solves and solve it again "
+            "without re-transcribing if only goal weights or variable bounds "
+            "changed (default: false).");
 
     MocoCasADiSolver();
 
@@ -175,6 +218,10 @@ public:
     /// in the solver; you must call setGuess() or setGuessFile() for that.
     /// @precondition You must have called resetProblem().
     MocoTrajectory createGuess(const std::string& type = "bounds") const;
+    /// Create a guess of type "random" (see createGuess(const std::string&))
+    /// using the provided seed for the random number generator. Guesses with
+    /// different seeds differ, and guesses with the same seed are identical.
+    MocoTrajectory createRandomGuess(int seed) const;
 
     /// The number of time points in the trajectory does *not* need to match
     /// `num_mesh_intervals`; the trajectory will be interpolated to the correct
@@ -203,9 +250,28 @@ public:
 
     /// @}
 
+    /// The number of threads used to evaluate the problem in parallel, based
+    /// on the `parallel` property and the OPENSIM_MOCO_PARALLEL environment
+    /// variable.
+    int getNumThreads() const;
+
     /// @cond
     /// This is used to generate a warning.
     void setRunningInPython(bool value) const { m_runningInPython = value; }
+    /// The optimization stops (unsuccessfully) if this function returns true.
+    /// The function is invoked once for each iterate with the current value of
+    /// the objective, the largest constraint violation (infeasibility) of the
+    /// iterate, and the number of iterations so far in the current solve. It
+    /// may be invoked from multiple threads. This is used by
+    /// MocoStudy::solveMultiStart().
+    void setRequestStopFunction(
+            std::function<bool(double, double, int)> function) {
+        m_requestStopFunction = std::move(function);
+    }
+    const std::function<bool(double, double, int)>&
+    getRequestStopFunction() const {
+        return m_requestStopFunction;
+    }
     /// @endcond
 
 protected:
@@ -222,6 +288,11 @@ protected:
 private:
     void constructProperties();
 
+    /// A string that identifies everything about the problem and solver
+    /// settings except goal weights and variable bounds. If the string is
+    /// unchanged, a transcription can be reused.
+    std::string createTranscriptionFingerprint() const;
+
     // When a copy of the solver is made, we want to keep any guess specified
     // by the API, but want to discard anything we've cached by loading a file.
     MocoTrajectory m_guessFromAPI;
@@ -229,6 +300,13 @@ private:
     mutable SimTK::ReferencePtr<const MocoTrajectory> m_guessToUse;
 
     mutable bool m_runningInPython = false;
+    std::function<bool(double, double, int)> m_requestStopFunction;
+
+    // The problem and transcription kept between solves if
+    // reuse_transcription is enabled.
+    struct CachedTranscription;
+    mutable SimTK::ResetOnCopy<std::shared_ptr<CachedTranscription>>
+            m_cachedTranscription;
 };
 
 } // namespace OpenSim
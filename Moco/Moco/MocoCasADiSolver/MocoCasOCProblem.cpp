@@ -34,9 +34,40 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
         : m_jar(std::move(jar)),
           m_paramsRequireInitSystem(
                   mocoCasADiSolver.get_parameters_require_initsystem()),
-          m_formattedTimeString(getMocoFormattedDateTime(true)) {
+          m_shootingIntegratorNumSteps(
+                  mocoCasADiSolver.get_shooting_integrator_num_steps()),
+          m_formattedTimeString(getMocoFormattedDateTime(true)),
+          m_outputIntervalFormat(
+                  mocoCasADiSolver.get_output_interval_format()),
+          m_requestStopFunction(mocoCasADiSolver.getRequestStopFunction()) {
 
     setDynamicsMode(dynamicsMode);
+    m_writeIterateTimerIndex =
+            updTimers().addSection("write_intermediate_iterates");
+    if (mocoCasADiSolver.get_profile_goals()) {
+        // All copies of the problem record into the same timers so that
+        // evaluations on all threads are aggregated. The sections are added
+        // here, once, so that copies the jar creates on other threads only
+        // read the timers.
+        problemRep.addProfilerSections(updTimers());
+        std::vector<std::unique_ptr<const MocoProblemRep>> reps;
+        const int jarSize = m_jar->size();
+        for (int i = 0; i < jarSize; ++i) reps.push_back(m_jar->take());
+        for (auto& rep : reps) {
+            rep->setProfiler(&updTimers());
+            m_jar->leave(std::move(rep));
+        }
+        // Copies of the problem that the jar creates later must also record
+        // into these timers.
+        if (const auto factory = m_jar->getFactory()) {
+            const SolverTimers* profiler = &getTimers();
+            m_jar->setFactory([factory, profiler]() {
+                auto rep = factory();
+                rep->setProfiler(profiler);
+                return rep;
+            });
+        }
+    }
     const auto& model = problemRep.getModelBase();
 
     // Ensure the model does not have user-provided controllers.
@@ -93,6 +124,40 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
 
     setAuxiliaryDerivativeNames(derivativeNames);
 
+    // In implicit mode, the multibody residuals require only the applied
+    // forces (Stage::Dynamics). If all auxiliary dynamics are also in implicit
+    // form, the auxiliary derivatives are derivative variables, and we need
+    // not realize to Acceleration to compute zdot. With prescribed
+    // kinematics, Simbody computes udot from the prescribed motion.
+    if (isDynamicsModeImplicit() && !problemRep.isPrescribedKinematics()) {
+        std::unordered_map<std::string, int> implicitIndices;
+        const std::string prefix = "implicitderiv_";
+        for (int i = 0; i < (int)implicitRefs.size(); ++i) {
+            const auto& implicitRef = implicitRefs[i];
+            implicitIndices[implicitRef.second->getAbsolutePathString() + "/" +
+                            implicitRef.first.substr(prefix.size())] = i;
+        }
+        bool dynamicsStage = true;
+        for (const auto& stateName : stateNames) {
+            if (endsWith(stateName, "/value") || endsWith(stateName, "/speed"))
+                continue;
+            const auto it = implicitIndices.find(stateName);
+            if (it == implicitIndices.end()) {
+                dynamicsStage = false;
+                break;
+            }
+            m_implicitAuxiliaryDerivativeIndices.push_back(it->second);
+        }
+        for (const auto& residualOutput :
+                problemRep.getImplicitResidualReferencePtrs()) {
+            if (residualOutput->getDependsOnStage() > SimTK::Stage::Dynamics) {
+                dynamicsStage = false;
+            }
+        }
+        m_calcImplicitResidualsAtDynamicsStage = dynamicsStage;
+        if (!dynamicsStage) m_implicitAuxiliaryDerivativeIndices.clear();
+    }
+
     // Add any scalar constraints associated with kinematic constraints in
     // the model as path constraints in the problem.
     // Whether or not enabled kinematic constraints exist in the model,
@@ -224,7 +289,8 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
         const auto costNames = problemRep.createCostNames();
         for (const auto& name : costNames) {
             const auto& cost = problemRep.getCost(name);
-            addCost(name, cost.getNumIntegrals(), cost.getNumOutputs());
+            addCost(name, cost.getNumIntegrals(), cost.getNumOutputs(),
+                    cost.getWeight());
         }
     }
     {
@@ -254,3 +320,32 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
             fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
                     problemRep.getName(), m_formattedTimeString));
 }
+
+void MocoCasOCProblem::updateBoundsAndWeights(
+        const MocoProblemRep& problemRep) {
+    setTimeBounds(convertBounds(problemRep.getTimeInitialBounds()),
+            convertBounds(problemRep.getTimeFinalBounds()));
+    const auto& stateInfos = getStateInfos();
+    for (int is = 0; is < (int)stateInfos.size(); ++is) {
+        const auto& info = problemRep.getStateInfo(stateInfos[is].name);
+        setStateBounds(is, convertBounds(info.getBounds()),
+                convertBounds(info.getInitialBounds()),
+                convertBounds(info.getFinalBounds()));
+    }
+    const auto& controlInfos = getControlInfos();
+    for (int ic = 0; ic < (int)controlInfos.size(); ++ic) {
+        const auto& info = problemRep.getControlInfo(controlInfos[ic].name);
+        setControlBounds(ic, convertBounds(info.getBounds()),
+                convertBounds(info.getInitialBounds()),
+                convertBounds(info.getFinalBounds()));
+    }
+    const auto& paramInfos = getParameterInfos();
+    for (int ip = 0; ip < (int)paramInfos.size(); ++ip) {
+        const auto& param = problemRep.getParameter(paramInfos[ip].name);
+        setParameterBounds(ip, convertBounds(param.getBounds()));
+    }
+    const auto& costInfos = getCostInfos();
+    for (int ic = 0; ic < (int)costInfos.size(); ++ic) {
+        setCostWeight(ic, problemRep.getCost(costInfos[ic].name).getWeight());
+    }
+}
@@ -197,7 +197,20 @@ public:
             std::unique_ptr<ThreadsafeJar<const MocoProblemRep>> jar,
             std::string dynamicsMode);
 
-    int getJarSize() const { return (int)m_jar->size(); }
+    /// The maximum number of threads that can evaluate this problem at once.
+    int getJarSize() const { return m_jar->getCapacity(); }
+    /// The number of copies of the MocoProblemRep created so far. Copies are
+    /// created only when all existing copies are in use.
+    int getJarNumCreated() const { return m_jar->getNumCreated(); }
+    /// The largest number of copies of the MocoProblemRep that were in use at
+    /// once.
+    int getJarHighWaterMark() const { return m_jar->getHighWaterMark(); }
+
+    /// Update variable bounds and cost weights from the provided
+    /// MocoProblemRep, which must have the same structure (variables, goals,
+    /// constraints) as the MocoProblemRep used to construct this object.
+    /// This allows solving the problem again with CasOC::Solver::resolve().
+    void updateBoundsAndWeights(const MocoProblemRep& mocoProblemRep);
 
 private:
     void calcMultibodySystemExplicit(const ContinuousInput& input,
@@ -224,7 +237,7 @@ private:
         // Compute kinematic constraint errors if they exist.
         if (getNumMultipliers() && calcKCErrors) {
             calcKinematicConstraintErrors(modelBase, simtkStateBase,
-                    simtkStateDisabledConstraints,
+                    simtkStateDisabledConstraints.getUDot(),
                     output.kinematic_constraint_errors);
         }
 
@@ -263,8 +276,19 @@ private:
                 input.controls, input.multipliers, input.derivatives,
                 input.parameters, mocoProblemRep);
 
-        modelDisabledConstraints.realizeAcceleration(
-                simtkStateDisabledConstraints);
+        // Inverse dynamics requires only the applied forces, so we avoid
+        // realizing to Acceleration unless we need auxiliary derivatives that
+        // are computed at that stage.
+        if (m_calcImplicitResidualsAtDynamicsStage) {
+            modelDisabledConstraints.realizeDynamics(
+                    simtkStateDisabledConstraints);
+        } else {
+            modelDisabledConstraints.realizeAcceleration(
+                    simtkStateDisabledConstraints);
+        }
+
+        const SimTK::Vector udot(getNumAccelerations(),
+                input.derivatives.ptr(), true);
 
         // Compute kinematic constraint errors if they exist.
         // TODO: Do not enforce kinematic constraints if prescribedKinematics,
@@ -272,8 +296,7 @@ private:
         // constraints. This is simple at the q and u level (using assemble()),
         // but what do we do for the acceleration level?
         if (getNumMultipliers() && calcKCErrors) {
-            calcKinematicConstraintErrors(modelBase, simtkStateBase,
-                    simtkStateDisabledConstraints,
+            calcKinematicConstraintErrors(modelBase, simtkStateBase, udot,
                     output.kinematic_constraint_errors);
         }
 
@@ -281,13 +304,35 @@ private:
                 modelDisabledConstraints.getMatterSubsystem();
         SimTK::Vector simtkResidual((int)output.multibody_residuals.rows(),
                 output.multibody_residuals.ptr(), true);
-        matterDisabledConstraints.findMotionForces(
-                simtkStateDisabledConstraints, simtkResidual);
+        if (m_calcImplicitResidualsAtDynamicsStage) {
+            // residual = M(q) udot + C(q, u) - F
+            const auto& system = modelDisabledConstraints.getMultibodySystem();
+            matterDisabledConstraints.calcResidualForceIgnoringConstraints(
+                    simtkStateDisabledConstraints,
+                    system.getMobilityForces(simtkStateDisabledConstraints,
+                            SimTK::Stage::Dynamics),
+                    system.getRigidBodyForces(simtkStateDisabledConstraints,
+                            SimTK::Stage::Dynamics),
+                    udot, simtkResidual);
+
+            // All auxiliary dynamics are in implicit form, so the auxiliary
+            // derivatives are the solver's derivative variables.
+            const auto& indices = m_implicitAuxiliaryDerivativeIndices;
+            const double* auxDerivatives =
+                    input.derivatives.ptr() + getNumAccelerations();
+            for (int iz = 0; iz < (int)indices.size(); ++iz) {
+                *(output.auxiliary_derivatives.ptr() + iz) =
+                        auxDerivatives[indices[iz]];
+            }
+        } else {
+            matterDisabledConstraints.findMotionForces(
+                    simtkStateDisabledConstraints, simtkResidual);
 
-        // Copy auxiliary dynamics to output.
-        const auto& zdot = simtkStateDisabledConstraints.getZDot();
-        std::copy_n(zdot.getContiguousScalarData(), zdot.size(),
-                output.auxiliary_derivatives.ptr());
+            // Copy auxiliary dynamics to output.
+            const auto& zdot = simtkStateDisabledConstraints.getZDot();
+            std::copy_n(zdot.getContiguousScalarData(), zdot.size(),
+                    output.auxiliary_derivatives.ptr());
+        }
 
         // Copy auxiliary residuals to output.
         copyImplicitResidualsToOutput(*mocoProblemRep,
@@ -330,12 +375,59 @@ private:
 
         m_jar->leave(std::move(mocoProblemRep));
     }
+    void calcShootingSegment(const double& initialTime,
+            const double& finalTime, const casadi::DM& states,
+            const casadi::DM& controls, const casadi::DM& parameters,
+            casadi::DM& finalStates) const override {
+        auto mocoProblemRep = m_jar->take();
+
+        const auto& modelDisabledConstraints =
+                mocoProblemRep->getModelDisabledConstraints();
+        auto& simtkStateDisabledConstraints =
+                mocoProblemRep->updStateDisabledConstraints();
+
+        // The controls are stored in the state as discrete variables, so
+        // they are held constant during the integration.
+        applyInput(SimTK::Stage::Dynamics, initialTime, states, controls,
+                casadi::DM(), casadi::DM(), parameters, mocoProblemRep);
+
+        // Each segment uses its own integrator so that segments can be
+        // integrated concurrently on different MocoProblemReps. With a fixed
+        // step size, the integrator takes the same steps for all inputs
+        // instead of adapting them to an error estimate, so the final states
+        // are a smooth function of the inputs and finite differences of the
+        // defects are not polluted by changes in the step sequence.
+        const auto& system = modelDisabledConstraints.getSystem();
+        SimTK::RungeKuttaMersonIntegrator integrator(system);
+        if (finalTime > initialTime) {
+            integrator.setFixedStepSize(
+                    (finalTime - initialTime) / m_shootingIntegratorNumSteps);
+        }
+        integrator.setAllowInterpolation(false);
+        SimTK::TimeStepper timeStepper(system, integrator);
+        timeStepper.initialize(simtkStateDisabledConstraints);
+        timeStepper.stepTo(finalTime);
+
+        // Copy the final state, in the order of the problem's states.
+        const SimTK::State& finalState = integrator.getState();
+        for (int isv = 0; isv < getNumCoordinates(); ++isv) {
+            *(finalStates.ptr() + isv) = finalState.getQ()[m_yIndexMap.at(isv)];
+        }
+        std::copy_n(finalState.getY().getContiguousScalarData() +
+                            finalState.getNQ(),
+                getNumSpeeds() + getNumAuxiliaryStates(),
+                finalStates.ptr() + getNumCoordinates());
+
+        m_jar->leave(std::move(mocoProblemRep));
+    }
     void calcCostIntegrand(int index, const ContinuousInput& input,
             double& integrand) const override {
         auto mocoProblemRep = m_jar->take();
 
         const auto& mocoCost = mocoProblemRep->getCostByIndex(index);
         const auto stageDep = mocoCost.getStageDependency();
+        SolverTimers::ScopedTimer timer(
+                mocoCost.getProfiler(), mocoCost.getIntegrandProfileIndex());
 
         applyInput(stageDep, input.time, input.states, input.controls,
                 input.multipliers, input.derivatives, input.parameters,
@@ -360,6 +452,8 @@ private:
 
         const auto& mocoCost = mocoProblemRep->getCostByIndex(index);
         const auto stageDep = mocoCost.getStageDependency();
+        SolverTimers::ScopedTimer timer(
+                mocoCost.getProfiler(), mocoCost.getGoalProfileIndex());
 
         applyInput(stageDep, input.initial_time, input.initial_states,
                 input.initial_controls, input.initial_multipliers,
@@ -382,9 +476,10 @@ private:
         const auto& rawControlsFinal = discreteController.getDiscreteControls(
                 simtkStateDisabledConstraintsFinal);
 
-        // Compute the cost for this cost term.
+        // Compute the cost for this cost term. The transcription applies the
+        // weight.
         SimTK::Vector simtkCost((int)cost.rows(), cost.ptr(), true);
-        mocoCost.calcGoal(
+        mocoCost.calcGoalUnweighted(
                 {input.initial_time, simtkStateDisabledConstraintsInitial,
                         rawControlsInitial, input.final_time,
                         simtkStateDisabledConstraintsFinal, rawControlsFinal,
@@ -401,6 +496,8 @@ private:
         const auto& mocoEC =
                 mocoProblemRep->getEndpointConstraintByIndex(index);
         const auto stageDep = mocoEC.getStageDependency();
+        SolverTimers::ScopedTimer timer(
+                mocoEC.getProfiler(), mocoEC.getIntegrandProfileIndex());
 
         applyInput(stageDep, input.time, input.states, input.controls,
                 input.multipliers, input.derivatives, input.parameters,
@@ -426,6 +523,8 @@ private:
         const auto& mocoEC =
                 mocoProblemRep->getEndpointConstraintByIndex(index);
         const auto stageDep = mocoEC.getStageDependency();
+        SolverTimers::ScopedTimer timer(
+                mocoEC.getProfiler(), mocoEC.getGoalProfileIndex());
 
         applyInput(stageDep, input.initial_time, input.initial_states,
                 input.initial_controls, input.initial_multipliers,
@@ -463,6 +562,10 @@ private:
     void calcPathConstraint(int constraintIndex, const ContinuousInput& input,
             casadi::DM& path_constraint) const override {
         auto mocoProblemRep = m_jar->take();
+        const auto& mocoPathCon =
+                mocoProblemRep->getPathConstraintByIndex(constraintIndex);
+        SolverTimers::ScopedTimer timer(
+                mocoPathCon.getProfiler(), mocoPathCon.getProfileIndex());
         // Not all path constraints require realizing to Acceleration. We could
         // add a stage dependency for path constraints, but we have yet to
         // conduct profiling to indicate that such an optimization is necessary.
@@ -473,8 +576,6 @@ private:
                 mocoProblemRep->updStateDisabledConstraints();
 
         // Compute path constraint errors.
-        const auto& mocoPathCon =
-                mocoProblemRep->getPathConstraintByIndex(constraintIndex);
         SimTK::Vector errors(
                 (int)path_constraint.rows(), path_constraint.ptr(), true);
         mocoPathCon.calcPathConstraintErrors(
@@ -493,11 +594,18 @@ private:
     void intermediateCallbackImpl() const override {
         m_fileDeletionThrower->throwIfDeleted();
     }
+    bool requestStopImpl(double objective, double infeasibility,
+            int iteration) const override {
+        return m_requestStopFunction &&
+               m_requestStopFunction(objective, infeasibility, iteration);
+    }
     void intermediateCallbackWithIterateImpl(
             const CasOC::Iterate& iterate) const override {
         std::string filename =
-                fmt::format("MocoCasADiSolver_{}_trajectory{:06i}.sto",
-                        m_formattedTimeString, iterate.iteration);
+                fmt::format("MocoCasADiSolver_{}_trajectory{:06i}.{}",
+                        m_formattedTimeString, iterate.iteration,
+                        m_outputIntervalFormat);
+        SolverTimers::ScopedTimer timer(getTimers(), m_writeIterateTimerIndex);
         convertToMocoTrajectory(iterate).write(filename);
     }
 
@@ -518,27 +626,51 @@ private:
     /// slots in Simbody's Y vector.
     /// It's fine for the size of `states` to be less than the size of Y; only
     /// the first states.size1() values are copied.
+    /// Setting the time or the generalized coordinates invalidates the
+    /// Position stage, whose cache entries include muscle-tendon lengths and
+    /// moment arms. When the optimizer perturbs only velocity-level or later
+    /// inputs (e.g., controls or auxiliary states) to compute derivatives,
+    /// the time and coordinates are unchanged, so we leave them (and the
+    /// Position stage cache) untouched. Changing parameters invalidates the
+    /// cache separately; see
+    /// MocoProblemRep::applyParametersToModelProperties().
+    /// If the state is not realized to Time (e.g., a new state, or enabling a
+    /// PositionMotion), we cannot rely on its coordinates having been
+    /// prescribed for its current time, so we prescribe them.
     void convertStatesToSimTKState(SimTK::Stage stageDep, const double& time,
             const casadi::DM& states, const Model& model,
             SimTK::State& simtkState, bool copyAuxStates) const {
         if (stageDep >= SimTK::Stage::Time) {
-            simtkState.setTime(time);
-            // Assign the generalized coordinates. We know we have NU
-            // generalized speeds because we do not yet support quaternions.
-            for (int isv = 0; isv < getNumCoordinates(); ++isv) {
-                simtkState.updQ()[m_yIndexMap.at(isv)] = *(states.ptr() + isv);
+            bool positionChanged =
+                    simtkState.getSystemStage() < SimTK::Stage::Time ||
+                    simtkState.getTime() != time;
+            for (int isv = 0; isv < getNumCoordinates() && !positionChanged;
+                    ++isv) {
+                positionChanged = simtkState.getQ()[m_yIndexMap.at(isv)] !=
+                                  *(states.ptr() + isv);
+            }
+            if (positionChanged) {
+                simtkState.setTime(time);
+                // Assign the generalized coordinates. We know we have NU
+                // generalized speeds because we do not yet support
+                // quaternions.
+                auto& q = simtkState.updQ();
+                for (int isv = 0; isv < getNumCoordinates(); ++isv) {
+                    q[m_yIndexMap.at(isv)] = *(states.ptr() + isv);
+                }
+            }
+            if (getNumSpeeds()) {
+                std::copy_n(states.ptr() + getNumCoordinates(), getNumSpeeds(),
+                        simtkState.updU().updContiguousScalarData());
             }
-            std::copy_n(states.ptr() + getNumCoordinates(), getNumSpeeds(),
-                    simtkState.updY().updContiguousScalarData() +
-                            simtkState.getNQ());
-            if (copyAuxStates) {
+            if (copyAuxStates && getNumAuxiliaryStates()) {
                 std::copy_n(states.ptr() + getNumCoordinates() + getNumSpeeds(),
                         getNumAuxiliaryStates(),
-                        simtkState.updY().updContiguousScalarData() +
-                                simtkState.getNQ() + simtkState.getNU());
+                        simtkState.updZ().updContiguousScalarData());
             }
-            // Prescribing motion requires that time is updated.
-            model.getSystem().prescribe(simtkState);
+            // Prescribing motion requires that time is updated. Prescribed
+            // motion depends only on time and the coordinates.
+            if (positionChanged) model.getSystem().prescribe(simtkState);
         }
     }
 
@@ -662,8 +794,7 @@ private:
     }
 
     void calcKinematicConstraintErrors(const Model& modelBase,
-            const SimTK::State& stateBase,
-            const SimTK::State& simtkStateDisabledConstraints,
+            const SimTK::State& stateBase, const SimTK::Vector& udot,
             casadi::DM& kinematic_constraint_errors) const {
 
         // If all kinematics are prescribed, we assume that the prescribed
@@ -689,8 +820,7 @@ private:
             // since we cannot use (nor do we have available) udot computed
             // from the original model.
             const auto& matter = modelBase.getMatterSubsystem();
-            matter.calcConstraintAccelerationErrors(stateBase,
-                    simtkStateDisabledConstraints.getUDot(), m_pvaerr);
+            matter.calcConstraintAccelerationErrors(stateBase, udot, m_pvaerr);
         } else {
             m_pvaerr = SimTK::NaN;
         }
@@ -747,10 +877,21 @@ private:
 
     std::unique_ptr<ThreadsafeJar<const MocoProblemRep>> m_jar;
     bool m_paramsRequireInitSystem = true;
+    // In implicit mode, whether the multibody residuals and auxiliary
+    // derivatives can be computed without realizing to Acceleration.
+    bool m_calcImplicitResidualsAtDynamicsStage = false;
+    // For each auxiliary state, the index of its derivative variable among
+    // the implicit auxiliary derivatives. Used only if
+    // m_calcImplicitResidualsAtDynamicsStage is true.
+    std::vector<int> m_implicitAuxiliaryDerivativeIndices;
+    int m_shootingIntegratorNumSteps = 10;
     std::string m_formattedTimeString;
+    std::string m_outputIntervalFormat;
+    int m_writeIterateTimerIndex = -1;
     std::unordered_map<int, int> m_yIndexMap;
     std::vector<int> m_modelControlIndices;
     std::unique_ptr<FileDeletionThrower> m_fileDeletionThrower;
+    std::function<bool(double, double, int)> m_requestStopFunction;
     // Local memory to hold constraint forces.
     static thread_local SimTK::Vector_<SimTK::SpatialVec>
             m_constraintBodyForces;
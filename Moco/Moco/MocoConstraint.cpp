@@ -147,3 +147,15 @@ void MocoPathConstraint::initializeOnModel(const Model& model,
         "zero.");
     m_path_constraint_index = pathConstraintIndex;    
 }
+
+void MocoPathConstraint::addProfilerSections(SolverTimers& profiler) const {
+    profiler.addSection("path_constraint_" + getName() + "_errors");
+}
+
+void MocoPathConstraint::setProfiler(const SolverTimers* profiler) const {
+    m_profiler.reset(profiler);
+    if (profiler) {
+        m_profileIndex = profiler->getSectionIndex(
+                "path_constraint_" + getName() + "_errors");
+    }
+}
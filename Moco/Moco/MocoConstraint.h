@@ -185,12 +185,31 @@ public:
                 errors.updContiguousScalarData() + getPathConstraintIndex(),
                 true);
         calcPathConstraintErrorsImpl(state, theseErrors);
+        if (m_profiler) {
+            m_profiler->addStage(m_profileIndex, state.getSystemStage());
+        }
     }
 
     /// For use by solvers. This also performs error checks on the Problem.
     void initializeOnModel(const Model& model, const MocoProblemInfo&,
             const int& pathConstraintIndex) const;
 
+    /// For use by solvers. Add the section "path_constraint_<name>_errors" to
+    /// the provided timers. Call this once, before solving and before
+    /// setProfiler(); adding sections is not thread-safe.
+    void addProfilerSections(SolverTimers& profiler) const;
+    /// For use by solvers. Record the highest stage realized by
+    /// calcPathConstraintErrors() in the section added by
+    /// addProfilerSections(). Solvers record the number of evaluations and
+    /// the time spent with a SolverTimers::ScopedTimer on getProfiler() and
+    /// getProfileIndex(). See MocoGoal::setProfiler().
+    void setProfiler(const SolverTimers* profiler) const;
+    /// The timers provided to setProfiler(), or nullptr if this constraint is
+    /// not being profiled.
+    const SolverTimers* getProfiler() const { return m_profiler.get(); }
+    /// @copydoc getProfiler()
+    int getProfileIndex() const { return m_profileIndex; }
+
 protected:
     OpenSim_DECLARE_UNNAMED_PROPERTY(MocoConstraintInfo,
             "The bounds and "
@@ -234,6 +253,8 @@ private:
 
     mutable SimTK::ReferencePtr<const Model> m_model;
     mutable int m_path_constraint_index = -1;
+    mutable SimTK::ReferencePtr<const SolverTimers> m_profiler;
+    mutable int m_profileIndex = -1;
 };
 
 } // namespace OpenSim
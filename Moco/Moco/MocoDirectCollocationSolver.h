@@ -48,6 +48,32 @@ namespace OpenSim {
 /// including model kinematic constraints, the 'hermite-simpson' option is
 /// required (see Kinematic constraints section below).
 ///
+/// MocoCasADiSolver also supports the 'legendre-gauss-radau' pseudospectral
+/// transcription scheme. Within each mesh interval, the states are
+/// approximated by a polynomial whose degree is set by MocoCasADiSolver's
+/// `pseudospectral_degree` property, and the differential equations are
+/// enforced at the Legendre-Gauss-Radau points of the interval. This scheme
+/// converges quickly for problems with smooth solutions, often with far fewer
+/// mesh intervals than the other schemes. Controls are free variables at
+/// every collocation point, and model kinematic constraints are not
+/// supported.
+///
+/// MocoCasADiSolver also supports 'multiple-shooting' transcription, which is
+/// not a collocation scheme: each mesh interval is a shooting segment whose
+/// dynamics are integrated with a fixed number of Runge-Kutta-Merson steps
+/// (set by MocoCasADiSolver's `shooting_integrator_num_steps` property) while
+/// the controls are held at their values at the start of the interval. The
+/// steps are not error-controlled, so the integrated states are a smooth
+/// function of the variables and their finite-difference derivatives are
+/// accurate. The segments are integrated in parallel (see the `parallel`
+/// property). The optimization problem contains variables only at the mesh
+/// points, so fast dynamics (e.g., muscles) are resolved by the integration
+/// steps rather than by mesh points. The integrator is explicit, so stiff
+/// dynamics require enough steps per interval to remain stable. Integral goals
+/// are approximated with trapezoidal quadrature over the mesh points. This
+/// scheme requires explicit dynamics and does not support kinematic
+/// constraints.
+///
 /// Path constraints on controls with Hermite-Simpson transcription
 /// ---------------------------------------------------------------
 /// For Hermite-Simpson transcription, the direct collocation solvers enforce
@@ -97,8 +123,10 @@ public:
             "0 for silent. 1 for only Moco's own output. "
             "2 for output from CasADi and the underlying solver (default: 2).");
     OpenSim_DECLARE_PROPERTY(transcription_scheme, std::string,
-            "'trapezoidal' for trapezoidal transcription, or 'hermite-simpson' "
-            "(default) for separated Hermite-Simpson transcription.");
+            "'trapezoidal' for trapezoidal transcription, 'hermite-simpson' "
+            "(default) for separated Hermite-Simpson transcription, "
+            "'legendre-gauss-radau' for pseudospectral transcription, or "
+            "'multiple-shooting' (the last two for MocoCasADiSolver only).");
     OpenSim_DECLARE_PROPERTY(interpolate_control_midpoints, bool,
             "If the transcription scheme is set to 'hermite-simpson', then "
             "enable this property to constrain the control values at mesh "
@@ -151,6 +179,13 @@ public:
     OpenSim_DECLARE_PROPERTY(implicit_auxiliary_derivative_bounds, MocoBounds,
             "Bounds on derivative variables for components with auxiliary "
             "dynamics in implicit form. Default: [-1000, 1000]");
+    OpenSim_DECLARE_PROPERTY(profile_goals, bool,
+            "Record the number of evaluations of, the time spent in, and the "
+            "highest stage realized by each goal and path constraint, "
+            "aggregated across threads and reported in the solution's timing "
+            "breakdown. The time includes realizing the state to the goal's "
+            "stage dependency. This adds a small overhead to each evaluation "
+            "(default: false).");
 
     MocoDirectCollocationSolver() { constructProperties(); }
 
@@ -115,6 +115,9 @@ protected:
             goal[0] = input.integral;
     }
     void printDescriptionImpl() const override;
+    std::size_t calcReferenceDataHashImpl() const override {
+        return std::hash<std::string>()(m_ref_splines.dump());
+    }
 
 private:
     OpenSim_DECLARE_PROPERTY(acceleration_reference_file, std::string,
@@ -143,6 +143,9 @@ protected:
         cost[0] = input.integral;
     }
     void printDescriptionImpl() const override;
+    std::size_t calcReferenceDataHashImpl() const override {
+        return std::hash<std::string>()(m_ref_splines.dump());
+    }
 
 private:
     OpenSim_DECLARE_PROPERTY(states_reference, TableProcessor,
@@ -101,13 +101,14 @@ void MocoContactTrackingGoal::initializeOnModelImpl(const Model& model) const {
     const std::string dataFilePath = getAbsolutePathnameFromXMLDocument(
             extLoads->getDocumentFileName(), extLoads->getDataFileName());
     TimeSeriesTable data(dataFilePath);
-    GCVSplineSet allRefSplines(data);
 
     // Each ExternalForce has an applied_to_body property. For the ExternalForce
     // to be properly paired with a group of contact force components, the
     // contact force components must also apply forces to the same body. Here,
     // we find which of the two bodies in each contact force component matches
     // the ExternalForce body.
+    m_groups.clear();
+    std::vector<std::string> refLabels;
     for (int ig = 0; ig < getProperty_contact_groups().size(); ++ig) {
         const auto& group = get_contact_groups(ig);
 
@@ -132,13 +133,14 @@ void MocoContactTrackingGoal::initializeOnModelImpl(const Model& model) const {
                     std::make_pair(&contactForce, recordOffset));
         }
 
-        // Gather the relevant data splines for this contact group.
+        // Spline only the relevant data for this contact group.
         // We assume that the "x", "y", and "z" columns could have been in any
         // order.
         const std::string& forceID = extForce.get_force_identifier();
-        groupInfo.refSplines.cloneAndAppend(allRefSplines.get(forceID + "x"));
-        groupInfo.refSplines.cloneAndAppend(allRefSplines.get(forceID + "y"));
-        groupInfo.refSplines.cloneAndAppend(allRefSplines.get(forceID + "z"));
+        groupInfo.refSplineIndex = (int)refLabels.size();
+        refLabels.push_back(forceID + "x");
+        refLabels.push_back(forceID + "y");
+        refLabels.push_back(forceID + "z");
 
         // Check which frame the contact force data is expressed in.
         groupInfo.refExpressedInFrame = nullptr;
@@ -163,6 +165,7 @@ void MocoContactTrackingGoal::initializeOnModelImpl(const Model& model) const {
 
         m_groups.push_back(groupInfo);
     }
+    m_refsplines.fit(data, refLabels);
 
     // Should the contact force errors be projected onto a plane or vector?
     if (get_projection() == "vector") {
@@ -260,7 +263,8 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
 
         // Reference force.
         for (int ir = 0; ir < force_ref.size(); ++ir) {
-            force_ref[ir] = group.refSplines[ir].calcValue(timeVec);
+            force_ref[ir] =
+                    m_refsplines.calcValue(group.refSplineIndex + ir, timeVec);
         }
 
         // Re-express the reference force.
@@ -286,6 +290,10 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
     }
 }
 
+std::size_t MocoContactTrackingGoal::calcReferenceDataHashImpl() const {
+    return m_refsplines.calcDataHash();
+}
+
 void MocoContactTrackingGoal::printDescriptionImpl() const {
     log_cout("        projection type: {}", get_projection());
     if (m_projectionType != ProjectionType::None) {
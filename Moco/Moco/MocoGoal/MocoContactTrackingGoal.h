@@ -222,6 +222,7 @@ protected:
         cost[0] = input.integral / m_denominator;
     }
     void printDescriptionImpl() const override;
+    std::size_t calcReferenceDataHashImpl() const override;
 
 private:
     OpenSim_DECLARE_LIST_PROPERTY(contact_groups, MocoContactTrackingGoalGroup,
@@ -260,14 +261,17 @@ private:
 
     /// Each contact group includes a list of contact force components (with an
     /// int that keeps track of whether we want to use the force applied to the
-    /// sphere or to the half space) and a spline representation of associated
-    /// experimental data.
+    /// sphere or to the half space) and the index of the first of the three
+    /// splines (x, y, z) of associated experimental data in m_refsplines.
     struct GroupInfo {
         std::vector<std::pair<const SmoothSphereHalfSpaceForce*, int>> contacts;
-        GCVSplineSet refSplines;
+        int refSplineIndex = -1;
         const PhysicalFrame* refExpressedInFrame = nullptr;
     };
     mutable std::vector<GroupInfo> m_groups;
+    // Copies of this goal (e.g., one per thread in a solver) share the
+    // splines.
+    mutable SharedReferenceSplines m_refsplines;
 };
 
 } // namespace OpenSim
@@ -35,6 +35,21 @@ MocoGoal::MocoGoal(std::string name, double weight)
 }
 
 
+void MocoGoal::addProfilerSections(SolverTimers& profiler) const {
+    profiler.addSection("goal_" + getName() + "_integrand");
+    profiler.addSection("goal_" + getName() + "_endpoint");
+}
+
+void MocoGoal::setProfiler(const SolverTimers* profiler) const {
+    m_profiler.reset(profiler);
+    if (profiler) {
+        m_integrandProfileIndex =
+                profiler->getSectionIndex("goal_" + getName() + "_integrand");
+        m_goalProfileIndex =
+                profiler->getSectionIndex("goal_" + getName() + "_endpoint");
+    }
+}
+
 void MocoGoal::printDescription() const {
     const auto mode = getModeAsString();
     std::string str = fmt::format("  {}. {}, enabled: {}, mode: {}",
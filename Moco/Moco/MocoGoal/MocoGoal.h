@@ -20,6 +20,7 @@
 
 #include "../MocoBounds.h"
 #include "../MocoConstraintInfo.h"
+#include "../MocoUtilities.h"
 #include "../osimMocoDLL.h"
 
 #include <SimTKcommon/internal/State.h>
@@ -182,6 +183,10 @@ public:
         const SimTK::Stage stageBefore = input.state.getSystemStage();
 
         calcIntegrandImpl(input, integrand);
+        if (m_profiler) {
+            m_profiler->addStage(
+                    m_integrandProfileIndex, input.state.getSystemStage());
+        }
 
         if (input.state.getSystemStage() > stageBefore) {
             SimTK_ERRCHK2_ALWAYS(
@@ -213,6 +218,14 @@ public:
     /// different scalar equation to enforce as a constraint.
     /// The length of the returned vector is getNumOutputs().
     void calcGoal(const GoalInput& input, SimTK::Vector& goal) const {
+        calcGoalUnweighted(input, goal);
+        goal *= m_weightToUse;
+    }
+    /// This is the same as calcGoal(), except that the returned cost does not
+    /// include the weight. This is for solvers that apply the weight
+    /// themselves (e.g., as a parameter of the optimization problem, so that
+    /// the weight can change without re-transcribing the problem).
+    void calcGoalUnweighted(const GoalInput& input, SimTK::Vector& goal) const {
         goal.resize(getNumOutputs());
         goal = 0;
         if (!get_enabled()) { return; }
@@ -222,6 +235,12 @@ public:
                 input.final_state.getSystemStage();
 
         calcGoalImpl(input, goal);
+        if (m_profiler) {
+            m_profiler->addStage(
+                    m_goalProfileIndex, input.initial_state.getSystemStage());
+            m_profiler->addStage(
+                    m_goalProfileIndex, input.final_state.getSystemStage());
+        }
 
         if (input.initial_state.getSystemStage() > initialStageBefore) {
             SimTK_ERRCHK2_ALWAYS(
@@ -243,7 +262,6 @@ public:
                     m_stageDependency.getName().c_str(),
                     input.final_state.getSystemStage().getName().c_str());
         }
-        goal *= m_weightToUse;
     }
     /// For use by solvers. This also performs error checks on the Problem.
     void initializeOnModel(const Model& model) const {
@@ -277,6 +295,36 @@ public:
                 "but it was not.");
     }
 
+    /// For use by solvers. Add the sections "goal_<name>_integrand" and
+    /// "goal_<name>_endpoint" to the provided timers. Call this once, before
+    /// solving and before setProfiler(); adding sections is not thread-safe.
+    void addProfilerSections(SolverTimers& profiler) const;
+    /// For use by solvers. Record the highest stage realized by
+    /// calcIntegrand() and calcGoal() in the sections added by
+    /// addProfilerSections(). Solvers record the number of evaluations and
+    /// the time spent, including realizing the state to the stage
+    /// dependency, with a SolverTimers::ScopedTimer on getProfiler() and
+    /// getIntegrandProfileIndex() or getGoalProfileIndex(). This does not
+    /// modify the timers, so copies of the problem on different threads can
+    /// share the same timers. Pass nullptr to stop profiling.
+    void setProfiler(const SolverTimers* profiler) const;
+    /// The timers provided to setProfiler(), or nullptr if this goal is not
+    /// being profiled.
+    const SolverTimers* getProfiler() const { return m_profiler.get(); }
+    /// @copydoc getProfiler()
+    int getIntegrandProfileIndex() const { return m_integrandProfileIndex; }
+    /// @copydoc getProfiler()
+    int getGoalProfileIndex() const { return m_goalProfileIndex; }
+
+    /// For use by solvers. A hash of the reference data (e.g., splines of a
+    /// reference table) that this goal caches in initializeOnModel(). The
+    /// properties of the goal do not capture reference data provided in
+    /// memory, so solvers use this hash to detect that the data changed.
+    /// This is 0 if the goal has no reference data.
+    std::size_t calcReferenceDataHash() const {
+        return calcReferenceDataHashImpl();
+    }
+
     /// Print the name type and mode of this goal. In cost mode, this prints the
     /// weight.
     void printDescription() const;
@@ -338,6 +386,9 @@ protected:
             const GoalInput& input, SimTK::Vector& goal) const = 0;
     /// Print a more detailed description unique to each goal.
     virtual void printDescriptionImpl() const {};
+    /// Override this if initializeOnModelImpl() caches reference data; see
+    /// calcReferenceDataHash().
+    virtual std::size_t calcReferenceDataHashImpl() const { return 0; }
     /// For use within virtual function implementations.
     const Model& getModel() const {
         OPENSIM_THROW_IF_FRMOBJ(!m_model, Exception,
@@ -377,6 +428,9 @@ private:
     mutable Mode m_modeToUse;
     mutable SimTK::Stage m_stageDependency = SimTK::Stage::Acceleration;
     mutable int m_numIntegrals = -1;
+    mutable SimTK::ReferencePtr<const SolverTimers> m_profiler;
+    mutable int m_integrandProfileIndex = -1;
+    mutable int m_goalProfileIndex = -1;
 };
 
 inline void MocoGoal::calcIntegrandImpl(
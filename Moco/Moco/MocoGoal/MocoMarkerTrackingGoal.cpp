@@ -41,6 +41,8 @@ void MocoMarkerTrackingGoal::initializeOnModelImpl(const Model& model) const {
             get_markers_reference().getMarkerTable().getColumnLabels());
 
     // Cache reference pointers to model markers.
+    m_model_markers.clear();
+    m_refindices.clear();
     const auto& markRefNames = get_markers_reference().getNames();
     const auto& markerSet = model.getMarkerSet();
     int iset = -1;
@@ -75,9 +77,16 @@ void MocoMarkerTrackingGoal::initializeOnModelImpl(const Model& model) const {
 
     // Get and flatten TimeSeriesTableVec3 to doubles and create a set of
     // reference splines, one for each component of the coordinate
-    // trajectories.
-    m_refsplines =
-            GCVSplineSet(get_markers_reference().getMarkerTable().flatten());
+    // trajectories of the tracked markers. We do not spline unused markers.
+    const auto flatTable = get_markers_reference().getMarkerTable().flatten();
+    const auto& flatLabels = flatTable.getColumnLabels();
+    std::vector<std::string> trackedLabels;
+    for (int refidx : m_refindices) {
+        for (int ic = 0; ic < 3; ++ic) {
+            trackedLabels.push_back(flatLabels[3 * refidx + ic]);
+        }
+    }
+    m_refsplines.fit(flatTable, trackedLabels);
 
     setRequirements(1, 1, SimTK::Stage::Position);
 }
@@ -96,9 +105,9 @@ void MocoMarkerTrackingGoal::calcIntegrandImpl(
         // Get the markers reference index corresponding to the current
         // model marker and get the reference value.
         int refidx = m_refindices[i];
-        refValue[0] = m_refsplines[3 * refidx].calcValue(timeVec);
-        refValue[1] = m_refsplines[3 * refidx + 1].calcValue(timeVec);
-        refValue[2] = m_refsplines[3 * refidx + 2].calcValue(timeVec);
+        refValue[0] = m_refsplines.calcValue(3 * i, timeVec);
+        refValue[1] = m_refsplines.calcValue(3 * i + 1, timeVec);
+        refValue[2] = m_refsplines.calcValue(3 * i + 2, timeVec);
 
         double distance = (modelValue - refValue).normSqr();
 
@@ -106,6 +115,10 @@ void MocoMarkerTrackingGoal::calcIntegrandImpl(
     }
 }
 
+std::size_t MocoMarkerTrackingGoal::calcReferenceDataHashImpl() const {
+    return m_refsplines.calcDataHash();
+}
+
 void MocoMarkerTrackingGoal::printDescriptionImpl() const {
     log_cout(
             "        allow unused references: ", get_allow_unused_references());
@@ -20,7 +20,6 @@
 
 #include "MocoGoal.h"
 
-#include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 #include <OpenSim/Simulation/MarkersReference.h>
 
@@ -79,6 +78,7 @@ protected:
         cost[0] = input.integral;
     }
     void printDescriptionImpl() const override;
+    std::size_t calcReferenceDataHashImpl() const override;
 
     OpenSim_DECLARE_PROPERTY(markers_reference, MarkersReference,
             "MarkersReference object containing the marker trajectories to be "
@@ -91,7 +91,9 @@ protected:
             "Allow markers_reference to contain marker data for a marker "
             "not in the model (such data would be ignored). Default: false.");
 
-    mutable GCVSplineSet m_refsplines;
+    // Copies of this goal (e.g., one per thread in a solver) share the
+    // splines.
+    mutable SharedReferenceSplines m_refsplines;
     mutable std::vector<SimTK::ReferencePtr<const Marker>> m_model_markers;
     mutable std::vector<int> m_refindices;
     mutable SimTK::Array_<double> m_marker_weights;
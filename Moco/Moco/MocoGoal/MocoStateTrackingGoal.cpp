@@ -29,10 +29,9 @@ void MocoStateTrackingGoal::initializeOnModelImpl(const Model& model) const {
     // TODO: set relativeToDirectory properly.
     TimeSeriesTable tableToUse = get_reference().process("", &model);
 
-    auto allSplines = GCVSplineSet(tableToUse);
-
     // Check that there are no redundant columns in the reference data.
-    checkRedundantLabels(tableToUse.getColumnLabels());
+    const auto& refNames = tableToUse.getColumnLabels();
+    checkRedundantLabels(refNames);
 
     // Throw exception if a weight is specified for a nonexistent state.
     auto allSysYIndices = createSystemYIndexMap(model);
@@ -62,8 +61,10 @@ void MocoStateTrackingGoal::initializeOnModelImpl(const Model& model) const {
     // Populate member variables needed to compute cost. Unless the property
     // allow_unused_references is set to true, an exception is thrown for
     // names in the references that don't correspond to a state variable.
-    for (int iref = 0; iref < allSplines.getSize(); ++iref) {
-        const auto& refName = allSplines[iref].getName();
+    m_sysYIndices.clear();
+    m_state_weights.clear();
+    m_state_names.clear();
+    for (const auto& refName : refNames) {
         if (allSysYIndices.count(refName) == 0) {
             if (get_allow_unused_references()) {
                 continue;
@@ -93,9 +94,10 @@ void MocoStateTrackingGoal::initializeOnModelImpl(const Model& model) const {
             refWeight *= 1.0 / refRange;
         }
         m_state_weights.push_back(refWeight);
-        m_refsplines.cloneAndAppend(allSplines[iref]);
         m_state_names.push_back(refName);
     }
+    // Only spline the references that are tracked.
+    m_refsplines.fit(tableToUse, m_state_names);
 
     setRequirements(1, 1, SimTK::Stage::Time);
 }
@@ -109,9 +111,9 @@ void MocoStateTrackingGoal::calcIntegrandImpl(
     // TODO cache the reference coordinate values at the mesh points, rather
     // than evaluating the spline.
     integrand = 0;
-    for (int iref = 0; iref < m_refsplines.getSize(); ++iref) {
+    for (int iref = 0; iref < m_refsplines.getNumSplines(); ++iref) {
         const auto& modelValue = input.state.getY()[m_sysYIndices[iref]];
-        const auto& refValue = m_refsplines[iref].calcValue(timeVec);
+        const auto& refValue = m_refsplines.calcValue(iref, timeVec);
         integrand += m_state_weights[iref] * pow(modelValue - refValue, 2);
     }
 }
@@ -22,7 +22,6 @@
 #include "../MocoWeightSet.h"
 #include "MocoGoal.h"
 
-#include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 
 namespace OpenSim {
@@ -123,6 +122,9 @@ protected:
         cost[0] = input.integral;
     }
     void printDescriptionImpl() const override;
+    std::size_t calcReferenceDataHashImpl() const override {
+        return m_refsplines.calcDataHash();
+    }
 
 private:
     OpenSim_DECLARE_PROPERTY(reference, TableProcessor,
@@ -157,7 +159,9 @@ private:
         constructProperty_scale_weights_with_range(false);
     }
 
-    mutable GCVSplineSet m_refsplines;
+    // Copies of this goal (e.g., one per thread in a solver) share the
+    // splines.
+    mutable SharedReferenceSplines m_refsplines;
     /// The indices in Y corresponding to the provided reference coordinates.
     mutable std::vector<int> m_sysYIndices;
     mutable std::vector<double> m_state_weights;
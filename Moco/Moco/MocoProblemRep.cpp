@@ -33,6 +33,11 @@ MocoProblemRep::MocoProblemRep(const MocoProblem& problem)
         : m_problem(&problem) {
     initialize();
 }
+MocoProblemRep::MocoProblemRep(const MocoProblem& problem,
+        std::shared_ptr<const Model> processedModel)
+        : m_problem(&problem), m_model_processed(std::move(processedModel)) {
+    initialize();
+}
 void MocoProblemRep::initialize() {
 
     // Clear member variables.
@@ -46,6 +51,8 @@ void MocoProblemRep::initialize() {
     m_state_infos.clear();
     m_control_infos.clear();
     m_parameters.clear();
+    m_applied_parameter_values.resize(0);
+    m_applied_parameters_with_initsystem = false;
     m_costs.clear();
     m_endpoint_constraints.clear();
     m_path_constraints.clear();
@@ -62,7 +69,11 @@ void MocoProblemRep::initialize() {
 
     const auto& ph0 = m_problem->getPhase(0);
     // TODO: Provide directory from which to load model file.
-    m_model_base = ph0.getModelProcessor().process();
+    if (!m_model_processed) {
+        m_model_processed = std::make_shared<const Model>(
+                ph0.getModelProcessor().process());
+    }
+    m_model_base = Model(*m_model_processed);
 
     auto discreteControllerBaseUPtr = make_unique<DiscreteController>();
     m_discrete_controller_base.reset(discreteControllerBaseUPtr.get());
@@ -605,6 +616,21 @@ std::vector<std::string> MocoProblemRep::createParameterNames() const {
     }
     return names;
 }
+void MocoProblemRep::addProfilerSections(SolverTimers& profiler) const {
+    for (const auto& cost : m_costs) cost->addProfilerSections(profiler);
+    for (const auto& endpoint_constraint : m_endpoint_constraints) {
+        endpoint_constraint->addProfilerSections(profiler);
+    }
+    for (const auto& pc : m_path_constraints) pc->addProfilerSections(profiler);
+}
+void MocoProblemRep::setProfiler(const SolverTimers* profiler) const {
+    for (const auto& cost : m_costs) cost->setProfiler(profiler);
+    for (const auto& endpoint_constraint : m_endpoint_constraints) {
+        endpoint_constraint->setProfiler(profiler);
+    }
+    for (const auto& pc : m_path_constraints) pc->setProfiler(profiler);
+}
+
 std::vector<std::string> MocoProblemRep::createCostNames() const {
     std::vector<std::string> names(m_costs.size());
     int i = 0;
@@ -719,6 +745,18 @@ void MocoProblemRep::applyParametersToModelProperties(
             "There are {} parameters in this MocoProblem, but {} values were "
             "provided.",
             m_parameters.size(), parameterValues.size());
+    if (m_applied_parameter_values.size() == parameterValues.size() &&
+            (m_applied_parameters_with_initsystem ||
+                    !initSystemAndDisableConstraints)) {
+        bool unchanged = true;
+        for (int i = 0; i < parameterValues.size(); ++i) {
+            if (m_applied_parameter_values[i] != parameterValues[i]) {
+                unchanged = false;
+                break;
+            }
+        }
+        if (unchanged) return;
+    }
     for (int i = 0; i < (int)m_parameters.size(); ++i) {
         m_parameters[i]->applyParameterToModelProperties(parameterValues(i));
     }
@@ -767,7 +805,17 @@ void MocoProblemRep::applyParametersToModelProperties(
                 }
             }
         }
+    } else {
+        // The states may hold cache entries (e.g., muscle-tendon lengths)
+        // computed with the previous parameter values, and solvers may not
+        // update the time and coordinates if they are unchanged.
+        m_state_base.invalidateAllCacheAtOrAbove(SimTK::Stage::Time);
+        for (auto& stateDisCon : m_state_disabled_constraints) {
+            stateDisCon.invalidateAllCacheAtOrAbove(SimTK::Stage::Time);
+        }
     }
+    m_applied_parameter_values = parameterValues;
+    m_applied_parameters_with_initsystem = initSystemAndDisableConstraints;
 }
 
 void MocoProblemRep::printDescription() const {
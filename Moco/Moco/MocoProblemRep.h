@@ -30,6 +30,7 @@
 namespace OpenSim {
 
 class MocoProblem;
+class MocoSolver;
 class DiscreteController;
 class DiscreteForces;
 class PositionMotion;
@@ -49,11 +50,13 @@ public:
     MocoProblemRep(const MocoProblemRep&) = delete;
     MocoProblemRep& operator=(const MocoProblemRep&) = delete;
     MocoProblemRep(MocoProblemRep&& source)
-            : m_problem(std::move(source.m_problem)) {
+            : m_problem(std::move(source.m_problem)),
+              m_model_processed(std::move(source.m_model_processed)) {
         if (m_problem) initialize();
     }
     MocoProblemRep& operator=(MocoProblemRep&& source) {
         m_problem = std::move(source.m_problem);
+        m_model_processed = std::move(source.m_model_processed);
         if (m_problem) initialize();
         return *this;
     }
@@ -238,7 +241,9 @@ public:
     /// by users for debugging.
     /// @{
     /// Calculate the errors in all the scalar path constraint equations in this
-    /// phase.
+    /// phase. If the path constraints are being profiled (see setProfiler()),
+    /// the profile of each path constraint covers only computing its errors,
+    /// as the state is shared by all path constraints.
     void calcPathConstraintErrors(
             const SimTK::State& state, SimTK::Vector& errors) const {
 
@@ -250,9 +255,20 @@ public:
                 "MocoProblem.");
 
         for (const auto& pc : m_path_constraints) {
+            SolverTimers::ScopedTimer timer(
+                    pc->getProfiler(), pc->getProfileIndex());
             pc->calcPathConstraintErrors(state, errors);
         }
     }
+    /// Add the sections for profiling each goal and path constraint to the
+    /// provided timers. See MocoGoal::addProfilerSections() and
+    /// MocoPathConstraint::addProfilerSections(). This is not thread-safe.
+    void addProfilerSections(SolverTimers& profiler) const;
+    /// Profile each goal and path constraint with the provided timers, whose
+    /// sections were added with addProfilerSections(). See
+    /// MocoGoal::setProfiler() and MocoPathConstraint::setProfiler(). Pass
+    /// nullptr to stop profiling.
+    void setProfiler(const SolverTimers* profiler) const;
     /// Calculate the errors in all the scalar kinematic constraint equations in
     /// this phase. This may not be the most efficient solution for solvers, but
     /// is rather intended as a convenience method for a quick implementation or
@@ -287,6 +303,16 @@ public:
     /// model. You can pass `true` to have initSystem() called for you, and to
     /// also re-disable any constraints re-enabled by the initSystem() call
     /// (see getModelDisabledConstraints()).
+    ///
+    /// If the values are the same as those most recently applied (and
+    /// initSystem() was called then, if requested now), the models already
+    /// reflect these values and this method does nothing. Solvers apply the
+    /// parameters before every evaluation of the problem's functions, but the
+    /// parameter values change only when the optimizer perturbs them.
+    /// Otherwise, applying new values without initSystem() invalidates the
+    /// cache of the states held by this object (at and above
+    /// SimTK::Stage::Time), since cached quantities may depend on the
+    /// parameters.
     void applyParametersToModelProperties(const SimTK::Vector& parameterValues,
             bool initSystemAndDisableConstraints = false) const;
 
@@ -311,12 +337,21 @@ public:
 
 private:
     explicit MocoProblemRep(const MocoProblem& problem);
+    /// Copy the model from processedModel, which must have been obtained
+    /// from the problem's ModelProcessor, instead of processing the model.
+    MocoProblemRep(const MocoProblem& problem,
+            std::shared_ptr<const Model> processedModel);
     friend MocoProblem;
+    friend MocoSolver;
 
     void initialize();
 
     const MocoProblem* m_problem;
 
+    // The model from the problem's ModelProcessor. MocoSolver shares this
+    // model among the reps in its jar.
+    std::shared_ptr<const Model> m_model_processed;
+
     Model m_model_base;
     mutable SimTK::State m_state_base;
     SimTK::ReferencePtr<const DiscreteController> m_discrete_controller_base;
@@ -337,6 +372,10 @@ private:
     std::unordered_map<std::string, MocoVariableInfo> m_control_infos;
 
     std::vector<std::unique_ptr<MocoParameter>> m_parameters;
+    // The parameter values most recently applied to the models, and whether
+    // initSystem() was invoked after applying them.
+    mutable SimTK::Vector m_applied_parameter_values;
+    mutable bool m_applied_parameters_with_initsystem = false;
     std::vector<std::unique_ptr<MocoGoal>> m_costs;
     std::vector<std::unique_ptr<MocoGoal>> m_endpoint_constraints;
     std::vector<std::unique_ptr<MocoPathConstraint>> m_path_constraints;
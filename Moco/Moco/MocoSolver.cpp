@@ -88,20 +88,38 @@ MocoSolution MocoSolver::solve() const {
 void MocoSolver::setSolutionStats(MocoSolution& sol, bool success,
         double objective,
         const std::string& status, int numIterations, double duration,
-        std::vector<std::pair<std::string, double>> objectiveBreakdown) {
+        std::vector<std::pair<std::string, double>> objectiveBreakdown,
+        std::vector<MocoSolverTiming> timings) {
     sol.setSuccess(success);
     sol.setObjective(objective);
     sol.setStatus(status);
     sol.setNumIterations(numIterations);
     sol.setSolverDuration(duration);
     sol.setObjectiveBreakdown(std::move(objectiveBreakdown));
+    sol.setTimings(std::move(timings));
 }
 
 std::unique_ptr<ThreadsafeJar<const MocoProblemRep>>
         MocoSolver::createProblemRepJar(int size) const {
-    auto jar = OpenSim::make_unique<ThreadsafeJar<const MocoProblemRep>>();
-    for (int i = 0; i < size; ++i) {
-        jar->leave(std::unique_ptr<MocoProblemRep>(m_problem->createRepHeap()));
-    }
+    // The reps refer to the problem, so the factory keeps the copy of the
+    // problem alive.
+    std::shared_ptr<const MocoProblem> problem(m_problem->clone());
+    auto jar = OpenSim::make_unique<ThreadsafeJar<const MocoProblemRep>>(
+            [problem]() {
+                return std::unique_ptr<const MocoProblemRep>(
+                        problem->createRepHeap());
+            },
+            size);
+    auto first = jar->take();
+    // Additional reps copy the model that the first rep obtained from the
+    // ModelProcessor, so the model file is loaded and the ModelOperators are
+    // applied only once. Each rep still initializes its own models, since
+    // each model needs its own SimTK::System.
+    std::shared_ptr<const Model> processedModel = first->m_model_processed;
+    jar->setFactory([problem, processedModel]() {
+        return std::unique_ptr<const MocoProblemRep>(
+                new MocoProblemRep(*problem, processedModel));
+    });
+    jar->leave(std::move(first));
     return jar;
 }
@@ -99,13 +99,19 @@ protected:
             const std::string& status, int numIterations,
             double duration,
             std::vector<std::pair<std::string, double>> objectiveBreakdown =
-                    {});
+                    {},
+            std::vector<MocoSolverTiming> timings = {});
 
     const MocoProblemRep& getProblemRep() const {
         return m_problemRep;
     }
 
     /// Create a library of MocoProblemRep%s for use in parallelized code.
+    /// The jar initially contains one MocoProblemRep, and the jar creates
+    /// additional MocoProblemRep%s (up to `size`) only when all existing ones
+    /// are in use. These are created from a copy of the MocoProblem made now.
+    /// The model is processed (see ModelProcessor) only for the first
+    /// MocoProblemRep; the others copy the processed model.
     // TODO SWIG ignore.
     std::unique_ptr<ThreadsafeJar<const MocoProblemRep>>
     createProblemRepJar(int size) const;
@@ -22,7 +22,11 @@
 #include "MocoProblem.h"
 #include "MocoTropterSolver.h"
 #include "MocoUtilities.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <regex>
+#include <thread>
 
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Reporter.h>
@@ -100,6 +104,143 @@ MocoSolution MocoStudy::solve() const {
     return solution;
 }
 
+std::vector<MocoSolution> MocoStudy::solveMultiStart(int numStarts,
+        bool cancelStragglers, int cancelGracePeriod,
+        double cancelMargin) const {
+    OPENSIM_THROW_IF(numStarts < 1, Exception,
+            fmt::format("Expected numStarts to be at least 1, but got {}.",
+                    numStarts));
+    OPENSIM_THROW_IF(cancelGracePeriod < 0, Exception,
+            fmt::format("Expected cancelGracePeriod to be nonnegative, but "
+                        "got {}.",
+                    cancelGracePeriod));
+    OPENSIM_THROW_IF(cancelMargin < 0, Exception,
+            fmt::format("Expected cancelMargin to be nonnegative, but got {}.",
+                    cancelMargin));
+    const auto* casSolver =
+            dynamic_cast<const MocoCasADiSolver*>(&get_solver());
+    OPENSIM_THROW_IF(!casSolver, Exception,
+            "solveMultiStart() is only supported with MocoCasADiSolver.");
+
+    // Divide the threads among the starts; each start gets at least one.
+    const int numThreads = std::max(1, casSolver->getNumThreads());
+    const int numConcurrent = std::min(numStarts, numThreads);
+    const int numThreadsPerStart = std::max(1, numThreads / numConcurrent);
+    log_info("Solving {} starts, {} at a time, with {} thread(s) each.",
+            numStarts, numConcurrent, numThreadsPerStart);
+
+    // A start is cancelled only once its iterates are feasible (within the
+    // solver's constraint tolerance) and only after a grace period, since the
+    // objective of early or infeasible iterates says little about where a
+    // start will converge. It must also be worse than the best converged
+    // objective by a margin.
+    const double feasibilityTolerance =
+            casSolver->get_optim_constraint_tolerance() != -1
+                    ? casSolver->get_optim_constraint_tolerance()
+                    : 1e-4;
+
+    // The best objective among the starts that have converged.
+    std::atomic<double> bestObjective(SimTK::Infinity);
+    std::atomic<int> nextStart(0);
+    std::vector<std::unique_ptr<MocoSolution>> solutions(numStarts);
+    std::vector<double> objectives(numStarts, SimTK::NaN);
+    std::vector<std::string> errors(numStarts);
+    std::mutex copyMutex;
+
+    auto work = [&]() {
+        int istart;
+        while ((istart = nextStart++) < numStarts) {
+            // Each start solves its own copy of the problem, since the solver
+            // initializes (and may modify) the problem it is given.
+            std::unique_ptr<MocoProblem> problem;
+            std::unique_ptr<MocoCasADiSolver> solver;
+            try {
+                {
+                    std::lock_guard<std::mutex> lock(copyMutex);
+                    problem.reset(get_problem().clone());
+                    solver.reset(casSolver->clone());
+                }
+                solver->resetProblem(*problem);
+                solver->set_parallel(numThreadsPerStart);
+                solver->set_verbosity(0);
+                if (cancelStragglers) {
+                    solver->setRequestStopFunction([&](double objective,
+                                                           double infeasibility,
+                                                           int iteration) {
+                        if (iteration < cancelGracePeriod ||
+                                infeasibility > feasibilityTolerance) {
+                            return false;
+                        }
+                        const double best = bestObjective.load();
+                        const double margin =
+                                cancelMargin * std::max(1.0, std::abs(best));
+                        return objective > best + margin;
+                    });
+                }
+                solver->setGuess(solver->createRandomGuess(istart));
+                auto solution = make_unique<MocoSolution>(solver->solve());
+                // Failed solutions are sealed; peek at the objective anyway.
+                const bool originallySealed = solution->isSealed();
+                solution->unseal();
+                const double objective = solution->getObjective();
+                if (originallySealed) solution->seal();
+                if (solution->success()) {
+                    double best = bestObjective.load();
+                    while (objective < best &&
+                            !bestObjective.compare_exchange_weak(
+                                    best, objective)) {}
+                }
+                objectives[istart] = objective;
+                solutions[istart] = std::move(solution);
+            } catch (const std::exception& ex) {
+                errors[istart] = ex.what();
+            }
+        }
+    };
+
+    // The logger level is process-wide, so it is set once here rather than
+    // by each start; see MocoCasADiSolver::solveImpl(). The starts are
+    // reported once they have all finished.
+    const Logger::Level origLoggerLevel = Logger::getLevel();
+    Logger::setLevel(Logger::Level::Warn);
+    std::vector<std::thread> threads;
+    try {
+        for (int ithread = 1; ithread < numConcurrent; ++ithread) {
+            threads.emplace_back(work);
+        }
+        work();
+    } catch (...) {
+        for (auto& thread : threads) thread.join();
+        Logger::setLevel(origLoggerLevel);
+        throw;
+    }
+    for (auto& thread : threads) thread.join();
+    Logger::setLevel(origLoggerLevel);
+
+    for (int istart = 0; istart < numStarts; ++istart) {
+        if (solutions[istart]) {
+            log_info("Start {}: {} (objective: {}).", istart,
+                    solutions[istart]->getStatus(), objectives[istart]);
+        } else {
+            log_warn("Start {} failed: {}", istart, errors[istart]);
+        }
+    }
+
+    std::vector<int> order;
+    for (int istart = 0; istart < numStarts; ++istart) {
+        if (solutions[istart]) order.push_back(istart);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        if (solutions[a]->success() != solutions[b]->success()) {
+            return solutions[a]->success();
+        }
+        return objectives[a] < objectives[b];
+    });
+    std::vector<MocoSolution> result;
+    for (int istart : order) result.push_back(std::move(*solutions[istart]));
+    return result;
+}
+
 void MocoStudy::visualize(const MocoTrajectory& it) const {
     // TODO this does not need the Solver at all, so this could be moved to
     // MocoProblem.
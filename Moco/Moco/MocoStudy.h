@@ -122,6 +122,31 @@ public:
     /// hold.
     MocoSolution solve() const;
 
+    /// Solve the problem multiple times from different random initial guesses
+    /// and return the solutions, ordered such that successful solutions come
+    /// first, sorted by increasing objective. Use this for problems with
+    /// multiple local minima. The starts are run concurrently: the threads
+    /// allotted by the solver's `parallel` setting (or the
+    /// OPENSIM_MOCO_PARALLEL environment variable) are divided among the
+    /// starts. If `cancelStragglers` is true, a start is stopped early
+    /// (unsuccessfully) once, after at least `cancelGracePeriod` iterations,
+    /// a feasible iterate (within the solver's constraint tolerance) has an
+    /// objective worse than the best objective among the starts that have
+    /// already converged by more than `cancelMargin` times the magnitude of
+    /// the best objective (or by more than `cancelMargin`, if the magnitude is
+    /// less than 1). By default, the grace period is 20 iterations and the
+    /// margin is 10%. This saves time but means that unsuccessful solutions
+    /// may not have run to completion, and that the result depends on the
+    /// order in which the starts converge.
+    /// The guess for start i is created by MocoCasADiSolver::createRandomGuess()
+    /// with seed i. Starts that throw an exception are omitted from the
+    /// returned solutions. Solutions are not written to disk, regardless of the
+    /// write_solution property. The logger level is set to Warn while solving.
+    /// This is only supported with MocoCasADiSolver.
+    std::vector<MocoSolution> solveMultiStart(int numStarts,
+            bool cancelStragglers = false, int cancelGracePeriod = 20,
+            double cancelMargin = 0.1) const;
+
     /// Interactively visualize a trajectory using the simbody-visualizer. The
     /// trajectory could be an initial guess, a solution, etc.
     /// @precondition
@@ -24,6 +24,9 @@
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <cstdint>
+#include <fstream>
+
 using namespace OpenSim;
 
 const std::vector<std::string> MocoTrajectory::m_allowedKeys =
@@ -659,7 +662,284 @@ void MocoTrajectory::resample(SimTK::Vector time) {
     }
 }
 
+namespace {
+// Binary columnar trajectory files; see MocoTrajectory::write() for the
+// layout. All integers are 64-bit unsigned and all numbers are stored in the
+// byte order of the machine that wrote the file.
+const char binaryTrajectoryMagic[8] = {'O', 'S', 'I', 'M', 'T', 'R', 'A', 'J'};
+const std::uint32_t binaryTrajectoryVersion = 1;
+const std::uint32_t binaryTrajectoryByteOrderMark = 0x01020304;
+const std::uint64_t binaryTrajectoryAlignment = 64;
+
+bool hasBinaryTrajectoryExtension(const std::string& filepath) {
+    const std::string ext = ".traj";
+    return filepath.size() >= ext.size() &&
+           filepath.compare(filepath.size() - ext.size(), ext.size(), ext) ==
+                   0;
+}
+
+bool isBinaryTrajectoryFile(const std::string& filepath) {
+    std::ifstream f(filepath, std::ios::binary);
+    char magic[sizeof(binaryTrajectoryMagic)];
+    return f.read(magic, sizeof(magic)) &&
+           std::equal(magic, magic + sizeof(magic), binaryTrajectoryMagic);
+}
+
+std::uint64_t alignBinaryTrajectoryOffset(std::uint64_t offset) {
+    return (offset + binaryTrajectoryAlignment - 1) /
+           binaryTrajectoryAlignment * binaryTrajectoryAlignment;
+}
+
+struct BinaryTrajectoryBlock {
+    std::string name;
+    std::vector<std::string> labels;
+    std::uint64_t numRows = 0;
+    // Absolute position of the column-major data in the file.
+    std::uint64_t offset = 0;
+    // Only used for writing.
+    const double* data = nullptr;
+};
+
+void appendToHeader(std::string& header, std::uint64_t value) {
+    header.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void appendToHeader(std::string& header, const std::string& value) {
+    appendToHeader(header, (std::uint64_t)value.size());
+    header.append(value);
+}
+
+void writeBinaryTrajectory(const std::string& filepath,
+        const std::vector<std::pair<std::string, std::string>>& metadata,
+        std::vector<BinaryTrajectoryBlock> blocks) {
+    std::string header(binaryTrajectoryMagic, sizeof(binaryTrajectoryMagic));
+    header.append(reinterpret_cast<const char*>(&binaryTrajectoryVersion),
+            sizeof(binaryTrajectoryVersion));
+    header.append(reinterpret_cast<const char*>(&binaryTrajectoryByteOrderMark),
+            sizeof(binaryTrajectoryByteOrderMark));
+    appendToHeader(header, (std::uint64_t)metadata.size());
+    for (const auto& entry : metadata) {
+        appendToHeader(header, entry.first);
+        appendToHeader(header, entry.second);
+    }
+    appendToHeader(header, (std::uint64_t)blocks.size());
+    // The data offsets are filled in once the size of the header is known.
+    std::vector<std::size_t> offsetPositions;
+    for (const auto& block : blocks) {
+        appendToHeader(header, block.name);
+        appendToHeader(header, block.numRows);
+        appendToHeader(header, (std::uint64_t)block.labels.size());
+        offsetPositions.push_back(header.size());
+        appendToHeader(header, (std::uint64_t)0);
+        for (const auto& label : block.labels) appendToHeader(header, label);
+    }
+    std::uint64_t offset = alignBinaryTrajectoryOffset(header.size());
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        blocks[i].offset = offset;
+        std::copy_n(reinterpret_cast<const char*>(&offset), sizeof(offset),
+                &header[offsetPositions[i]]);
+        offset = alignBinaryTrajectoryOffset(offset +
+                sizeof(double) * blocks[i].numRows * blocks[i].labels.size());
+    }
+
+    std::ofstream f(filepath, std::ios::binary);
+    OPENSIM_THROW_IF(!f, Exception, "Could not open '{}' for writing.",
+            filepath);
+    f.write(header.data(), header.size());
+    std::uint64_t position = header.size();
+    const std::vector<char> padding(binaryTrajectoryAlignment, 0);
+    for (const auto& block : blocks) {
+        f.write(padding.data(), block.offset - position);
+        const std::uint64_t numBytes =
+                sizeof(double) * block.numRows * block.labels.size();
+        if (numBytes) {
+            f.write(reinterpret_cast<const char*>(block.data), numBytes);
+        }
+        position = block.offset + numBytes;
+    }
+    OPENSIM_THROW_IF(!f, Exception, "Error while writing '{}'.", filepath);
+}
+
+/// Reads the header of a binary trajectory file and leaves the data in the
+/// file to be read with readBinaryTrajectoryBlock().
+class BinaryTrajectoryReader {
+public:
+    explicit BinaryTrajectoryReader(const std::string& filepath)
+            : m_filepath(filepath),
+              m_file(filepath, std::ios::binary | std::ios::ate) {
+        OPENSIM_THROW_IF(!m_file, Exception, "Could not read '{}'.", filepath);
+        m_fileSize = (std::uint64_t)m_file.tellg();
+        m_file.seekg(0);
+
+        char magic[sizeof(binaryTrajectoryMagic)];
+        std::uint32_t version;
+        std::uint32_t byteOrderMark;
+        read(magic, sizeof(magic));
+        read(&version, sizeof(version));
+        read(&byteOrderMark, sizeof(byteOrderMark));
+        OPENSIM_THROW_IF(!std::equal(magic, magic + sizeof(magic),
+                                 binaryTrajectoryMagic),
+                Exception, "'{}' is not a binary trajectory file.", filepath);
+        OPENSIM_THROW_IF(byteOrderMark != binaryTrajectoryByteOrderMark,
+                Exception,
+                "'{}' was written on a machine with a different byte order.",
+                filepath);
+        OPENSIM_THROW_IF(version > binaryTrajectoryVersion, Exception,
+                "'{}' has version {}, but only versions up to {} are "
+                "supported.",
+                filepath, version, binaryTrajectoryVersion);
+
+        const std::uint64_t numMetadata = readUInt64();
+        for (std::uint64_t i = 0; i < numMetadata; ++i) {
+            std::string key = readString();
+            metadata[key] = readString();
+        }
+        const std::uint64_t numBlocks = readUInt64();
+        for (std::uint64_t i = 0; i < numBlocks; ++i) {
+            BinaryTrajectoryBlock block;
+            block.name = readString();
+            block.numRows = readUInt64();
+            const std::uint64_t numColumns = readUInt64();
+            block.offset = readUInt64();
+            for (std::uint64_t icol = 0; icol < numColumns; ++icol) {
+                block.labels.push_back(readString());
+            }
+            OPENSIM_THROW_IF(block.offset + sizeof(double) * block.numRows *
+                                                    numColumns >
+                                     m_fileSize,
+                    Exception, "Block '{}' of '{}' is truncated.", block.name,
+                    filepath);
+            blocks[block.name] = std::move(block);
+        }
+    }
+
+    /// Read the data of a block into `out`, which must have room for
+    /// numRows * labels.size() elements.
+    void readBlock(const BinaryTrajectoryBlock& block, double* out) {
+        const std::uint64_t numBytes =
+                sizeof(double) * block.numRows * block.labels.size();
+        if (!numBytes) return;
+        m_file.seekg(block.offset);
+        read(out, numBytes);
+    }
+
+    std::map<std::string, std::string> metadata;
+    std::map<std::string, BinaryTrajectoryBlock> blocks;
+
+private:
+    void read(void* out, std::uint64_t numBytes) {
+        m_file.read(reinterpret_cast<char*>(out), numBytes);
+        OPENSIM_THROW_IF(!m_file, Exception, "Unexpected end of file '{}'.",
+                m_filepath);
+    }
+    std::uint64_t readUInt64() {
+        std::uint64_t value;
+        read(&value, sizeof(value));
+        return value;
+    }
+    std::string readString() {
+        const std::uint64_t size = readUInt64();
+        OPENSIM_THROW_IF(size > m_fileSize, Exception,
+                "Invalid string length in '{}'.", m_filepath);
+        std::string value(size, '\0');
+        if (size) read(&value[0], size);
+        return value;
+    }
+    std::string m_filepath;
+    std::ifstream m_file;
+    std::uint64_t m_fileSize = 0;
+};
+
+} // anonymous namespace
+
+void MocoTrajectory::readBinary(const std::string& filepath) {
+    BinaryTrajectoryReader reader(filepath);
+    const auto timeBlock = reader.blocks.find("time");
+    OPENSIM_THROW_IF(timeBlock == reader.blocks.end() ||
+                             timeBlock->second.labels.size() != 1,
+            Exception, "Expected a 'time' column in '{}'.", filepath);
+    const int numTimes = (int)timeBlock->second.numRows;
+    m_time.resize(numTimes);
+    reader.readBlock(timeBlock->second, m_time.updContiguousScalarData());
+
+    const auto readMatrix = [&](const std::string& name,
+                                    std::vector<std::string>& names,
+                                    SimTK::Matrix& matrix) {
+        const auto it = reader.blocks.find(name);
+        if (it == reader.blocks.end()) {
+            matrix.resize(numTimes, 0);
+            return;
+        }
+        const auto& block = it->second;
+        OPENSIM_THROW_IF((int)block.numRows != numTimes, Exception,
+                "In '{}', expected {} rows for '{}' but got {}.", filepath,
+                numTimes, name, block.numRows);
+        names = block.labels;
+        matrix.resize(numTimes, (int)names.size());
+        reader.readBlock(block, matrix.updContiguousScalarData());
+    };
+    readMatrix("states", m_state_names, m_states);
+    readMatrix("controls", m_control_names, m_controls);
+    readMatrix("multipliers", m_multiplier_names, m_multipliers);
+    readMatrix("derivatives", m_derivative_names, m_derivatives);
+    readMatrix("slacks", m_slack_names, m_slacks);
+
+    const auto paramBlock = reader.blocks.find("parameters");
+    if (paramBlock != reader.blocks.end()) {
+        OPENSIM_THROW_IF(paramBlock->second.numRows != 1, Exception,
+                "In '{}', expected 1 row for 'parameters' but got {}.",
+                filepath, paramBlock->second.numRows);
+        m_parameter_names = paramBlock->second.labels;
+        m_parameters.resize((int)m_parameter_names.size());
+        reader.readBlock(
+                paramBlock->second, m_parameters.updContiguousScalarData());
+    }
+}
+
+void MocoTrajectory::writeBinary(const std::string& filepath) const {
+    // Only the metadata of MocoSolution is needed from the table.
+    TimeSeriesTable metadataTable;
+    convertToTableImpl(metadataTable);
+    std::vector<std::pair<std::string, std::string>> metadata;
+    const auto& tableMetadata = metadataTable.getTableMetaData();
+    for (const auto& key : tableMetadata.getKeys()) {
+        metadata.emplace_back(key,
+                tableMetadata.getValueForKey(key).getValue<std::string>());
+    }
+
+    const auto numTimes = (std::uint64_t)m_time.size();
+    std::vector<BinaryTrajectoryBlock> blocks;
+    const auto addBlock = [&](const std::string& name,
+                                  const std::vector<std::string>& names,
+                                  std::uint64_t numRows, const double* data) {
+        BinaryTrajectoryBlock block;
+        block.name = name;
+        block.labels = names;
+        block.numRows = numRows;
+        block.data = data;
+        blocks.push_back(std::move(block));
+    };
+    addBlock("time", {"time"}, numTimes, m_time.getContiguousScalarData());
+    addBlock("states", m_state_names, numTimes,
+            m_states.getContiguousScalarData());
+    addBlock("controls", m_control_names, numTimes,
+            m_controls.getContiguousScalarData());
+    addBlock("multipliers", m_multiplier_names, numTimes,
+            m_multipliers.getContiguousScalarData());
+    addBlock("derivatives", m_derivative_names, numTimes,
+            m_derivatives.getContiguousScalarData());
+    addBlock("slacks", m_slack_names, numTimes,
+            m_slacks.getContiguousScalarData());
+    addBlock("parameters", m_parameter_names, 1,
+            m_parameters.getContiguousScalarData());
+    writeBinaryTrajectory(filepath, metadata, std::move(blocks));
+}
+
 MocoTrajectory::MocoTrajectory(const std::string& filepath) {
+    if (isBinaryTrajectoryFile(filepath)) {
+        readBinary(filepath);
+        return;
+    }
     TimeSeriesTable table(filepath);
     const auto& metadata = table.getTableMetaData();
     // TODO: bug with file adapters.
@@ -779,6 +1059,10 @@ MocoTrajectory::MocoTrajectory(const std::string& filepath) {
 
 void MocoTrajectory::write(const std::string& filepath) const {
     ensureUnsealed();
+    if (hasBinaryTrajectoryExtension(filepath)) {
+        writeBinary(filepath);
+        return;
+    }
     TimeSeriesTable table0 = convertToTable();
     DataAdapter::InputTables tables = {{"table", &table0}};
     FileAdapter::writeFile(tables, filepath);
@@ -1384,6 +1668,57 @@ void MocoSolution::printObjectiveBreakdown() const {
     }
 }
 
+std::vector<std::string> MocoSolution::getTimingNames() const {
+    ensureUnsealed();
+    std::vector<std::string> names;
+    for (const auto& timing : m_timings) names.push_back(timing.name);
+    return names;
+}
+
+long long MocoSolution::getTimingNumEvaluations(
+        const std::string& name) const {
+    ensureUnsealed();
+    for (const auto& timing : m_timings) {
+        if (timing.name == name) return timing.numEvaluations;
+    }
+    OPENSIM_THROW(Exception, "Timing with name '{}' not found.", name);
+}
+
+double MocoSolution::getTimingDuration(const std::string& name) const {
+    ensureUnsealed();
+    for (const auto& timing : m_timings) {
+        if (timing.name == name) return timing.duration;
+    }
+    OPENSIM_THROW(Exception, "Timing with name '{}' not found.", name);
+}
+
+SimTK::Stage MocoSolution::getTimingMaxStage(const std::string& name) const {
+    ensureUnsealed();
+    for (const auto& timing : m_timings) {
+        if (timing.name == name) return timing.maxStage;
+    }
+    OPENSIM_THROW(Exception, "Timing with name '{}' not found.", name);
+}
+
+void MocoSolution::printTimingBreakdown() const {
+    ensureUnsealed();
+    if (m_timings.empty()) {
+        log_cout("No timings available");
+        return;
+    }
+    log_cout("Breakdown of solver time:");
+    for (const auto& timing : m_timings) {
+        if (timing.maxStage > SimTK::Stage::Empty) {
+            log_cout("  {}: {} evaluation(s), {:.4f} s, realized to {}",
+                    timing.name, timing.numEvaluations, timing.duration,
+                    timing.maxStage.getName());
+        } else {
+            log_cout("  {}: {} evaluation(s), {:.4f} s", timing.name,
+                    timing.numEvaluations, timing.duration);
+        }
+    }
+}
+
 void MocoSolution::convertToTableImpl(TimeSeriesTable& table) const {
     std::string success = m_success ? "true" : "false";
     table.updTableMetaData().setValueForKey("success", success);
@@ -40,6 +40,17 @@ public:
     }
 };
 
+/// The number of evaluations of, and the total real (clock) time in seconds
+/// spent in, a part of a solve. See MocoSolution::getTimingNames().
+struct MocoSolverTiming {
+    std::string name;
+    long long numEvaluations = 0;
+    double duration = 0;
+    /// The highest stage to which this part realized the state, if the solver
+    /// recorded it; otherwise, SimTK::Stage::Empty.
+    SimTK::Stage maxStage = SimTK::Stage::Empty;
+};
+
 /** The values of the variables in an optimal control problem.
 This can be used for specifying an initial guess, or holding the solution
 returned by a solver.
@@ -80,6 +91,28 @@ Column labels starting with "lambda" are Lagrange multipliers, and columns
 starting with "gamma" are slack variables (probably velocity corrections at
 certain collocation points).
 
+@par Binary format
+If the file name passed to write() ends with ".traj", the trajectory is
+written in a binary columnar format instead, which is much smaller and faster
+to read and write than text. The constructor that takes a file path detects
+this format automatically. The file contains, in order (integers are 64-bit
+unsigned and all numbers use the byte order of the machine that wrote the
+file):
+- the 8 characters "OSIMTRAJ", a 32-bit version (1), and the 32-bit byte
+  order mark 0x01020304;
+- the number of metadata entries, followed by each key and value
+  (MocoSolution writes its success, status, objective, etc. here);
+- the number of blocks, followed by, for each block, its name ("time",
+  "states", "controls", "multipliers", "derivatives", "slacks", or
+  "parameters"), its number of rows, its number of columns, the absolute
+  offset of its data in the file, and its column labels.
+Strings are stored as their length followed by their characters. The data of
+each block starts at an offset that is a multiple of 64 bytes and is stored as
+doubles in column-major order, so each block can be memory-mapped directly
+(e.g., with `numpy.memmap(path, dtype='f8', offset=offset,
+shape=(num_rows, num_columns), order='F')`). The parameters block has a
+single row.
+
 @par Matlab and Python
 Many of the functions in this class have variants ending with "Mat" that
 provide convenient access to the data directly in Matlab or Python (NumPy).
@@ -146,8 +179,8 @@ public:
                     continuousVars,
             const NamesAndData<SimTK::RowVector>& parameters = {});
 #endif
-    /// Read a MocoTrajectory from a data file (e.g., STO, CSV). See output of
-    /// write() for the correct format.
+    /// Read a MocoTrajectory from a data file (e.g., STO, CSV, or the binary
+    /// ".traj" format). See output of write() for the correct format.
     explicit MocoTrajectory(const std::string& filepath);
 
     virtual ~MocoTrajectory() = default;
@@ -583,7 +616,8 @@ public:
     /// @name Convert to other formats
     /// @{
 
-    /// Save the trajectory to file(s). Use a ".sto" file extension.
+    /// Save the trajectory to file(s). Use a ".sto" file extension, or
+    /// ".traj" for the binary columnar format described above.
     void write(const std::string& filepath) const;
 
     /// The Storage can be used in the OpenSim GUI to visualize a motion, or
@@ -684,6 +718,8 @@ protected:
 private:
     TimeSeriesTable convertToTable() const;
     virtual void convertToTableImpl(TimeSeriesTable&) const {}
+    void readBinary(const std::string& filepath);
+    void writeBinary(const std::string& filepath) const;
     double compareContinuousVariablesRMSInternal(const MocoTrajectory& other,
             std::vector<std::string> stateNames = {},
             std::vector<std::string> controlNames = {},
@@ -801,6 +837,39 @@ public:
     void printObjectiveBreakdown() const;
     /// @}
 
+    /// @name Breakdown of solver time
+    /// Solvers record the number of evaluations of, and the real time spent
+    /// in, the parts of a solve: for example, creating the optimization
+    /// problem, detecting sparsity, evaluating the dynamics and each goal, and
+    /// computing derivatives. The names of the parts depend on the solver.
+    /// Evaluations performed in parallel are all counted, so the times of
+    /// different parts may sum to more than getSolverDuration().
+    /// @{
+
+    /// Returns the number of parts for which the solver recorded timings. If
+    /// the solver did not provide this breakdown, then this returns 0.
+    int getNumTimings() const {
+        ensureUnsealed();
+        return (int)m_timings.size();
+    }
+    /// Get the names of the parts for which the solver recorded timings.
+    std::vector<std::string> getTimingNames() const;
+    /// Get the number of evaluations of a part of the solve. See
+    /// getTimingNames().
+    long long getTimingNumEvaluations(const std::string& name) const;
+    /// Get the total real (clock) time spent in a part of the solve. See
+    /// getTimingNames(). Units: seconds.
+    double getTimingDuration(const std::string& name) const;
+    /// Get the highest stage to which a part of the solve realized the state.
+    /// This is recorded for goals and path constraints if the solver's
+    /// `profile_goals` property is enabled; otherwise, this returns
+    /// SimTK::Stage::Empty. See getTimingNames().
+    SimTK::Stage getTimingMaxStage(const std::string& name) const;
+    /// Print to the console the number of evaluations of, and time spent in,
+    /// each part of the solve.
+    void printTimingBreakdown() const;
+    /// @}
+
     /// @name Access control
     /// @{
 
@@ -842,6 +911,9 @@ private:
         m_numIterations = numIterations;
     };
     void setSolverDuration(double duration) { m_solverDuration = duration; }
+    void setTimings(std::vector<MocoSolverTiming> timings) {
+        m_timings = std::move(timings);
+    }
     void convertToTableImpl(TimeSeriesTable&) const override;
     bool m_success = true;
     double m_objective = -1;
@@ -849,6 +921,7 @@ private:
     std::string m_status;
     int m_numIterations = -1;
     double m_solverDuration = -1;
+    std::vector<MocoSolverTiming> m_timings;
     // Allow solvers to set success, status, and construct a solution.
     friend class MocoSolver;
 };
@@ -331,16 +331,20 @@ MocoSolution MocoTropterSolver::solveImpl() const {
     tropter::Iterate tropIterate = ocp->convertToTropterIterate(guess);
 
     // Temporarily disable printing of negative muscle force warnings so the
-    // output stream isn't flooded while computing finite differences.
-    Logger::Level origLoggerLevel = Logger::getLevel();
-    Logger::setLevel(Logger::Level::Warn);
+    // output stream isn't flooded while computing finite differences. The
+    // level is process-wide, so leave it alone if it is already set (e.g., by
+    // opensim-moco run-batch, which solves studies on multiple threads).
+    const Logger::Level origLoggerLevel = Logger::getLevel();
+    const bool changeLoggerLevel = origLoggerLevel != Logger::Level::Warn;
+    if (changeLoggerLevel) Logger::setLevel(Logger::Level::Warn);
     tropter::Solution tropSolution;
     try {
         tropSolution = dircol->solve(tropIterate);
     } catch (...) {
-        OpenSim::Logger::setLevel(origLoggerLevel);
+        if (changeLoggerLevel) OpenSim::Logger::setLevel(origLoggerLevel);
+        throw;
     }
-    OpenSim::Logger::setLevel(origLoggerLevel);
+    if (changeLoggerLevel) OpenSim::Logger::setLevel(origLoggerLevel);
 
     if (get_verbosity()) { dircol->print_constraint_values(tropSolution); }
 
@@ -394,12 +398,22 @@ MocoSolution MocoTropterSolver::solveImpl() const {
 
     // TODO move this to convert():
     const long long elapsed = stopwatch.getElapsedTimeInNs();
+    std::vector<MocoSolverTiming> timings = ocp->getTimers().getTimings();
+    for (const auto& tropTiming : tropSolution.timings) {
+        MocoSolverTiming timing;
+        timing.name = "nlp_" + tropTiming.name;
+        timing.numEvaluations = tropTiming.num_evaluations;
+        timing.duration = tropTiming.duration;
+        timings.push_back(std::move(timing));
+    }
     MocoSolver::setSolutionStats(mocoSolution, tropSolution.success,
             tropSolution.objective, tropSolution.status,
-            tropSolution.num_iterations, SimTK::nsToSec(elapsed));
+            tropSolution.num_iterations, SimTK::nsToSec(elapsed), {},
+            std::move(timings));
 
     if (get_verbosity()) {
         log_info(std::string(72, '-'));
+        mocoSolution.printTimingBreakdown();
         log_info("Elapsed real time: {}", stopwatch.formatNs(elapsed));
         log_info(getMocoFormattedDateTime(false, "%c"));
         if (mocoSolution) {
@@ -21,15 +21,21 @@
 #include "MocoProblem.h"
 #include "MocoTrajectory.h"
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
+#include <fstream>
+#include <functional>
 #include <iomanip>
 #include <regex>
+#include <thread>
 
+#include <SimTKmath.h>
 #include <simbody/internal/Visualizer_InputListener.h>
 
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/Signal.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
@@ -87,6 +93,25 @@ std::string OpenSim::getAbsolutePathnameFromXMLDocument(
             directory, pathnameRelativeToDocument);
 }
 
+std::string OpenSim::computeContentDigest(const std::string& content) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << hash;
+    return ss.str();
+}
+
+std::string OpenSim::readFileContents(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    OPENSIM_THROW_IF(!file, Exception, "Could not open file '{}'.", filepath);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
 SimTK::Vector OpenSim::createVectorLinspace(
         int length, double start, double end) {
     SimTK::Vector v(length);
@@ -200,11 +225,77 @@ TimeSeriesTable OpenSim::filterLowpass(
         const TimeSeriesTable& table, double cutoffFreq, bool padData) {
     OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
             "Cutoff frequency must be non-negative; got {}.", cutoffFreq);
-    auto storage = convertTableToStorage(table);
-    if (padData) { storage.pad((int)table.getNumRows() / 2); }
-    storage.lowpassIIR(cutoffFreq);
 
-    return storage.exportToTable();
+    const int numRows = (int)table.getNumRows();
+    const int numColumns = (int)table.getNumColumns();
+    const int numPad = padData ? numRows / 2 : 0;
+    const int numPaddedRows = numRows + 2 * numPad;
+    OPENSIM_THROW_IF(numRows < 2, Exception,
+            "Expected the table to have at least 2 rows, but it has {}.",
+            numRows);
+
+    // Pad the signal by reflecting it about its first and last points, as
+    // Storage::pad() does.
+    auto pad = [&](const std::function<double(int)>& signal,
+                       std::vector<double>& padded) {
+        padded.resize(numPaddedRows);
+        for (int i = 0; i < numPad; ++i) {
+            padded[i] = 2.0 * signal(0) - signal(numPad - i);
+            padded[numPad + numRows + i] =
+                    2.0 * signal(numRows - 1) - signal(numRows - 2 - i);
+        }
+        for (int i = 0; i < numRows; ++i) padded[numPad + i] = signal(i);
+    };
+
+    const auto& times = table.getIndependentColumn();
+    std::vector<double> paddedTimes;
+    pad([&](int i) { return times[i]; }, paddedTimes);
+    double minTimeStep = SimTK::Infinity;
+    for (int i = 1; i < numPaddedRows; ++i) {
+        minTimeStep =
+                std::min(minTimeStep, paddedTimes[i] - paddedTimes[i - 1]);
+    }
+    const double avgTimeStep = (paddedTimes.back() - paddedTimes.front()) /
+                               (numPaddedRows - 1);
+    OPENSIM_THROW_IF(avgTimeStep - minTimeStep > SimTK::Eps, Exception,
+            "Expected the table to be sampled uniformly in time, but the "
+            "minimum time step is {} and the average time step is {}.",
+            minTimeStep, avgTimeStep);
+
+    // Each column is filtered independently, directly from the table's
+    // column buffers; we distribute the columns among threads.
+    SimTK::Matrix filtered(numPaddedRows, numColumns);
+    auto filterColumns = [&](int start, int stride) {
+        std::vector<double> padded;
+        std::vector<double> output(numPaddedRows);
+        for (int icol = start; icol < numColumns; icol += stride) {
+            const auto column = table.getDependentColumnAtIndex(icol);
+            pad([&](int i) { return column[i]; }, padded);
+            Signal::LowpassIIR(minTimeStep, cutoffFreq, numPaddedRows,
+                    padded.data(), output.data());
+            for (int i = 0; i < numPaddedRows; ++i) {
+                filtered(i, icol) = output[i];
+            }
+        }
+    };
+    int numThreads = 1;
+    const int parallel = getMocoParallelEnvironmentVariable();
+    if (parallel == -1 || parallel == 1) {
+        numThreads = (int)std::thread::hardware_concurrency();
+    } else if (parallel > 1) {
+        numThreads = parallel;
+    }
+    numThreads = std::max(1, std::min(numThreads, numColumns));
+    std::vector<std::thread> threads;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(filterColumns, ithread, numThreads);
+    }
+    filterColumns(0, numThreads);
+    for (auto& thread : threads) thread.join();
+
+    TimeSeriesTable result(paddedTimes, filtered, table.getColumnLabels());
+    result.updTableMetaData() = table.getTableMetaData();
+    return result;
 }
 
 void OpenSim::writeTableToFile(
@@ -213,6 +304,84 @@ void OpenSim::writeTableToFile(
     FileAdapter::writeFile(tables, filepath);
 }
 
+struct SharedReferenceSplines::Splines {
+    std::vector<std::string> labels;
+    std::vector<double> times;
+    SimTK::Matrix data;
+    // One spline for each column of data.
+    std::vector<SimTK::Spline> splines;
+
+    bool hasData(const std::vector<std::string>& otherLabels,
+            const std::vector<double>& otherTimes,
+            const SimTK::Matrix& otherData) const {
+        if (labels != otherLabels || times != otherTimes) return false;
+        for (int icol = 0; icol < data.ncol(); ++icol) {
+            for (int irow = 0; irow < data.nrow(); ++irow) {
+                const double& a = data(irow, icol);
+                const double& b = otherData(irow, icol);
+                if (a != b && !(SimTK::isNaN(a) && SimTK::isNaN(b))) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+void SharedReferenceSplines::fit(const TimeSeriesTable& table,
+        const std::vector<std::string>& labels) {
+    const auto& times = table.getIndependentColumn();
+    SimTK::Matrix data((int)times.size(), (int)labels.size());
+    for (int icol = 0; icol < (int)labels.size(); ++icol) {
+        data.updCol(icol) = table.getDependentColumn(labels[icol]);
+    }
+
+    std::lock_guard<std::mutex> lock(m_cache->mutex);
+    auto& cached = m_cache->splines;
+    if (!cached || !cached->hasData(labels, times, data)) {
+        auto splines = std::make_shared<Splines>();
+        splines->labels = labels;
+        splines->times = times;
+        splines->data = data;
+        const SimTK::Vector timeVec((int)times.size(), times.data());
+        for (int icol = 0; icol < (int)labels.size(); ++icol) {
+            splines->splines.push_back(
+                    SimTK::SplineFitter<SimTK::Real>::fitForSmoothingParameter(
+                            5, timeVec, SimTK::Vector(data.col(icol)), 0.0)
+                            .getSpline());
+        }
+        cached = splines;
+    }
+    m_splines = cached;
+}
+
+int SharedReferenceSplines::getNumSplines() const {
+    if (!m_splines) return 0;
+    return (int)m_splines->splines.size();
+}
+
+double SharedReferenceSplines::calcValue(
+        int index, const SimTK::Vector& x) const {
+    return m_splines->splines[index].calcValue(x);
+}
+
+std::size_t SharedReferenceSplines::calcDataHash() const {
+    if (!m_splines) return 0;
+    const auto& ref = *m_splines;
+    std::string bytes;
+    for (const auto& label : ref.labels) bytes += label + '\n';
+    const auto appendBytes = [&bytes](const double& value) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(double));
+    };
+    for (const auto& time : ref.times) appendBytes(time);
+    for (int icol = 0; icol < ref.data.ncol(); ++icol) {
+        for (int irow = 0; irow < ref.data.nrow(); ++irow) {
+            appendBytes(ref.data(irow, icol));
+        }
+    }
+    return std::hash<std::string>()(bytes);
+}
+
 // Based on code from simtk.org/projects/predictivesim SimbiconExample/main.cpp.
 void OpenSim::visualize(Model model, Storage statesSto) {
 
@@ -31,10 +31,16 @@
 #include <Common/Reporter.h>
 #include <Simulation/Model/Model.h>
 #include <Simulation/StatesTrajectory.h>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
 #include <regex>
 #include <set>
 #include <stack>
+#include <thread>
 
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
@@ -97,6 +103,17 @@ std::string getAbsolutePathnameFromXMLDocument(
         const std::string& documentFileName,
         const std::string& pathnameRelativeToDocument);
 
+/// Compute a 16-character hexadecimal digest of `content` (64-bit FNV-1a).
+/// This is used to name content-addressed cache files; it is not a
+/// cryptographic hash.
+/// @ingroup mocogenutil
+OSIMMOCO_API std::string computeContentDigest(const std::string& content);
+
+/// Read the entire contents of a file (in binary mode) into a string.
+/// @throws Exception if the file cannot be opened.
+/// @ingroup mocogenutil
+OSIMMOCO_API std::string readFileContents(const std::string& filepath);
+
 /// This class stores the formatting of a stream and restores that format
 /// when the StreamFormat is destructed.
 /// @ingroup mocologutil
@@ -238,8 +255,12 @@ OSIMMOCO_API void updateStateLabels40(
         const Model& model, std::vector<std::string>& labels);
 
 /// Lowpass filter the data in a TimeSeriesTable at a provided cutoff frequency.
-/// The table is converted to a Storage object to use the lowpassIIR() method
-/// to filter, and then converted back to TimeSeriesTable.
+/// The filter is the same as Storage::lowpassIIR(), but it is applied directly
+/// to the columns of the table (without converting to Storage), and the
+/// columns are filtered in parallel (see getMocoParallelEnvironmentVariable()).
+/// If padData is true, the data is padded as with Storage::pad(), and the
+/// returned table contains the padded rows. The table must be sampled
+/// uniformly in time.
 /// @ingroup moconumutil
 OSIMMOCO_API TimeSeriesTable filterLowpass(
         const TimeSeriesTable& table, double cutoffFreq, bool padData = false);
@@ -249,6 +270,39 @@ OSIMMOCO_API TimeSeriesTable filterLowpass(
 /// @ingroup moconumutil
 OSIMMOCO_API void writeTableToFile(const TimeSeriesTable&, const std::string&);
 
+/// Splines fit to columns of reference data, for use by tracking goals. These
+/// are the same interpolating quintic splines as those of a GCVSplineSet.
+/// Copies of a SharedReferenceSplines share the splines: fit() fits new
+/// splines only if the data differ from the data to which this object or any
+/// of its copies last fit splines. Therefore, the copies of a goal (e.g., one
+/// per thread in a solver) fit the splines once. The splines are not modified
+/// after they are fit, and evaluating them does not modify them, so copies on
+/// different threads can evaluate the splines at the same time.
+/// @ingroup moconumutil
+class OSIMMOCO_API SharedReferenceSplines {
+public:
+    /// Fit a spline to each of the columns of the table with the provided
+    /// labels, in the order of the labels.
+    void fit(const TimeSeriesTable& table,
+            const std::vector<std::string>& labels);
+    /// The number of splines from the last call to fit().
+    int getNumSplines() const;
+    /// Evaluate the spline with the provided index at time x[0].
+    double calcValue(int index, const SimTK::Vector& x) const;
+    /// A hash of the labels, times, and data to which the splines were fit,
+    /// or 0 if fit() has not been called.
+    std::size_t calcDataHash() const;
+
+private:
+    struct Splines;
+    struct Cache {
+        std::mutex mutex;
+        std::shared_ptr<const Splines> splines;
+    };
+    std::shared_ptr<Cache> m_cache = std::make_shared<Cache>();
+    std::shared_ptr<const Splines> m_splines;
+};
+
 /// Play back a motion (from the Storage) in the simbody-visuailzer. The Storage
 /// should contain all generalized coordinates. The visualizer window allows the
 /// user to control playback speed.
@@ -659,6 +713,110 @@ private:
     long long m_startTime;
 };
 
+/// Accumulate the number of evaluations of, and the real time spent in, named
+/// parts of a solve (e.g., evaluating the dynamics or a goal). Parts are
+/// created with addSection() before solving; recording time in a section
+/// with a ScopedTimer is lock-free and thread-safe.
+/// @ingroup mocogenutil
+class SolverTimers {
+public:
+    /// Record the time between construction and destruction of this object
+    /// in a section of a SolverTimers.
+    class ScopedTimer {
+    public:
+        ScopedTimer(const SolverTimers& timers, int index)
+                : ScopedTimer(&timers, index) {}
+        /// If timers is nullptr, nothing is recorded.
+        ScopedTimer(const SolverTimers* timers, int index)
+                : m_timers(timers), m_index(index),
+                  m_startTime(timers ? SimTK::realTimeInNs() : 0) {}
+        ~ScopedTimer() {
+            if (m_timers) {
+                m_timers->add(m_index, SimTK::realTimeInNs() - m_startTime);
+            }
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        const SolverTimers* m_timers;
+        int m_index;
+        long long m_startTime;
+    };
+
+    /// Return the index of the section with the given name, creating the
+    /// section if it does not exist yet. This function is not thread-safe.
+    int addSection(const std::string& name) {
+        for (int i = 0; i < (int)m_sections.size(); ++i) {
+            if (m_sections[i]->name == name) return i;
+        }
+        m_sections.push_back(OpenSim::make_unique<Section>(name));
+        return (int)m_sections.size() - 1;
+    }
+    /// Return the index of the section with the given name, which must have
+    /// been created with addSection(). Unlike addSection(), this may be
+    /// called on multiple threads at once.
+    int getSectionIndex(const std::string& name) const {
+        for (int i = 0; i < (int)m_sections.size(); ++i) {
+            if (m_sections[i]->name == name) return i;
+        }
+        OPENSIM_THROW(Exception,
+                fmt::format("Expected a timer section named '{}'.", name));
+    }
+    /// Add to the time spent in, and the number of evaluations of, a
+    /// section.
+    void add(int index, long long nanoseconds,
+            long long numEvaluations = 1) const {
+        auto& section = *m_sections[index];
+        section.numEvaluations.fetch_add(
+                numEvaluations, std::memory_order_relaxed);
+        section.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+    /// Record that a section realized a state to the given stage. The
+    /// highest such stage is reported in getTimings().
+    void addStage(int index, SimTK::Stage stage) const {
+        auto& maxStage = m_sections[index]->maxStage;
+        int current = maxStage.load(std::memory_order_relaxed);
+        while (stage > current &&
+                !maxStage.compare_exchange_weak(
+                        current, stage, std::memory_order_relaxed)) {}
+    }
+    /// Set the time, number of evaluations, and stage of all sections to
+    /// zero.
+    void reset() {
+        for (auto& section : m_sections) {
+            section->numEvaluations = 0;
+            section->nanoseconds = 0;
+            section->maxStage = SimTK::Stage::Empty;
+        }
+    }
+    /// The timings of the sections that were evaluated at least once, in the
+    /// order in which the sections were added.
+    std::vector<MocoSolverTiming> getTimings() const {
+        std::vector<MocoSolverTiming> timings;
+        for (const auto& section : m_sections) {
+            if (!section->numEvaluations) continue;
+            MocoSolverTiming timing;
+            timing.name = section->name;
+            timing.numEvaluations = section->numEvaluations;
+            timing.duration = SimTK::nsToSec(section->nanoseconds);
+            timing.maxStage = SimTK::Stage(section->maxStage.load());
+            timings.push_back(std::move(timing));
+        }
+        return timings;
+    }
+
+private:
+    struct Section {
+        explicit Section(std::string name) : name(std::move(name)) {}
+        std::string name;
+        mutable std::atomic<long long> numEvaluations{0};
+        mutable std::atomic<long long> nanoseconds{0};
+        mutable std::atomic<int> maxStage{SimTK::Stage::Empty};
+    };
+    std::vector<std::unique_ptr<Section>> m_sections;
+};
+
 /// This obtains the value of the OPENSIM_MOCO_PARALLEL environment variable.
 /// The value has the following meanings:
 /// - 0: run in series (not parallel).
@@ -675,10 +833,20 @@ OSIMMOCO_API int getMocoParallelEnvironmentVariable();
 
 /// This class lets you store objects of a single type for reuse by multiple
 /// threads, ensuring threadsafe access to each of those objects.
+/// A jar can be filled up front using leave(), or it can be given a factory
+/// function so that it creates objects on demand: if no object is available
+/// when a thread calls take(), and the jar has created fewer objects than its
+/// capacity, the jar creates a new object instead of blocking the thread.
 /// @ingroup mocogenutil
 // TODO: Find a way to always give the same thread the same object.
 template <typename T> class ThreadsafeJar {
 public:
+    using Factory = std::function<std::unique_ptr<T>()>;
+    ThreadsafeJar() = default;
+    /// Create objects on demand using `factory`, creating at most `capacity`
+    /// objects.
+    ThreadsafeJar(Factory factory, int capacity)
+            : m_factory(std::move(factory)), m_capacity(capacity) {}
     /// Request an object for your exclusive use on your thread. This function
     /// blocks the thread until an object is available. Make sure to return
     /// (leave()) the object when you're done!
@@ -686,11 +854,28 @@ public:
         // Only one thread can lock the mutex at a time, so only one thread
         // at a time can be in any of the functions of this class.
         std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_entries.empty() && m_factory && m_numCreated < m_capacity) {
+            // Create the object without holding the lock so that other
+            // threads can take and leave objects in the meantime.
+            ++m_numCreated;
+            incrementNumTaken();
+            const Factory factory = m_factory;
+            lock.unlock();
+            try {
+                return factory();
+            } catch (...) {
+                lock.lock();
+                --m_numCreated;
+                --m_numTaken;
+                throw;
+            }
+        }
         // Block this thread until the condition variable is woken up
         // (by a notify_...()) and the lambda function returns true.
         m_inventoryMonitor.wait(lock, [this] { return m_entries.size() > 0; });
         std::unique_ptr<T> top = std::move(m_entries.top());
         m_entries.pop();
+        incrementNumTaken();
         return top;
     }
     /// Add or return an object so that another thread can use it. You will need
@@ -699,21 +884,159 @@ public:
     void leave(std::unique_ptr<T> entry) {
         std::unique_lock<std::mutex> lock(m_mutex);
         m_entries.push(std::move(entry));
+        if (m_numTaken > 0) --m_numTaken;
         lock.unlock();
         m_inventoryMonitor.notify_one();
     }
-    /// Obtain the number of entries that can be taken.
+    /// Obtain the number of entries that can be taken without creating or
+    /// waiting for an entry.
     int size() const {
         std::lock_guard<std::mutex> lock(m_mutex);
         return (int)m_entries.size();
     }
+    /// The maximum number of entries that can be in use at once: the capacity
+    /// for a jar with a factory, or the number of entries otherwise.
+    int getCapacity() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_factory) return m_capacity;
+        return (int)m_entries.size() + m_numTaken;
+    }
+    /// The number of entries created by the factory so far.
+    int getNumCreated() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_numCreated;
+    }
+    /// The largest number of entries that were in use (taken) at once.
+    int getHighWaterMark() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_highWaterMark;
+    }
+    /// Replace the function used to create entries on demand. Entries that
+    /// were already created are not affected.
+    void setFactory(Factory factory) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_factory = std::move(factory);
+    }
+    Factory getFactory() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_factory;
+    }
 
 private:
+    void incrementNumTaken() {
+        ++m_numTaken;
+        m_highWaterMark = std::max(m_highWaterMark, m_numTaken);
+    }
+    // The factory may own data that the entries refer to, so the entries
+    // must be destroyed first.
+    Factory m_factory;
+    int m_capacity = 0;
+    int m_numCreated = 0;
+    int m_numTaken = 0;
+    int m_highWaterMark = 0;
     std::stack<std::unique_ptr<T>> m_entries;
     mutable std::mutex m_mutex;
     std::condition_variable m_inventoryMonitor;
 };
 
+/// This class processes items on a background thread, one at a time and in
+/// the order in which they were pushed, so that the thread pushing the items
+/// does not wait for the processing. At most `capacity` items wait to be
+/// processed; if processing cannot keep up, push() drops the oldest pending
+/// item. If processing an item throws an exception, the next call to push()
+/// rethrows it; use takeException() to obtain it after flush(). The thread is
+/// started by the first push().
+/// @ingroup mocogenutil
+template <typename T> class BackgroundProcessor {
+public:
+    using Processor = std::function<void(T&)>;
+    BackgroundProcessor(Processor processor, int capacity)
+            : m_processor(std::move(processor)), m_capacity(capacity) {}
+    /// Pending items are processed before the thread stops.
+    ~BackgroundProcessor() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+    BackgroundProcessor(const BackgroundProcessor&) = delete;
+    BackgroundProcessor& operator=(const BackgroundProcessor&) = delete;
+    /// Add an item to be processed, dropping the oldest pending item if
+    /// `capacity` items are already pending.
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_exception) {
+            auto exception = m_exception;
+            m_exception = nullptr;
+            std::rethrow_exception(exception);
+        }
+        if (!m_thread.joinable()) {
+            m_thread = std::thread(&BackgroundProcessor::process, this);
+        }
+        if ((int)m_pending.size() >= m_capacity) {
+            m_pending.pop_front();
+            ++m_numDropped;
+        }
+        m_pending.push_back(std::move(item));
+        lock.unlock();
+        m_condition.notify_all();
+    }
+    /// Wait until all pending items have been processed, and return the
+    /// number of items dropped since the previous flush().
+    int flush() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(
+                lock, [this] { return m_pending.empty() && !m_processing; });
+        const int numDropped = m_numDropped;
+        m_numDropped = 0;
+        return numDropped;
+    }
+    /// Obtain (and clear) the exception from processing an item, if it was
+    /// not already thrown from push(). This is null if processing succeeded.
+    std::exception_ptr takeException() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto exception = m_exception;
+        m_exception = nullptr;
+        return exception;
+    }
+
+private:
+    void process() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_condition.wait(
+                    lock, [this] { return m_stop || !m_pending.empty(); });
+            if (m_pending.empty()) return;
+            T item = std::move(m_pending.front());
+            m_pending.pop_front();
+            m_processing = true;
+            lock.unlock();
+            try {
+                m_processor(item);
+            } catch (...) {
+                lock.lock();
+                if (!m_exception) m_exception = std::current_exception();
+                lock.unlock();
+            }
+            lock.lock();
+            m_processing = false;
+            m_condition.notify_all();
+        }
+    }
+    Processor m_processor;
+    int m_capacity;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<T> m_pending;
+    bool m_processing = false;
+    bool m_stop = false;
+    int m_numDropped = 0;
+    std::exception_ptr m_exception;
+};
+
 /// Thrown by FileDeletionThrower::throwIfDeleted().
 /// @ingroup mocogenutil
 class FileDeletionThrowerException : public Exception {
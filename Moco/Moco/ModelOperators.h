@@ -19,8 +19,11 @@
  * -------------------------------------------------------------------------- */
 
 #include "Components/DeGrooteFregly2016Muscle.h"
+#include "Components/PolynomialGeometryPath.h"
 #include "ModelProcessor.h"
+#include "MocoUtilities.h"
 
+#include <OpenSim/Simulation/Model/ExternalLoads.h>
 #include <OpenSim/Tools/InverseDynamicsTool.h>
 
 namespace OpenSim {
@@ -32,18 +35,53 @@ class OSIMMOCO_API ModOpReplaceMusclesWithDeGrooteFregly2016
             ModOpReplaceMusclesWithDeGrooteFregly2016, ModelOperator);
 
 public:
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeConnections();
         DeGrooteFregly2016Muscle::replaceMuscles(model);
     }
 };
 
+/// Invoke PolynomialGeometryPath::replacePaths() on the model to replace the
+/// path of each muscle with a polynomial function of the coordinates that the
+/// muscle spans. The error of each fit is logged.
+class OSIMMOCO_API ModOpReplacePathsWithPolynomials : public ModelOperator {
+    OpenSim_DECLARE_CONCRETE_OBJECT(
+            ModOpReplacePathsWithPolynomials, ModelOperator);
+    OpenSim_DECLARE_PROPERTY(order, int,
+            "The order of the polynomials. Default: 5.");
+    OpenSim_DECLARE_PROPERTY(num_samples_per_coordinate, int,
+            "The number of samples across the range of each coordinate "
+            "used to fit the polynomials. Default: 7.");
+
+public:
+    ModOpReplacePathsWithPolynomials() {
+        constructProperty_order(5);
+        constructProperty_num_samples_per_coordinate(7);
+    }
+    ModOpReplacePathsWithPolynomials(int order)
+            : ModOpReplacePathsWithPolynomials() {
+        set_order(order);
+    }
+    ModOpReplacePathsWithPolynomials(int order, int numSamplesPerCoordinate)
+            : ModOpReplacePathsWithPolynomials(order) {
+        set_num_samples_per_coordinate(numSamplesPerCoordinate);
+    }
+    bool isCacheable() const override { return true; }
+    void operate(Model& model, const std::string&) const override {
+        model.finalizeConnections();
+        PolynomialGeometryPath::replacePaths(
+                model, get_order(), get_num_samples_per_coordinate());
+    }
+};
+
 /// Turn off activation dynamics for all muscles in the model.
 class OSIMMOCO_API ModOpIgnoreActivationDynamics : public ModelOperator {
     OpenSim_DECLARE_CONCRETE_OBJECT(
             ModOpIgnoreActivationDynamics, ModelOperator);
 
 public:
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeFromProperties();
         for (auto& muscle : model.updComponentList<Muscle>()) {
@@ -57,6 +95,7 @@ class OSIMMOCO_API ModOpIgnoreTendonCompliance : public ModelOperator {
     OpenSim_DECLARE_CONCRETE_OBJECT(ModOpIgnoreTendonCompliance, ModelOperator);
 
 public:
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeFromProperties();
         for (auto& muscle : model.updComponentList<Muscle>()) {
@@ -89,6 +128,7 @@ public:
                 mode);
         set_mode(std::move(mode));
     }
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeFromProperties();
         for (auto& muscle :
@@ -108,6 +148,7 @@ class OSIMMOCO_API ModOpUseImplicitTendonComplianceDynamicsDGF
         ModOpUseImplicitTendonComplianceDynamicsDGF, ModelOperator);
 
 public:
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeFromProperties();
         for (auto& muscle :
@@ -126,6 +167,7 @@ class OSIMMOCO_API ModOpIgnorePassiveFiberForcesDGF : public ModelOperator {
             ModOpIgnorePassiveFiberForcesDGF, ModelOperator);
 
 public:
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeFromProperties();
         for (auto& muscle :
@@ -154,6 +196,7 @@ public:
         set_passive_fiber_strain_at_one_norm_force(value);
     }
 
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeFromProperties();
         for (auto& muscle :
@@ -180,6 +223,7 @@ public:
             : ModOpScaleActiveFiberForceCurveWidthDGF() {
         set_scale_factor(scaleFactor);
     }
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeFromProperties();
         for (auto& muscle :
@@ -201,6 +245,7 @@ public:
     ModOpFiberDampingDGF(double fiberDamping) : ModOpFiberDampingDGF() {
         set_fiber_damping(fiberDamping);
     }
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeFromProperties();
         for (auto& muscle :
@@ -224,6 +269,7 @@ public:
             : ModOpScaleMaxIsometricForce() {
         set_scale_factor(scaleFactor);
     }
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.finalizeFromProperties();
         for (auto& muscle : model.updComponentList<Muscle>()) {
@@ -238,6 +284,7 @@ class OSIMMOCO_API ModOpRemoveMuscles : public ModelOperator {
     OpenSim_DECLARE_CONCRETE_OBJECT(ModOpRemoveMuscles, ModelOperator);
 
 public:
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         // Without finalizeFromProperties(), an exception is raised
         // about the model not having any subcomponents.
@@ -277,6 +324,7 @@ public:
             : ModOpAddReserves(optimalForce, bounds) {
         set_skip_coordinates_with_actuators(skipCoordsWithActu);
     }
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.initSystem();
         ModelFactory::createReserveActuators(model, get_optimal_force(),
@@ -297,17 +345,31 @@ public:
     ModOpAddExternalLoads(std::string filepath) : ModOpAddExternalLoads() {
         set_filepath(std::move(filepath));
     }
+    bool isCacheable() const override { return true; }
     /// The ExternalLoads XML file is located relative to `relativeToDirectory`.
     void operate(Model& model,
             const std::string& relativeToDirectory) const override {
+        InverseDynamicsTool idTool;
+        idTool.createExternalLoads(getPath(relativeToDirectory), model);
+    }
+    /// The ExternalLoads XML file and its data file.
+    std::vector<std::string> getFileDependencies(
+            const std::string& relativeToDirectory) const override {
+        const std::string path = getPath(relativeToDirectory);
+        ExternalLoads externalLoads(path, true);
+        return {path, getAbsolutePathnameFromXMLDocument(
+                              path, externalLoads.getDataFileName())};
+    }
+
+private:
+    std::string getPath(const std::string& relativeToDirectory) const {
         std::string path = get_filepath();
         if (!relativeToDirectory.empty()) {
             using SimTK::Pathname;
             path = Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
                     relativeToDirectory, path);
         }
-        InverseDynamicsTool idTool;
-        idTool.createExternalLoads(path, model);
+        return path;
     }
 };
 
@@ -322,6 +384,7 @@ public:
             ModOpReplaceJointsWithWelds() {
         for (const auto& path : paths) { append_joint_paths(path); }
     }
+    bool isCacheable() const override { return true; }
     void operate(Model& model, const std::string&) const override {
         model.initSystem();
         for (int i = 0; i < getProperty_joint_paths().size(); ++i) {
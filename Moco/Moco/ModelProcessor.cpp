@@ -0,0 +1,242 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: ModelProcessor.cpp                                           *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelProcessor.h"
+
+#include "MocoUtilities.h"
+#include <cstdio>
+#include <functional>
+#include <list>
+#include <mutex>
+
+#include <OpenSim/Common/IO.h>
+
+using namespace OpenSim;
+
+namespace {
+
+/// Processed models, keyed by the digest of their source file and operators.
+/// The most recently used model is at the front.
+class ModelCache {
+public:
+    bool get(const std::string& key, Model& model) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->first == key) {
+                m_entries.splice(m_entries.begin(), m_entries, it);
+                model = *it->second;
+                return true;
+            }
+        }
+        return false;
+    }
+    void put(const std::string& key, const Model& model) {
+        std::unique_ptr<Model> copy(new Model(model));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->first == key) {
+                m_entries.erase(it);
+                break;
+            }
+        }
+        m_entries.emplace_front(key, std::move(copy));
+        while ((int)m_entries.size() > m_maxNumEntries) m_entries.pop_back();
+    }
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+    }
+
+private:
+    // Models can be large, so we keep only a few.
+    const int m_maxNumEntries = 4;
+    std::mutex m_mutex;
+    std::list<std::pair<std::string, std::unique_ptr<Model>>> m_entries;
+};
+
+ModelCache& getModelCache() {
+    static ModelCache cache;
+    return cache;
+}
+
+/// The files that a model file refers to (e.g., data files or geometry): the
+/// values of XML elements that name an existing file relative to the model
+/// file's directory or its Geometry subdirectory.
+std::vector<std::string> findReferencedFiles(const std::string& modelPath) {
+    using SimTK::Pathname;
+    const std::string absoluteModelPath =
+            Pathname::getAbsolutePathname(modelPath);
+    bool dontApplySearchPath;
+    std::string directory, fileName, extension;
+    Pathname::deconstructPathname(absoluteModelPath, dontApplySearchPath,
+            directory, fileName, extension);
+    std::vector<std::string> files;
+    std::function<void(SimTK::Xml::Element&)> visit;
+    visit = [&](SimTK::Xml::Element& element) {
+        if (element.isValueElement()) {
+            const std::string value = IO::Trim(element.getValue());
+            // File references contain an extension and no whitespace.
+            const auto dot = value.find_last_of('.');
+            if (dot == std::string::npos || dot == 0 ||
+                    dot + 1 == value.size() ||
+                    value.find_first_of(" \t\n") != std::string::npos ||
+                    value[dot - 1] == '.' || value[dot - 1] == '/') {
+                return;
+            }
+            for (const auto& candidateDirectory :
+                    {directory, directory + "Geometry/"}) {
+                const std::string candidate = Pathname::
+                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                candidateDirectory, value);
+                if (candidate != absoluteModelPath &&
+                        IO::FileExists(candidate)) {
+                    files.push_back(candidate);
+                    break;
+                }
+            }
+            return;
+        }
+        for (auto it = element.element_begin(); it != element.element_end();
+                ++it) {
+            visit(*it);
+        }
+    };
+    SimTK::Xml::Document document(modelPath);
+    SimTK::Xml::Element root = document.getRootElement();
+    visit(root);
+    return files;
+}
+
+} // anonymous namespace
+
+Model ModelProcessor::process(const std::string& relativeToDirectory) const {
+    Model model;
+    if (get_filepath().empty()) {
+        if (!getProperty_model().empty()) {
+            model = get_model();
+        } else {
+            OPENSIM_THROW_FRMOBJ(Exception, "No source model.");
+        }
+        applyOperators(model, relativeToDirectory);
+        return model;
+    }
+
+    OPENSIM_THROW_IF_FRMOBJ(!getProperty_model().empty(), Exception,
+            "Expected either a Model object or a filepath, but "
+            "both were provided.");
+    using SimTK::Pathname;
+    std::string path = get_filepath();
+    if (!relativeToDirectory.empty()) {
+        path = Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                relativeToDirectory, path);
+    }
+    auto loadModel = [](const std::string& path, Model& model) {
+        Model modelFromFile(path);
+        model = std::move(modelFromFile);
+        model.finalizeFromProperties();
+        model.finalizeConnections();
+    };
+
+    bool cacheable = get_cache_in_memory() || !get_cache_directory().empty();
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        cacheable = cacheable && get_operators(i).isCacheable();
+    }
+    if (!cacheable) {
+        loadModel(path, model);
+        applyOperators(model, relativeToDirectory);
+        return model;
+    }
+
+    // The processed model depends on the source file, the operators, and the
+    // contents of the files that the source file and the operators read.
+    std::string key = Pathname::getAbsolutePathname(path) + "\n" +
+                      relativeToDirectory + "\n" + readFileContents(path);
+    bool hasFileDependencies = false;
+    for (const auto& reference : findReferencedFiles(path)) {
+        key += reference + "\n" + readFileContents(reference);
+        hasFileDependencies = true;
+    }
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        const auto& op = get_operators(i);
+        key += op.dump();
+        for (const auto& dependency :
+                op.getFileDependencies(relativeToDirectory)) {
+            key += dependency + "\n" + readFileContents(dependency);
+            hasFileDependencies = true;
+        }
+    }
+    const std::string digest = computeContentDigest(key);
+
+    if (get_cache_in_memory() && getModelCache().get(digest, model)) {
+        log_info("Using cached processed model for '{}'.", get_filepath());
+        return model;
+    }
+
+    // A serialized model that refers to or was created from other files may
+    // refer to those files with paths relative to the source file, which
+    // would be resolved relative to the cache directory if we loaded the model
+    // from there. We do not cache such models on disk.
+    std::string cachePath;
+    if (!get_cache_directory().empty() && hasFileDependencies) {
+        log_info("Not caching processed model '{}' on disk because it refers "
+                 "to other files.",
+                get_filepath());
+    } else if (!get_cache_directory().empty()) {
+        std::string cacheDirectory = get_cache_directory();
+        if (!relativeToDirectory.empty()) {
+            cacheDirectory =
+                    Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                            relativeToDirectory, cacheDirectory);
+        }
+        IO::makeDir(cacheDirectory);
+        cachePath = cacheDirectory + "/ModelProcessor_" + digest + ".osim";
+    }
+
+    if (!cachePath.empty() && IO::FileExists(cachePath)) {
+        log_info("Using cached processed model '{}' for '{}'.", cachePath,
+                get_filepath());
+        loadModel(cachePath, model);
+    } else {
+        loadModel(path, model);
+        applyOperators(model, relativeToDirectory);
+        if (!cachePath.empty()) {
+            // Write to a temporary file first so that other processes never
+            // read a partially-written cache file.
+            const std::string tempPath =
+                    cachePath + "." + getMocoFormattedDateTime(true);
+            model.print(tempPath);
+            std::remove(cachePath.c_str());
+            if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+                std::remove(tempPath.c_str());
+                log_warn("Could not cache processed model '{}' to '{}'.",
+                        get_filepath(), cachePath);
+            }
+        }
+    }
+    if (get_cache_in_memory()) getModelCache().put(digest, model);
+    return model;
+}
+
+void ModelProcessor::clearCache() { getModelCache().clear(); }
+
+void ModelProcessor::applyOperators(
+        Model& model, const std::string& relativeToDirectory) const {
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        get_operators(i).operate(model, relativeToDirectory);
+    }
+}
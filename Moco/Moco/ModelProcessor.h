@@ -35,6 +35,21 @@ public:
     /// any files that this operator reads.
     virtual void operate(
             Model& model, const std::string& relativeToDirectory) const = 0;
+    /// Obtain the paths of any files that operate() reads, using
+    /// `relativeToDirectory` to locate them. ModelProcessor uses the contents
+    /// of these files to determine if a cached processed model is still
+    /// valid.
+    virtual std::vector<std::string> getFileDependencies(
+            const std::string& relativeToDirectory) const {
+        return {};
+    }
+    /// Return true if the result of operate() depends only on the model, this
+    /// operator's properties, and the contents of the files from
+    /// getFileDependencies(). ModelProcessor does not cache models processed
+    /// with operators that are not cacheable. Operators are not cacheable by
+    /// default, since ModelProcessor cannot detect other state (e.g., member
+    /// variables) that operate() might use.
+    virtual bool isCacheable() const { return false; }
 };
 
 /// This class describes a workflow for processing a Model using
@@ -44,6 +59,21 @@ public:
 /// @code
 /// ModelProcessor proc = ModelProcessor("model.osim") | ModOpAddReserves();
 /// @endcode
+///
+/// Processed models can be cached (see the cache_in_memory and
+/// cache_directory properties) if the source model is a file and all
+/// operators are cacheable (see ModelOperator::isCacheable()). The cache is
+/// keyed by the path and contents of the source file, `relativeToDirectory`,
+/// the operators, the contents of any files that the operators read (see
+/// ModelOperator::getFileDependencies()), and the contents of any files that
+/// the source file refers to (any XML element whose value names an existing
+/// file relative to the source file's directory or its Geometry
+/// subdirectory). A later call to process(), possibly from a different
+/// ModelProcessor, with the same key returns a copy of the cached model
+/// instead of parsing the file and applying the operators again. Models that
+/// refer to other files are cached only in memory, since a model loaded from
+/// the cache directory would resolve relative file references from the wrong
+/// directory.
 class OSIMMOCO_API ModelProcessor : public Object {
     OpenSim_DECLARE_CONCRETE_OBJECT(ModelProcessor, Object);
 
@@ -52,12 +82,24 @@ public:
             filepath, std::string, "File path to a Model (.osim).");
     OpenSim_DECLARE_LIST_PROPERTY(operators, ModelOperator,
             "Operators to apply to the source Model of this processor.");
+    OpenSim_DECLARE_PROPERTY(cache_in_memory, bool,
+            "Cache the most recently processed models in memory. Only used if "
+            "the source model is a file and all operators are cacheable "
+            "(default: false).");
+    OpenSim_DECLARE_PROPERTY(cache_directory, std::string,
+            "Directory in which to cache processed models. The directory is "
+            "evaluated relative to the same directory as filepath. Only used "
+            "if the source model is a file, all operators are cacheable, and "
+            "neither the source model nor the operators read other files "
+            "(default: empty, which disables caching on disk).");
     /// This constructor is only for use when reading (deserializing) from an
     /// XML file.
     ModelProcessor() {
         constructProperty_filepath("");
         constructProperty_operators();
         constructProperty_model();
+        constructProperty_cache_in_memory(false);
+        constructProperty_cache_directory("");
     }
 
     /// Use a Model object as the source model.
@@ -106,36 +148,10 @@ public:
     /// Process and obtain the model. If the base model is specified via the
     /// filepath property, the filepath will be evaluated relative to
     /// `relativeToDirectory`, if provided.
-    Model process(const std::string& relativeToDirectory = {}) const {
-        Model model;
-        if (get_filepath().empty()) {
-            if (!getProperty_model().empty()) {
-                model = get_model();
-            } else {
-                OPENSIM_THROW_FRMOBJ(Exception, "No source model.");
-            }
-        } else {
-            OPENSIM_THROW_IF_FRMOBJ(!getProperty_model().empty(), Exception,
-                    "Expected either a Model object or a filepath, but "
-                    "both were provided.");
-            std::string path = get_filepath();
-            if (!relativeToDirectory.empty()) {
-                using SimTK::Pathname;
-                path = Pathname::
-                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
-                                relativeToDirectory, path);
-            }
-            Model modelFromFile(path);
-            model = std::move(modelFromFile);
-            model.finalizeFromProperties();
-            model.finalizeConnections();
-        }
-
-        for (int i = 0; i < getProperty_operators().size(); ++i) {
-            get_operators(i).operate(model, relativeToDirectory);
-        }
-        return model;
-    }
+    Model process(const std::string& relativeToDirectory = {}) const;
+
+    /// Remove all processed models from the in-memory cache.
+    static void clearCache();
 
     /// Append an operation to the end of the operations in this processor.
     ModelProcessor& append(const ModelOperator& op) {
@@ -151,6 +167,9 @@ public:
     }
 
 private:
+    void applyOperators(
+            Model& model, const std::string& relativeToDirectory) const;
+
     OpenSim_DECLARE_OPTIONAL_PROPERTY(model, Model, "Base model to process.");
 };
 
@@ -23,6 +23,7 @@
 #include "Components/DeGrooteFregly2016Muscle.h"
 #include "Components/DiscreteForces.h"
 #include "Components/MultivariatePolynomialFunction.h"
+#include "Components/PolynomialGeometryPath.h"
 #include "Components/PositionMotion.h"
 #include "Components/Bhargava2004Metabolics.h"
 #include "Components/StationPlaneContactForce.h"
@@ -123,13 +124,16 @@ OSIMMOCO_API void RegisterTypes_osimMoco() {
         Object::registerType(ModOpScaleActiveFiberForceCurveWidthDGF());
         Object::registerType(ModOpReplaceJointsWithWelds());
         Object::registerType(ModOpScaleMaxIsometricForce());
+        Object::registerType(ModOpReplacePathsWithPolynomials());
 
         Object::registerType(AckermannVanDenBogert2010Force());
         Object::registerType(MeyerFregly2016Force());
         Object::registerType(EspositoMiller2018Force());
         Object::registerType(PositionMotion());
         Object::registerType(DeGrooteFregly2016Muscle());
+        Object::registerType(DeGrooteFregly2016MuscleGroup());
         Object::registerType(MultivariatePolynomialFunction());
+        Object::registerType(PolynomialGeometryPath());
         Object::registerType(Bhargava2004Metabolics());
 
         Object::registerType(DiscreteForces());
@@ -21,9 +21,11 @@
 #include "About.h"
 #include "Common/TableProcessor.h"
 #include "Components/DeGrooteFregly2016Muscle.h"
+#include "Components/DeGrooteFregly2016MuscleGroup.h"
 #include "Components/DiscreteForces.h"
 #include "Components/ModelFactory.h"
 #include "Components/MultivariatePolynomialFunction.h"
+#include "Components/PolynomialGeometryPath.h"
 #include "Components/PositionMotion.h"
 #include "Components/Bhargava2004Metabolics.h"
 #include "Components/StationPlaneContactForce.h"
@@ -83,6 +83,8 @@ protected:
                 m_mocoProbRep.createStateVariableNamesInSystemOrder(
                         m_yIndexMap);
 
+        m_daeTimerIndex =
+                m_timers.addSection("differential_algebraic_equations");
         addStateVariables();
         addControlVariables();
         addParameters();
@@ -90,6 +92,11 @@ protected:
         addKinematicConstraints();
         addGenericPathConstraints();
 
+        if (m_mocoTropterSolver.get_profile_goals()) {
+            m_mocoProbRep.addProfilerSections(m_timers);
+            m_mocoProbRep.setProfiler(&m_timers);
+        }
+
         std::string formattedTimeString(getMocoFormattedDateTime(true));
         m_fileDeletionThrower = OpenSim::make_unique<FileDeletionThrower>(
                 fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
@@ -123,14 +130,23 @@ protected:
         for (const auto& name : costNames) {
             const auto& cost = m_mocoProbRep.getCost(name);
             this->add_cost(name, cost.getNumIntegrals());
+            addCostTimers(name);
         }
         OPENSIM_THROW_IF(m_mocoProbRep.getNumEndpointConstraints(), Exception,
                 "MocoTropterSolver does not support endpoint constraints.");
         if (m_mocoTropterSolver.get_minimize_lagrange_multipliers()) {
             m_multiplierCostIndex = this->add_cost("multipliers", 1);
+            addCostTimers("multipliers");
         }
     }
 
+    void addCostTimers(const std::string& name) {
+        m_costIntegrandTimerIndices.push_back(
+                m_timers.addSection("cost_" + name + "_integrand"));
+        m_costTimerIndices.push_back(
+                m_timers.addSection("cost_" + name + "_endpoint"));
+    }
+
     void addKinematicConstraints() {
         // Add any scalar constraints associated with kinematic constraints in
         // the model as path constraints in the problem.
@@ -358,6 +374,8 @@ protected:
 
     void calc_cost_integrand(int cost_index, const tropter::Input<T>& in,
             T& integrand) const override {
+        SolverTimers::ScopedTimer timer(
+                m_timers, m_costIntegrandTimerIndices[cost_index]);
         if (cost_index == m_multiplierCostIndex) {
             // Unpack variables.
             const auto& adjuncts = in.adjuncts;
@@ -370,6 +388,10 @@ protected:
             return;
         }
 
+        const auto& cost = m_mocoProbRep.getCostByIndex(cost_index);
+        SolverTimers::ScopedTimer goalTimer(
+                cost.getProfiler(), cost.getIntegrandProfileIndex());
+
         // Update the state.
         // TODO would it make sense to a vector of States, one for each mesh
         // point, so that each can preserve their cache?
@@ -381,18 +403,23 @@ protected:
                 this->m_stateDisabledConstraints);
 
         // Compute the integrand for this cost term.
-        const auto& cost = m_mocoProbRep.getCostByIndex(cost_index);
         integrand = cost.calcIntegrand(
                 {in.time, this->m_stateDisabledConstraints, rawControls});
     }
 
     void calc_cost(int cost_index, const tropter::CostInput<T>& in,
             T& cost_value) const override {
+        SolverTimers::ScopedTimer timer(
+                m_timers, m_costTimerIndices[cost_index]);
         if (cost_index == m_multiplierCostIndex) {
             cost_value = in.integral;
             return;
         }
 
+        const auto& cost = m_mocoProbRep.getCostByIndex(cost_index);
+        SolverTimers::ScopedTimer goalTimer(
+                cost.getProfiler(), cost.getGoalProfileIndex());
+
         // Update the state.
         this->setSimTKStateForCostInitial(in);
         this->setSimTKStateForCostFinal(in);
@@ -408,7 +435,6 @@ protected:
                 finalState);
 
         // Compute the cost for this cost term.
-        const auto& cost = m_mocoProbRep.getCostByIndex(cost_index);
         SimTK::Vector costVector(cost.getNumOutputs());
         cost.calcGoal({in.initial_time, initialState, initialRawControls,
                               in.final_time, finalState, finalRawControls,
@@ -428,6 +454,12 @@ protected:
 
     std::unique_ptr<FileDeletionThrower> m_fileDeletionThrower;
 
+    // Number of evaluations of, and time spent in, the dynamics and each cost.
+    SolverTimers m_timers;
+    int m_daeTimerIndex = -1;
+    std::vector<int> m_costIntegrandTimerIndices;
+    std::vector<int> m_costTimerIndices;
+
     std::vector<std::string> m_svNamesInSysOrder;
     std::unordered_map<int, int> m_yIndexMap;
     std::vector<int> m_modelControlIndices;
@@ -561,6 +593,13 @@ public:
 
     tropter::Iterate convertToTropterIterate(
             const MocoTrajectory& mocoIter) const;
+
+    const SolverTimers& getTimers() const { return m_timers; }
+
+    ~TropterProblemBase() override {
+        // The MocoProblemRep outlives this problem.
+        m_mocoProbRep.setProfiler(nullptr);
+    }
 };
 
 template <typename T>
@@ -572,6 +611,7 @@ public:
     void initialize_on_mesh(const Eigen::VectorXd&) const override {}
     void calc_differential_algebraic_equations(const tropter::Input<T>& in,
             tropter::Output<T> out) const override {
+        SolverTimers::ScopedTimer timer(this->m_timers, this->m_daeTimerIndex);
         // Unpack variables.
         const auto& diffuses = in.diffuses;
 
@@ -668,6 +708,7 @@ public:
     }
     void calc_differential_algebraic_equations(const tropter::Input<T>& in,
             tropter::Output<T> out) const override {
+        SolverTimers::ScopedTimer timer(this->m_timers, this->m_daeTimerIndex);
 
         const auto& states = in.states;
         const auto& adjuncts = in.adjuncts;
@@ -19,6 +19,7 @@
 #include "Testing.h"
 #include <Moco/Components/AccelerationMotion.h>
 #include <Moco/osimMoco.h>
+#include <atomic>
 
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
@@ -432,3 +433,110 @@ TEST_CASE("Implicit auxiliary dynamics") {
                                 "with implicit auxiliary dynamics."));
     }
 }
+
+// This class implements a custom component with simple dynamics in explicit
+// form. The derivative is computed during realizeAcceleration().
+class MyAuxiliaryExplicitDynamics : public Component {
+    OpenSim_DECLARE_CONCRETE_OBJECT(MyAuxiliaryExplicitDynamics, Component);
+
+public:
+    MyAuxiliaryExplicitDynamics() { setName("explicit_auxdyn"); }
+
+private:
+    void computeStateVariableDerivatives(const SimTK::State& s) const override {
+        setStateVariableDerivativeValue(
+                s, "bar", -getStateVariableValue(s, "bar"));
+    }
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override {
+        Super::extendAddToSystem(system);
+        addStateVariable("bar");
+    }
+};
+
+namespace {
+std::atomic<int> g_numAccelerationRealizations(0);
+} // anonymous namespace
+
+/// Counts the number of times the Acceleration stage is realized.
+class AccelerationRealizationCounter : public Component {
+    OpenSim_DECLARE_CONCRETE_OBJECT(AccelerationRealizationCounter, Component);
+
+private:
+    void extendRealizeAcceleration(const SimTK::State& s) const override {
+        Super::extendRealizeAcceleration(s);
+        ++g_numAccelerationRealizations;
+    }
+};
+
+TEST_CASE("Implicit multibody residuals at the Dynamics stage") {
+    // If all auxiliary dynamics are in implicit form, MocoCasADiSolver
+    // computes the multibody residuals from the applied forces, without
+    // realizing to Acceleration. A state with explicit dynamics that is
+    // decoupled from the rest of the problem requires realizing to
+    // Acceleration, and the residuals are then computed with
+    // findMotionForces(). Both must yield the same solution.
+    const auto solve = [](bool withExplicitAuxiliaryDynamics) {
+        MocoStudy study;
+        auto& problem = study.updProblem();
+        auto model = ModelFactory::createDoublePendulum();
+        // The multipliers of this constraint are nonzero.
+        auto* constraint = new CoordinateCouplerConstraint();
+        Array<std::string> names;
+        names.append("q0");
+        constraint->setIndependentCoordinateNames(names);
+        constraint->setDependentCoordinateName("q1");
+        LinearFunction func(0.5, 0.0);
+        constraint->setFunction(func);
+        model.addConstraint(constraint);
+        model.addComponent(new MyAuxiliaryImplicitDynamics());
+        model.addComponent(new AccelerationRealizationCounter());
+        if (withExplicitAuxiliaryDynamics) {
+            model.addComponent(new MyAuxiliaryExplicitDynamics());
+        }
+        problem.setModelCopy(model);
+        problem.setTimeBounds(0, 1);
+        problem.setStateInfo("/jointset/j0/q0/value", {-10, 10}, 0, 0.5);
+        problem.setStateInfo("/jointset/j0/q0/speed", {-50, 50}, 0, 0);
+        problem.setStateInfo("/jointset/j1/q1/value", {-10, 10});
+        problem.setStateInfo("/jointset/j1/q1/speed", {-50, 50});
+        problem.setStateInfo("/implicit_auxdyn/foo", {0, 3}, 1.0);
+        problem.setStateInfo("/explicit_auxdyn/bar", {-10, 10}, 1.0);
+        problem.setControlInfo("/tau0", {-100, 100});
+        problem.setControlInfo("/tau1", {-100, 100});
+        problem.addGoal<MocoControlGoal>();
+        auto& solver = study.initCasADiSolver();
+        solver.set_multibody_dynamics_mode("implicit");
+        solver.set_num_mesh_intervals(10);
+        solver.set_transcription_scheme("hermite-simpson");
+        solver.set_enforce_constraint_derivatives(true);
+        solver.set_optim_convergence_tolerance(1e-6);
+        g_numAccelerationRealizations = 0;
+        MocoSolution solution = study.solve();
+        return std::make_pair(solution, g_numAccelerationRealizations.load());
+    };
+    const auto dynamicsStage = solve(false);
+    const auto findMotionForces = solve(true);
+    const auto& solution = dynamicsStage.first;
+    const auto& expected = findMotionForces.first;
+    REQUIRE(solution.success());
+    REQUIRE(expected.success());
+
+    // Only the problem with explicit auxiliary dynamics realizes to
+    // Acceleration to evaluate the dynamics.
+    CAPTURE(dynamicsStage.second, findMotionForces.second);
+    CHECK(dynamicsStage.second * 10 < findMotionForces.second);
+
+    // The multibody residuals (and thus the accelerations and multipliers)
+    // and the implicit auxiliary derivatives are the same.
+    CHECK(solution.getObjective() ==
+            Approx(expected.getObjective()).epsilon(1e-4));
+    std::vector<std::string> stateNames = solution.getStateNames();
+    CHECK(solution.compareContinuousVariablesRMS(expected,
+                  {{"states", stateNames}, {"controls", {}},
+                          {"multipliers", {}}, {"derivatives", {}}}) <
+            1e-3);
+
+    // The explicit auxiliary dynamics are obeyed: bar(t) = exp(-t).
+    const auto bar = expected.getState("/explicit_auxdyn/bar");
+    CHECK(bar[bar.size() - 1] == Approx(std::exp(-1.0)).epsilon(1e-3));
+}
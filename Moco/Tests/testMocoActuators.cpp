@@ -1085,6 +1085,179 @@ Model createHangingMuscleModel(
     return model;
 }
 
+std::unique_ptr<Model> createDGFMusclesModel(bool useGroup) {
+    // Muscles with a variety of settings.
+    auto model = make_unique<Model>();
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model->addComponent(body);
+    auto* joint = new SliderJoint("joint", model->getGround(), *body);
+    joint->updCoordinate(SliderJoint::Coord::TranslationX).setName("x");
+    model->addComponent(joint);
+    for (int i = 0; i < 6; ++i) {
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle" + std::to_string(i));
+        muscle->set_max_isometric_force(100.0 * (i + 1));
+        muscle->set_optimal_fiber_length(0.1 + 0.01 * i);
+        muscle->set_tendon_slack_length(0.2 + 0.01 * i);
+        muscle->set_pennation_angle_at_optimal(0.05 * i);
+        muscle->set_fiber_damping(0.01 * i);
+        muscle->set_ignore_tendon_compliance(i == 0 || i == 3);
+        muscle->set_tendon_compliance_dynamics_mode(
+                i % 2 ? "implicit" : "explicit");
+        muscle->set_ignore_passive_fiber_force(i == 4);
+        muscle->set_active_force_width_scale(1.0 + 0.5 * (i == 5));
+        muscle->addNewPathPoint("origin", model->updGround(),
+                SimTK::Vec3(-0.01 * i, 0.01 * i, 0));
+        muscle->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+        model->addComponent(muscle);
+    }
+    if (useGroup) {
+        auto* group = new DeGrooteFregly2016MuscleGroup();
+        group->setName("group");
+        model->addComponent(group);
+    }
+    return model;
+}
+
+TEST_CASE("DeGrooteFregly2016MuscleGroup") {
+    // The group must produce the same length, velocity, and dynamics info as
+    // the muscles on their own.
+    auto modelPtr = createDGFMusclesModel(false);
+    auto modelWithGroupPtr = createDGFMusclesModel(true);
+    const Model& model = *modelPtr;
+    const Model& modelWithGroup = *modelWithGroupPtr;
+
+    auto setState = [](const Model& model, SimTK::State& state) {
+        model.setStateVariableValue(state, "/joint/x/value", 0.4);
+        model.setStateVariableValue(state, "/joint/x/speed", -0.3);
+        for (const auto& muscle :
+                model.getComponentList<DeGrooteFregly2016Muscle>()) {
+            muscle.setActivation(state, 0.6);
+            muscle.setNormalizedTendonForce(state, 0.4);
+            if (!muscle.get_ignore_tendon_compliance() &&
+                    muscle.get_tendon_compliance_dynamics_mode() ==
+                            "implicit") {
+                muscle.setDiscreteVariableValue(state,
+                        muscle.getImplicitDynamicsDerivativeName(), 0.2);
+            }
+        }
+        model.realizeDynamics(state);
+    };
+    SimTK::State state = modelPtr->initSystem();
+    setState(model, state);
+    SimTK::State stateWithGroup = modelWithGroupPtr->initSystem();
+    setState(modelWithGroup, stateWithGroup);
+    CHECK(modelWithGroup.getComponent<DeGrooteFregly2016MuscleGroup>("/group")
+                    .getNumMuscles() == 6);
+
+    const auto compareMuscles = [&]() {
+        for (const auto& muscle :
+                model.getComponentList<DeGrooteFregly2016Muscle>()) {
+            CAPTURE(muscle.getName());
+            const auto& other = modelWithGroup.getComponent<Muscle>(
+                    muscle.getAbsolutePathString());
+            const auto& s = state;
+            const auto& sg = stateWithGroup;
+            CHECK(other.getFiberLength(sg) == Approx(muscle.getFiberLength(s)));
+            CHECK(other.getTendonLength(sg) ==
+                    Approx(muscle.getTendonLength(s)));
+            CHECK(other.getPennationAngle(sg) ==
+                    Approx(muscle.getPennationAngle(s)));
+            CHECK(other.getActiveForceLengthMultiplier(sg) ==
+                    Approx(muscle.getActiveForceLengthMultiplier(s)));
+            CHECK(other.getPassiveForceMultiplier(sg) ==
+                    Approx(muscle.getPassiveForceMultiplier(s)));
+            CHECK(other.getFiberVelocity(sg) ==
+                    Approx(muscle.getFiberVelocity(s)));
+            CHECK(other.getTendonVelocity(sg) ==
+                    Approx(muscle.getTendonVelocity(s)));
+            CHECK(other.getForceVelocityMultiplier(sg) ==
+                    Approx(muscle.getForceVelocityMultiplier(s)));
+            CHECK(other.getPennationAngularVelocity(sg) ==
+                    Approx(muscle.getPennationAngularVelocity(s)));
+            CHECK(other.getFiberForce(sg) == Approx(muscle.getFiberForce(s)));
+            CHECK(other.getTendonForce(sg) == Approx(muscle.getTendonForce(s)));
+            CHECK(other.getFiberStiffness(sg) ==
+                    Approx(muscle.getFiberStiffness(s)));
+            CHECK(other.getMuscleStiffness(sg) ==
+                    Approx(muscle.getMuscleStiffness(s)));
+            CHECK(other.getFiberActivePower(sg) ==
+                    Approx(muscle.getFiberActivePower(s)));
+        }
+    };
+    compareMuscles();
+
+    // The group evaluates only the muscles whose info is stale, such as
+    // when the info of only some muscles is invalidated.
+    const std::vector<std::string> cacheVariables{
+            "lengthInfo", "velInfo", "dynamicsInfo"};
+    int imuscle = 0;
+    for (const auto& muscle :
+            modelWithGroup.getComponentList<DeGrooteFregly2016Muscle>()) {
+        if (imuscle % 2 == 0) {
+            muscle.markCacheVariableInvalid(
+                    stateWithGroup, cacheVariables[imuscle % 3]);
+        }
+        ++imuscle;
+    }
+    compareMuscles();
+
+    CHECK(modelWithGroup.getStateVariableDerivativeValue(
+                  stateWithGroup, "/muscle2/normalized_tendon_force") ==
+            Approx(model.getStateVariableDerivativeValue(
+                    state, "/muscle2/normalized_tendon_force")));
+}
+
+TEST_CASE("DeGrooteFregly2016Muscle fiber equilibrium") {
+    auto model = createDGFMusclesModel(true);
+    SimTK::State state = model->initSystem();
+    model->setStateVariableValue(state, "/joint/x/value", 0.4);
+    model->setStateVariableValue(state, "/joint/x/speed", -0.3);
+    for (const auto& muscle :
+            model->getComponentList<DeGrooteFregly2016Muscle>()) {
+        muscle.setActivation(state, 0.6);
+    }
+    model->realizeVelocity(state);
+    SimTK::State stateGroup = state;
+
+    // Solve each muscle on its own.
+    for (const auto& muscle :
+            model->getComponentList<DeGrooteFregly2016Muscle>()) {
+        CAPTURE(muscle.getName());
+        const auto stats = muscle.solveFiberEquilibrium(state);
+        CHECK(stats.converged);
+        if (!muscle.get_ignore_tendon_compliance()) {
+            // Bisection requires about 36 iterations for this tolerance.
+            CHECK(stats.iterations < 15);
+            CHECK(std::abs(stats.residual) < 1e-6);
+        }
+    }
+
+    // Solve all muscles together.
+    const auto& group =
+            model->getComponent<DeGrooteFregly2016MuscleGroup>("/group");
+    const auto statistics = group.solveFiberEquilibria(stateGroup);
+    const auto names = group.getMuscleNames();
+    REQUIRE(statistics.size() == names.size());
+    model->realizeDynamics(state);
+    model->realizeDynamics(stateGroup);
+    for (int i = 0; i < (int)names.size(); ++i) {
+        CAPTURE(names[i]);
+        CHECK(statistics[i].converged);
+        const auto& muscle =
+                model->getComponent<DeGrooteFregly2016Muscle>(names[i]);
+        if (muscle.get_ignore_tendon_compliance()) continue;
+        CHECK(muscle.getNormalizedTendonForce(stateGroup) ==
+                Approx(muscle.getNormalizedTendonForce(state)));
+        // getEquilibriumResidual() uses the tendon compliance dynamics mode;
+        // with explicit mode, the residual is zero for any tendon force.
+        if (muscle.get_tendon_compliance_dynamics_mode() == "implicit") {
+            CHECK(muscle.getEquilibriumResidual(stateGroup) ==
+                    Approx(0).margin(1e-6));
+        }
+    }
+}
+
 TEMPLATE_TEST_CASE("Hanging muscle minimum time", "", MocoCasADiSolver) {
     auto ignoreActivationDynamics = GENERATE(true, false);
     auto ignoreTendonCompliance = GENERATE(true, false);
@@ -1282,3 +1455,69 @@ TEST_CASE("ActivationCoordinateActuator") {
     CHECK(rep.getStateInfo("/forceset/aca/activation").getBounds().getUpper() ==
             Approx(0.78));
 }
+
+TEST_CASE("SimTKMultivariatePolynomial value and gradient") {
+    for (int dimension = 1; dimension <= 4; ++dimension) {
+        for (int order : {0, 1, 3, 6}) {
+            CAPTURE(dimension, order);
+            // Enumerate the terms in the order documented for the
+            // coefficients (ascending powers, first component outermost),
+            // independently of createExponents().
+            std::vector<std::vector<int>> exponents;
+            std::vector<int> nq(dimension, 0);
+            while (true) {
+                int sum = 0;
+                for (int i = 0; i < dimension; ++i) sum += nq[i];
+                if (sum <= order) exponents.push_back(nq);
+                int i = dimension - 1;
+                while (i >= 0 && nq[i] == order) nq[i--] = 0;
+                if (i < 0) break;
+                ++nq[i];
+            }
+            const int numCoeffs = (int)exponents.size();
+            SimTK::Vector coefficients(numCoeffs);
+            for (int i = 0; i < numCoeffs; ++i) {
+                coefficients[i] = std::sin(1.3 * i + 0.2);
+            }
+            SimTKMultivariatePolynomial<double> poly(
+                    coefficients, dimension, order);
+            SimTK::Vector x(dimension);
+            for (int i = 0; i < dimension; ++i) x[i] = 0.3 + 0.2 * i;
+
+            // Evaluate each term directly with std::pow.
+            double expectedValue = 0;
+            SimTK::Vector expectedGradient(dimension, 0.0);
+            for (int icoeff = 0; icoeff < numCoeffs; ++icoeff) {
+                const auto& e = exponents[icoeff];
+                double term = coefficients[icoeff];
+                for (int i = 0; i < dimension; ++i) {
+                    term *= std::pow(x[i], e[i]);
+                }
+                expectedValue += term;
+                for (int d = 0; d < dimension; ++d) {
+                    if (e[d] == 0) continue;
+                    double derivative = e[d] * coefficients[icoeff];
+                    for (int i = 0; i < dimension; ++i) {
+                        derivative *= std::pow(x[i], i == d ? e[i] - 1 : e[i]);
+                    }
+                    expectedGradient[d] += derivative;
+                }
+            }
+
+            CHECK(poly.calcValue(x) == Approx(expectedValue).margin(1e-12));
+            SimTK::Vector gradient;
+            CHECK(poly.calcValueAndGradient(x, gradient) ==
+                    Approx(expectedValue).margin(1e-12));
+            REQUIRE(gradient.size() == dimension);
+            for (int d = 0; d < dimension; ++d) {
+                CHECK(poly.calcDerivative(std::vector<int>{d}, x) ==
+                        Approx(expectedGradient[d]).margin(1e-12));
+                CHECK(gradient[d] == Approx(expectedGradient[d]).margin(1e-12));
+            }
+        }
+    }
+    // Dimensions above 4 are not supported.
+    CHECK_THROWS_WITH(SimTKMultivariatePolynomial<double>(
+                              SimTK::Vector(6, 1.0), 5, 1),
+            Catch::Contains("Expected dimension >= 0 && <=4"));
+}
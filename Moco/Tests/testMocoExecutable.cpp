@@ -0,0 +1,151 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: testMocoExecutable.cpp                                       *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2020 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#define CATCH_CONFIG_MAIN
+#include "Testing.h"
+#include <Moco/osimMoco.h>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
+
+using namespace OpenSim;
+
+// The path to the opensim-moco executable is provided by CMake.
+#ifndef OPENSIM_MOCO_EXECUTABLE
+#error "OPENSIM_MOCO_EXECUTABLE must be defined."
+#endif
+
+std::unique_ptr<Model> createSlidingMassModel() {
+    auto model = make_unique<Model>();
+    model->setName("sliding_mass");
+    model->set_gravity(SimTK::Vec3(0, 0, 0));
+    auto* body = new Body("body", 10.0, SimTK::Vec3(0), SimTK::Inertia(0));
+    model->addComponent(body);
+
+    // Allows translation along x.
+    auto* joint = new SliderJoint("slider", model->getGround(), *body);
+    auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+    coord.setName("position");
+    model->addComponent(joint);
+
+    auto* actu = new CoordinateActuator();
+    actu->setCoordinate(&coord);
+    actu->setName("actuator");
+    actu->setOptimalForce(1);
+    model->addComponent(actu);
+
+    return model;
+}
+
+void printSlidingMassStudy(const std::string& filename) {
+    MocoStudy study;
+    study.setName("sliding_mass");
+    study.set_write_solution("false");
+    MocoProblem& mp = study.updProblem();
+    mp.setModel(createSlidingMassModel());
+    mp.setTimeBounds(0, 2);
+    mp.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
+    mp.setStateInfo("/slider/position/speed", {-100, 100}, 0, 0);
+    mp.setControlInfo("/actuator", {-10, 10});
+    mp.addGoal<MocoControlGoal>();
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(10);
+    study.print(filename);
+}
+
+/// Run opensim-moco with the given arguments and return true if the exit
+/// code is zero.
+bool runExecutable(const std::string& arguments) {
+    const std::string command =
+            "\"" + std::string(OPENSIM_MOCO_EXECUTABLE) + "\" " + arguments;
+    return std::system(command.c_str()) == 0;
+}
+
+/// Each row of the summary written by run-batch, split at tabs.
+std::vector<std::vector<std::string>> readSummary(
+        const std::string& filename) {
+    std::ifstream stream(filename);
+    REQUIRE(stream.good());
+    std::vector<std::vector<std::string>> rows;
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::vector<std::string> row;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, '\t')) row.push_back(field);
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+TEST_CASE("opensim-moco run-batch") {
+    printSlidingMassStudy("testMocoExecutable_batch_a.omoco");
+    printSlidingMassStudy("testMocoExecutable_batch_b.omoco");
+
+    SECTION("All studies succeed") {
+        {
+            std::ofstream list("testMocoExecutable_batch_list.txt");
+            list << "# Comments and blank lines are ignored.\n\n";
+            list << "testMocoExecutable_batch_b.omoco\n";
+        }
+        CHECK(runExecutable("run-batch --threads=2 --jobs=2 "
+                            "--list=testMocoExecutable_batch_list.txt "
+                            "--summary=testMocoExecutable_summary.txt "
+                            "testMocoExecutable_batch_a.omoco"));
+        const auto rows = readSummary("testMocoExecutable_summary.txt");
+        REQUIRE(rows.size() == 3);
+        CHECK(rows[0][0] == "file");
+        // Files from arguments are listed before files from --list.
+        CHECK(rows[1][0] == "testMocoExecutable_batch_a.omoco");
+        CHECK(rows[2][0] == "testMocoExecutable_batch_b.omoco");
+        for (int irow = 1; irow < 3; ++irow) {
+            REQUIRE(rows[irow].size() == 6);
+            CHECK(rows[irow][1] == "true");
+            CHECK(std::stod(rows[irow][3]) > 0);
+            CHECK(std::stoi(rows[irow][4]) > 0);
+        }
+    }
+
+    SECTION("A failed study causes a nonzero exit code") {
+        // This file does not contain a MocoStudy.
+        createSlidingMassModel()->print("testMocoExecutable_batch_c.omoco");
+        CHECK(!runExecutable("run-batch --threads=2 "
+                             "--summary=testMocoExecutable_summary.txt "
+                             "\"testMocoExecutable_batch_?.omoco\""));
+        const auto rows = readSummary("testMocoExecutable_summary.txt");
+        REQUIRE(rows.size() == 4);
+        // Files matching a pattern are sorted.
+        CHECK(rows[1][0] == "testMocoExecutable_batch_a.omoco");
+        CHECK(rows[1][1] == "true");
+        CHECK(rows[2][0] == "testMocoExecutable_batch_b.omoco");
+        CHECK(rows[2][1] == "true");
+        CHECK(rows[3][0] == "testMocoExecutable_batch_c.omoco");
+        CHECK(rows[3][1] == "false");
+        CHECK(rows[3][2].find("exception: ") == 0);
+        std::remove("testMocoExecutable_batch_c.omoco");
+    }
+
+    SECTION("Invalid arguments") {
+        CHECK(!runExecutable("run-batch --nonexistent "
+                             "testMocoExecutable_batch_a.omoco"));
+        CHECK(!runExecutable("run-batch testMocoExecutable_nonexistent_?"));
+    }
+}
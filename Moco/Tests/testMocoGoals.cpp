@@ -471,6 +471,97 @@ TEST_CASE("Test MocoSumSquaredStateGoal") {
     CHECK_THROWS(goal6->initializeOnModel(model));
 }
 
+TEST_CASE("MocoMarkerTrackingGoal") {
+    auto model = createSlidingMassModel();
+    const auto& body = model->getComponent<Body>("body");
+    model->addMarker(new Marker("m0", body, SimTK::Vec3(0)));
+    model->addMarker(new Marker("m1", body, SimTK::Vec3(0, 1, 0)));
+    model->finalizeConnections();
+    SimTK::State state = model->initSystem();
+    model->getCoordinateSet().get("position").setValue(state, 0.3);
+    state.setTime(0.55);
+    model->realizePosition(state);
+    MocoGoal::IntegrandInput input{0.55, state, {}};
+
+    // The reference contains a marker that is not in the model, and the
+    // markers are in a different order than in the model.
+    auto createReference = [](double offset) {
+        TimeSeriesTableVec3 markers;
+        markers.setColumnLabels({"extra", "m1", "m0"});
+        for (int i = 0; i < 11; ++i) {
+            const double time = 0.1 * i;
+            markers.appendRow(time, {SimTK::Vec3(5), SimTK::Vec3(time, 1, 0),
+                    SimTK::Vec3(2 * time + offset, 0, 0)});
+        }
+        Set<MarkerWeight> weights;
+        weights.cloneAndAppend({"m0", 1});
+        weights.cloneAndAppend({"m1", 10});
+        return MarkersReference(markers, weights);
+    };
+
+    MocoMarkerTrackingGoal goal;
+    goal.setMarkersReference(createReference(0));
+    CHECK_THROWS_WITH(
+            goal.initializeOnModel(*model), Catch::Contains("extra"));
+    goal.setAllowUnusedReferences(true);
+    goal.initializeOnModel(*model);
+    // m0: (0.3 - 1.1)^2 = 0.64; m1: 10 * (0.3 - 0.55)^2 = 0.625.
+    CHECK(goal.calcIntegrand(input) == Approx(1.265).margin(1e-6));
+
+    // Copies of the goal share the reference splines.
+    MocoMarkerTrackingGoal copy(goal);
+    copy.initializeOnModel(*model);
+    CHECK(copy.calcIntegrand(input) == Approx(1.265).margin(1e-6));
+
+    // A copy whose reference changed fits its own splines, and the other
+    // copies keep using the original reference.
+    MocoMarkerTrackingGoal changed(goal);
+    changed.setMarkersReference(createReference(-0.8));
+    changed.initializeOnModel(*model);
+    CHECK(changed.calcIntegrand(input) == Approx(0.625).margin(1e-6));
+    CHECK(goal.calcIntegrand(input) == Approx(1.265).margin(1e-6));
+    copy.initializeOnModel(*model);
+    CHECK(copy.calcIntegrand(input) == Approx(1.265).margin(1e-6));
+}
+
+TEST_CASE("MocoStateTrackingGoal shares reference splines") {
+    auto model = createSlidingMassModel();
+    SimTK::State state = model->initSystem();
+    model->getCoordinateSet().get("position").setValue(state, 0.3);
+    MocoGoal::IntegrandInput input{0.55, state, {}};
+
+    auto createReference = [](double offset) {
+        TimeSeriesTable ref;
+        ref.setColumnLabels({"/slider/position/value"});
+        for (int i = 0; i < 11; ++i) {
+            const double time = 0.1 * i;
+            ref.appendRow(time, SimTK::RowVector(1, 2 * time + offset));
+        }
+        return ref;
+    };
+
+    MocoStateTrackingGoal goal;
+    goal.setReference(createReference(0));
+    goal.initializeOnModel(*model);
+    // (0.3 - 1.1)^2 = 0.64.
+    CHECK(goal.calcIntegrand(input) == Approx(0.64).margin(1e-6));
+
+    MocoStateTrackingGoal copy(goal);
+    copy.initializeOnModel(*model);
+    CHECK(copy.calcIntegrand(input) == Approx(0.64).margin(1e-6));
+    CHECK(copy.calcReferenceDataHash() == goal.calcReferenceDataHash());
+
+    // A copy whose reference changed fits its own splines, and the other
+    // copies keep using the original reference.
+    MocoStateTrackingGoal changed(goal);
+    changed.setReference(createReference(0.5));
+    changed.initializeOnModel(*model);
+    // (0.3 - 1.6)^2 = 1.69.
+    CHECK(changed.calcIntegrand(input) == Approx(1.69).margin(1e-6));
+    CHECK(changed.calcReferenceDataHash() != goal.calcReferenceDataHash());
+    CHECK(goal.calcIntegrand(input) == Approx(0.64).margin(1e-6));
+}
+
 class MocoPeriodicish : public MocoGoal {
     OpenSim_DECLARE_CONCRETE_OBJECT(MocoPeriodicish, MocoGoal);
 
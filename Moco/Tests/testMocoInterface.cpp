@@ -19,7 +19,11 @@
 #define CATCH_CONFIG_MAIN
 #include "Testing.h"
 #include <Moco/osimMoco.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
+#include <set>
 
 #include <OpenSim/Actuators/BodyActuator.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
@@ -85,7 +89,8 @@ MocoStudy createSlidingMassMocoStudy() {
 TEMPLATE_TEST_CASE(
         "Non-uniform mesh", "", MocoTropterSolver, MocoCasADiSolver) {
     auto transcriptionScheme =
-            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson");
+            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson",
+                    "legendre-gauss-radau");
     MocoStudy study;
     double finalTime = 5.0;
     study.setName("sliding_mass");
@@ -96,6 +101,15 @@ TEMPLATE_TEST_CASE(
     mp.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
     mp.setStateInfo("/slider/position/speed", {-100, 100}, 0, 0);
     mp.addGoal<MocoControlGoal>();
+    // Only MocoCasADiSolver supports Legendre-Gauss-Radau transcription.
+    if (std::is_same<TestType, MocoTropterSolver>::value &&
+            transcriptionScheme == "legendre-gauss-radau") {
+        auto& ms = study.initSolver<TestType>();
+        ms.set_transcription_scheme(transcriptionScheme);
+        CHECK_THROWS_WITH(study.solve(),
+                Catch::Contains("transcription_scheme"));
+        return;
+    }
     SECTION("Ensure integral handles non-uniform mesh") {
         auto& ms = study.initSolver<TestType>();
         ms.set_transcription_scheme(transcriptionScheme);
@@ -141,6 +155,29 @@ TEMPLATE_TEST_CASE(
             }
             manualIntegral *= finalTime;
             CHECK(manualIntegral == Approx(solution.getObjective()));
+        } else if (transcriptionScheme == "legendre-gauss-radau") {
+            // The default pseudospectral degree is 3. These are the flipped
+            // Legendre-Gauss-Radau points on (0, 1] and their weights.
+            const double sqrt6 = std::sqrt(6.0);
+            const std::vector<double> points = {
+                    (4 - sqrt6) / 10, (4 + sqrt6) / 10, 1};
+            const std::vector<double> weights = {
+                    (16 - sqrt6) / 36, (16 + sqrt6) / 36, 1.0 / 9.0};
+            REQUIRE(solution.getNumTimes() == 3 * ((int)mesh.size() - 1) + 1);
+            CHECK(solution.getTime()[0] == Approx(0));
+            double manualIntegral = 0;
+            for (int i = 0; i < (int)mesh.size() - 1; ++i) {
+                const double h = mesh[i + 1] - mesh[i];
+                for (int j = 0; j < 3; ++j) {
+                    const int itime = 3 * i + j + 1;
+                    CHECK(solution.getTime()[itime] ==
+                            Approx((mesh[i] + points[j] * h) * finalTime));
+                    manualIntegral +=
+                            weights[j] * h * square(u.getElt(itime, 0));
+                }
+            }
+            manualIntegral *= finalTime;
+            CHECK(manualIntegral == Approx(solution.getObjective()));
         }
     }
 
@@ -257,6 +294,48 @@ TEMPLATE_TEST_CASE("Solver options", "", MocoTropterSolver, MocoCasADiSolver) {
     }
 }
 
+TEMPLATE_TEST_CASE("Solver timings", "", MocoTropterSolver, MocoCasADiSolver) {
+    MocoStudy study = createSlidingMassMocoStudy<TestType>();
+    MocoSolution solution = study.solve();
+    solution.unseal();
+    REQUIRE(solution.getNumTimings() > 0);
+    const auto names = solution.getTimingNames();
+    CHECK(names.size() == (size_t)solution.getNumTimings());
+    bool foundGoal = false;
+    for (const auto& name : names) {
+        CHECK(solution.getTimingNumEvaluations(name) > 0);
+        CHECK(solution.getTimingDuration(name) >= 0);
+        if (name.find("cost_") == 0) foundGoal = true;
+    }
+    CHECK(foundGoal);
+    CHECK_THROWS(solution.getTimingDuration("nonexistent"));
+
+    SECTION("Goal profiling") {
+        auto& solver = study.updSolver<TestType>();
+        solver.set_profile_goals(true);
+        MocoSolution profiled = study.solve();
+        profiled.unseal();
+        // The sliding mass problem has a single goal with the default name.
+        const std::string section = "goal_goal_endpoint";
+        CHECK(profiled.getTimingNumEvaluations(section) > 0);
+        CHECK(profiled.getTimingDuration(section) >= 0);
+        // MocoFinalTimeGoal does not realize the state.
+        CHECK(profiled.getTimingMaxStage(section) <= SimTK::Stage::Time);
+
+        // The solver realizes the state to the goal's stage dependency
+        // before evaluating the goal; this is part of the profile.
+        auto* accel = study.updProblem().addGoal<MocoOutputGoal>("accel", 1e-3);
+        accel->setOutputPath("/slider/position|acceleration");
+        MocoSolution profiledAccel = study.solve();
+        profiledAccel.unseal();
+        const std::string accelSection = "goal_accel_integrand";
+        CHECK(profiledAccel.getTimingNumEvaluations(accelSection) > 0);
+        CHECK(profiledAccel.getTimingDuration(accelSection) > 0);
+        CHECK(profiledAccel.getTimingMaxStage(accelSection) ==
+                SimTK::Stage::Acceleration);
+    }
+}
+
 /*
 
 TEST_CASE("Ordering of calls") {
@@ -1319,6 +1398,31 @@ TEST_CASE("MocoTrajectory") {
         SimTK_TEST(deserialized.isNumericallyEqual(orig));
     }
 
+    // Reading and writing the binary format.
+    {
+        const std::string fname = "testMocoInterface_testMocoTrajectory.traj";
+        SimTK::Vector time(3);
+        time[0] = 0;
+        time[1] = 0.1;
+        time[2] = 0.25;
+        MocoTrajectory orig(time, {"a", "b"}, {"g", "h", "i", "j"}, {"m"},
+                {"d0", "d1"}, {"o", "p"}, SimTK::Test::randMatrix(3, 2),
+                SimTK::Test::randMatrix(3, 4), SimTK::Test::randMatrix(3, 1),
+                SimTK::Test::randMatrix(3, 2),
+                SimTK::Test::randVector(2).transpose());
+        orig.write(fname);
+
+        MocoTrajectory deserialized(fname);
+        // The binary format does not lose precision.
+        SimTK_TEST(deserialized.isNumericallyEqual(orig, 0));
+
+        // Converting between the formats.
+        deserialized.write("testMocoInterface_testMocoTrajectory_fromtraj.sto");
+        MocoTrajectory fromText(
+                "testMocoInterface_testMocoTrajectory_fromtraj.sto");
+        SimTK_TEST(fromText.isNumericallyEqual(orig));
+    }
+
     {
         const std::string fname =
                 "testMocoInterface_testMocoSolutionSuccess.sto";
@@ -1988,6 +2092,447 @@ TEST_CASE("Objective breakdown") {
     CHECK(solution.getObjectiveTerm("goal_b") == Approx(0.01 * 7.3));
 }
 
+TEST_CASE("MocoCasADiSolver reuse_transcription") {
+    // Transcribing the problem is timed in the "nlp_setup" section, which is
+    // absent from the timings if the transcription was reused.
+    const auto transcribed = [](MocoSolution solution) {
+        solution.unseal();
+        const auto names = solution.getTimingNames();
+        return std::find(names.begin(), names.end(), "nlp_setup") !=
+               names.end();
+    };
+    MocoStudy study;
+    study.set_write_solution("false");
+    auto& problem = study.updProblem();
+    problem.setModel(createSlidingMassModel());
+    problem.setTimeBounds(0, {0, 5});
+    problem.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
+    problem.setStateInfo("/slider/position/speed", {-100, 100}, 0, 0);
+    problem.setControlInfo("/actuator", {-10, 10});
+    problem.addGoal<MocoFinalTimeGoal>("time");
+    problem.addGoal<MocoControlGoal>("effort");
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(20);
+    solver.set_reuse_transcription(true);
+    MocoSolution initial = study.solve();
+    REQUIRE(initial.success());
+    CHECK(transcribed(initial));
+
+    // Change only a goal weight and a bound; the NLP is solved again without
+    // re-transcribing.
+    problem.updGoal("effort").setWeight(0.1);
+    problem.setControlInfo("/actuator", {-5, 5});
+    MocoSolution reused = study.solve();
+    REQUIRE(reused.success());
+    CHECK(!transcribed(reused));
+    CHECK(SimTK::max(SimTK::abs(reused.getControl("/actuator"))) <=
+            5 + 1e-6);
+
+    // Solving from scratch gives the same solution.
+    solver.set_reuse_transcription(false);
+    MocoSolution fromScratch = study.solve();
+    CHECK(transcribed(fromScratch));
+    CHECK(reused.getObjective() == Approx(fromScratch.getObjective()));
+    CHECK(reused.getObjectiveTerm("effort") ==
+            Approx(fromScratch.getObjectiveTerm("effort")));
+    CHECK(reused.isNumericallyEqual(fromScratch, 1e-6));
+
+    SECTION("Reference data provided in memory") {
+        // The goal's properties do not change if only the data in a table
+        // provided in memory changes, but the NLP must be transcribed again.
+        const auto createReference = [](double position) {
+            TimeSeriesTable table(std::vector<double>{0, 5});
+            table.appendColumn("/slider/position/value",
+                    SimTK::Vector(2, position));
+            return table;
+        };
+        auto* tracking = problem.addGoal<MocoStateTrackingGoal>("tracking");
+        tracking->setReference(createReference(0.5));
+        solver.set_reuse_transcription(true);
+        MocoSolution first = study.solve();
+        REQUIRE(first.success());
+        CHECK(transcribed(first));
+        CHECK(!transcribed(study.solve()));
+
+        tracking->setReference(createReference(0.25));
+        MocoSolution changed = study.solve();
+        REQUIRE(changed.success());
+        CHECK(transcribed(changed));
+        solver.set_reuse_transcription(false);
+        CHECK(changed.getObjective() ==
+                Approx(study.solve().getObjective()).epsilon(1e-6));
+    }
+}
+
+TEST_CASE("MocoCasADiSolver jit_transcription") {
+    auto transcriptionScheme =
+            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson");
+    MocoStudy study;
+    study.set_write_solution("false");
+    auto& problem = study.updProblem();
+    problem.setModel(createSlidingMassModel());
+    problem.setTimeBounds(0, {0, 5});
+    problem.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
+    problem.setStateInfo("/slider/position/speed", {-100, 100}, 0, 0);
+    problem.setControlInfo("/actuator", {-10, 10});
+    problem.addGoal<MocoFinalTimeGoal>();
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(20);
+    solver.set_transcription_scheme(transcriptionScheme);
+    MocoSolution expected = study.solve();
+    solver.set_jit_transcription(true);
+    MocoSolution solution = study.solve();
+    REQUIRE(solution.success());
+    CHECK(solution.getObjective() == Approx(expected.getObjective()));
+    CHECK(solution.isNumericallyEqual(expected, 1e-6));
+}
+
+TEST_CASE("MocoCasADiSolver Legendre-Gauss-Radau transcription") {
+    // Move the sliding mass a unit distance in a fixed time while minimizing
+    // effort. The optimal force is linear in time and the position is cubic,
+    // so a degree-3 pseudospectral transcription is exact with only a couple
+    // mesh intervals.
+    const double mass = 10.0;
+    const double T = 4.0;
+    MocoStudy study;
+    study.set_write_solution("false");
+    auto& problem = study.updProblem();
+    problem.setModel(createSlidingMassModel());
+    problem.setTimeBounds(0, T);
+    problem.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
+    problem.setStateInfo("/slider/position/speed", {-100, 100}, 0, 0);
+    problem.setControlInfo("/actuator", {-10, 10});
+    problem.addGoal<MocoControlGoal>();
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(2);
+    solver.set_transcription_scheme("legendre-gauss-radau");
+    solver.set_pseudospectral_degree(3);
+    MocoSolution solution = study.solve();
+    REQUIRE(solution.success());
+
+    // 1 initial point plus 3 collocation points per mesh interval.
+    REQUIRE(solution.getNumTimes() == 7);
+    CHECK(solution.getTime()[3] == Approx(0.5 * T));
+    CHECK(solution.getObjective() == Approx(12 * mass * mass / pow(T, 3)));
+
+    const auto& time = solution.getTime();
+    const auto position = solution.getState("/slider/position/value");
+    const auto force = solution.getControl("/actuator");
+    for (int itime = 0; itime < solution.getNumTimes(); ++itime) {
+        const double s = time[itime] / T;
+        CHECK(position[itime] ==
+                Approx(3 * pow(s, 2) - 2 * pow(s, 3)).margin(1e-6));
+        // The control at the initial time is extrapolated from the
+        // collocation points of the first mesh interval.
+        CHECK(force[itime] ==
+                Approx(mass / pow(T, 2) * (6 - 12 * s)).margin(1e-5));
+    }
+
+    // The degree must be at least 1.
+    solver.set_pseudospectral_degree(0);
+    CHECK_THROWS_WITH(study.solve(),
+            Catch::Contains("pseudospectral_degree"));
+}
+
+TEST_CASE("MocoCasADiSolver multiple-shooting transcription") {
+    // The minimum-time solution is bang-bang with a switch at the midpoint of
+    // the motion. With an even number of mesh intervals, the switch lies on a
+    // mesh point, so piecewise-constant controls represent the solution
+    // exactly.
+    MocoStudy study;
+    study.set_write_solution("false");
+    auto& problem = study.updProblem();
+    problem.setModel(createSlidingMassModel());
+    problem.setTimeBounds(0, {0, 5});
+    problem.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
+    problem.setStateInfo("/slider/position/speed", {-100, 100}, 0, 0);
+    problem.setControlInfo("/actuator", {-10, 10});
+    problem.addGoal<MocoFinalTimeGoal>();
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(10);
+    solver.set_transcription_scheme("multiple-shooting");
+    solver.set_parallel(2);
+    MocoSolution solution = study.solve();
+    REQUIRE(solution.success());
+    REQUIRE(solution.getNumTimes() == 11);
+    CHECK(solution.getFinalTime() == Approx(2.0).epsilon(1e-4));
+
+    const auto& time = solution.getTime();
+    const auto position = solution.getState("/slider/position/value");
+    const auto speed = solution.getState("/slider/position/speed");
+    const auto force = solution.getControl("/actuator");
+    for (int itime = 0; itime < solution.getNumTimes(); ++itime) {
+        const double t = time[itime];
+        const double expectedPos =
+                t < 1 ? 0.5 * pow(t, 2) : -0.5 * pow(t - 1, 2) + (t - 1) + 0.5;
+        CHECK(position[itime] == Approx(expectedPos).margin(1e-3));
+        CHECK(speed[itime] == Approx(t < 1 ? t : 2 - t).margin(1e-3));
+        // The control at the final time does not affect the problem.
+        if (itime < solution.getNumTimes() - 1) {
+            CHECK(force[itime] == Approx(t < 1 - 1e-6 ? 10 : -10).margin(1e-3));
+        }
+    }
+
+    // The integration uses a fixed number of steps, so solving again gives
+    // the same solution.
+    MocoSolution solution2 = study.solve();
+    CHECK(solution2.getNumIterations() == solution.getNumIterations());
+    CHECK(solution2.isNumericallyEqual(solution));
+
+    solver.set_shooting_integrator_num_steps(0);
+    CHECK_THROWS_WITH(study.solve(),
+            Catch::Contains("shooting_integrator_num_steps"));
+    solver.set_shooting_integrator_num_steps(10);
+
+    solver.set_multibody_dynamics_mode("implicit");
+    CHECK_THROWS_WITH(study.solve(), Catch::Contains("Implicit dynamics"));
+}
+
+TEST_CASE("MocoStudy solveMultiStart") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_parallel(2);
+
+    SECTION("Random guesses are reproducible") {
+        CHECK(solver.createRandomGuess(1).isNumericallyEqual(
+                solver.createRandomGuess(1)));
+        CHECK(!solver.createRandomGuess(1).isNumericallyEqual(
+                solver.createRandomGuess(2)));
+    }
+
+    SECTION("Random guesses are within the bounds") {
+        const MocoTrajectory guess = solver.createRandomGuess(1);
+        const MocoTrajectory boundsGuess = solver.createGuess("bounds");
+        CHECK(guess.getStateNames() == boundsGuess.getStateNames());
+        CHECK(guess.getControlNames() == boundsGuess.getControlNames());
+        REQUIRE(guess.getNumTimes() == 20);
+        CHECK(guess.getInitialTime() == 0);
+        CHECK(guess.getFinalTime() >= 0);
+        CHECK(guess.getFinalTime() <= 10);
+        const auto position = guess.getState("/slider/position/value");
+        const auto speed = guess.getState("/slider/position/speed");
+        CHECK(position[0] == 0);
+        CHECK(position[19] == 1);
+        CHECK(speed[0] == 0);
+        CHECK(speed[19] == 0);
+        for (int itime = 1; itime < 19; ++itime) {
+            CHECK(position[itime] >= 0);
+            CHECK(position[itime] <= 1);
+            CHECK(std::abs(speed[itime]) <= 100);
+        }
+    }
+
+    SECTION("Solutions are ranked") {
+        const bool cancelStragglers = GENERATE(true, false);
+        std::vector<MocoSolution> solutions =
+                study.solveMultiStart(3, cancelStragglers);
+        REQUIRE(solutions.size() == 3);
+        REQUIRE(solutions[0].success());
+        for (int i = 1; i < (int)solutions.size(); ++i) {
+            if (solutions[i].success()) {
+                CHECK(solutions[i - 1].success());
+                CHECK(solutions[i - 1].getObjective() <=
+                        solutions[i].getObjective());
+            }
+        }
+        MocoSolution expected = study.solve();
+        CHECK(solutions[0].getObjective() ==
+                Approx(expected.getObjective()).epsilon(1e-4));
+    }
+
+    SECTION("Cancellation settings") {
+        // Without a grace period or margin, every start that does not improve
+        // on the best converged objective can be cancelled, but the best
+        // start still converges.
+        std::vector<MocoSolution> solutions =
+                study.solveMultiStart(3, true, 0, 0.0);
+        REQUIRE(solutions.size() == 3);
+        CHECK(solutions[0].success());
+        CHECK_THROWS_WITH(study.solveMultiStart(3, true, -1),
+                Catch::Contains("cancelGracePeriod"));
+        CHECK_THROWS_WITH(study.solveMultiStart(3, true, 20, -0.1),
+                Catch::Contains("cancelMargin"));
+    }
+
+    SECTION("Starts that throw are omitted") {
+        // Giving each start its copy of the problem throws, since the state
+        // does not exist.
+        study.updProblem().setStateInfo("/nonexistent", {0, 1});
+        CHECK(study.solveMultiStart(2).empty());
+    }
+
+    SECTION("Only supported with MocoCasADiSolver") {
+        study.initTropterSolver();
+        CHECK_THROWS_WITH(study.solveMultiStart(2),
+                Catch::Contains("only supported with MocoCasADiSolver"));
+    }
+}
+
+
+std::atomic<int> numCountingModelOperatorCalls(0);
+
+/// Counts the number of times that the model is processed.
+class CountingModelOperator : public ModelOperator {
+    OpenSim_DECLARE_CONCRETE_OBJECT(CountingModelOperator, ModelOperator);
+
+public:
+    void operate(Model&, const std::string&) const override {
+        ++numCountingModelOperatorCalls;
+    }
+};
+
+TEST_CASE("MocoSolver createProblemRepJar") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    study.updProblem().setModelProcessor(
+            ModelProcessor(*createSlidingMassModel()) |
+            CountingModelOperator());
+    numCountingModelOperatorCalls = 0;
+    const auto& solver = study.updSolver();
+    const int size = 5;
+    auto jar = solver.createProblemRepJar(size);
+    CHECK(jar->size() == 1);
+    CHECK(jar->getCapacity() == size);
+    CHECK(jar->getNumCreated() == 1);
+    // Reps are created only when all existing reps are in use.
+    for (int i = 0; i < 3; ++i) {
+        auto rep = jar->take();
+        jar->leave(std::move(rep));
+    }
+    CHECK(jar->getNumCreated() == 1);
+    std::vector<std::unique_ptr<const MocoProblemRep>> reps;
+    std::set<const Model*> models;
+    for (int i = 0; i < size; ++i) {
+        reps.push_back(jar->take());
+        CHECK(reps.back()->getNumStates() == 2);
+        models.insert(&reps.back()->getModelBase());
+    }
+    CHECK(jar->getNumCreated() == size);
+    // Each rep has its own model, but the model was processed only once.
+    CHECK((int)models.size() == size);
+    CHECK(numCountingModelOperatorCalls == 1);
+    for (auto& rep : reps) jar->leave(std::move(rep));
+    CHECK(jar->size() == size);
+    CHECK(jar->getHighWaterMark() == size);
+}
+
+TEST_CASE("BackgroundProcessor") {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<int> processed;
+    bool started = false;
+    bool open = true;
+    BackgroundProcessor<int> processor([&](int& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        started = true;
+        condition.notify_all();
+        condition.wait(lock, [&] { return open; });
+        OPENSIM_THROW_IF(item < 0, Exception, "Negative item.");
+        processed.push_back(item);
+    }, 4);
+
+    SECTION("Items are processed in order") {
+        for (int i = 0; i < 3; ++i) processor.push(i);
+        CHECK(processor.flush() == 0);
+        CHECK(processed == std::vector<int>{0, 1, 2});
+        CHECK(!processor.takeException());
+    }
+
+    SECTION("Oldest pending items are dropped") {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            open = false;
+        }
+        processor.push(0);
+        {
+            // Item 0 is no longer pending once its processing starts.
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&] { return started; });
+        }
+        for (int i = 1; i <= 6; ++i) processor.push(i);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            open = true;
+        }
+        condition.notify_all();
+        CHECK(processor.flush() == 2);
+        CHECK(processed == std::vector<int>{0, 3, 4, 5, 6});
+        CHECK(processor.flush() == 0);
+    }
+
+    SECTION("Exceptions are rethrown") {
+        processor.push(-1);
+        processor.flush();
+        CHECK_THROWS_AS(processor.push(1), Exception);
+        // The exception is thrown only once.
+        processor.push(2);
+        CHECK(processor.flush() == 0);
+        CHECK(processed == std::vector<int>{2});
+
+        processor.push(-1);
+        processor.flush();
+        auto exception = processor.takeException();
+        REQUIRE(exception);
+        CHECK_THROWS_AS(std::rethrow_exception(exception), Exception);
+        CHECK(!processor.takeException());
+    }
+}
+
+TEST_CASE("MocoCasADiSolver output_interval") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_num_mesh_intervals(10);
+    solver.set_output_interval(1);
+    MocoSolution solution = study.solve();
+    solution.unseal();
+    // Iterates are written on a separate thread, and the solve waits for all
+    // of them to be written.
+    const auto numWritten =
+            solution.getTimingNumEvaluations("write_intermediate_iterates");
+    CHECK(numWritten > 0);
+    CHECK(numWritten <= solution.getNumIterations() + 1);
+}
+
+namespace {
+std::atomic<int> g_numPositionRealizations(0);
+std::atomic<int> g_numDynamicsRealizations(0);
+} // anonymous namespace
+
+/// Counts the number of times the Position and Dynamics stages are realized.
+class RealizationCounter : public ModelComponent {
+    OpenSim_DECLARE_CONCRETE_OBJECT(RealizationCounter, ModelComponent);
+
+public:
+    void extendRealizePosition(const SimTK::State& s) const override {
+        Super::extendRealizePosition(s);
+        ++g_numPositionRealizations;
+    }
+    void extendRealizeDynamics(const SimTK::State& s) const override {
+        Super::extendRealizeDynamics(s);
+        ++g_numDynamicsRealizations;
+    }
+};
+
+TEST_CASE("MocoCasADiSolver reuses Position stage across perturbations") {
+    // When the solver finite-differences the dynamics with respect to speeds
+    // or controls, the time and coordinates are unchanged, so the Position
+    // stage need not be realized again. Previously, every evaluation of the
+    // dynamics realized the Position stage.
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& problem = study.updProblem();
+    auto model = createSlidingMassModel();
+    model->addComponent(new RealizationCounter());
+    problem.setModel(std::move(model));
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_num_mesh_intervals(10);
+    solver.set_parallel(0);
+    solver.set_optim_max_iterations(5);
+
+    g_numPositionRealizations = 0;
+    g_numDynamicsRealizations = 0;
+    study.solve();
+    CHECK(g_numPositionRealizations > 0);
+    CHECK(g_numPositionRealizations < g_numDynamicsRealizations);
+}
 
 /*
 TEMPLATE_TEST_CASE("Controllers in the model", "",
@@ -115,6 +115,51 @@ TEST_CASE("PrescribedKinematics direct collocation auxiliary dynamics") {
             0.2 * SimTK::exp(solution.getTime()), 1e-4);
 }
 
+TEST_CASE("PrescribedKinematics at the initial time") {
+    // The solver must prescribe the kinematics for states that are evaluated
+    // at the state's default time (0) before being evaluated at any other
+    // time.
+    Model model = ModelFactory::createPendulum();
+    auto* motion = new PositionMotion();
+    const double c2 = 1.3;
+    const double c1 = 0.17;
+    const double c0 = 0.81;
+    motion->setPositionForCoordinate(model.getCoordinateSet().get(0),
+            PolynomialFunction(createVector({c2, c1, c0})));
+    model.addModelComponent(motion);
+    model.finalizeConnections();
+
+    MocoStudy study;
+    auto& problem = study.updProblem();
+    problem.setModelCopy(model);
+    problem.setTimeBounds(0, 1);
+    problem.setControlInfo("/tau0", {-100, 100});
+    problem.addGoal<MocoControlGoal>();
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(5);
+    solver.set_transcription_scheme("trapezoidal");
+    solver.set_multibody_dynamics_mode("implicit");
+    MocoSolution solution = study.solve();
+
+    // The actuator must supply the inverse dynamics torque.
+    auto state = model.initSystem();
+    const auto& matter = model.getMatterSubsystem();
+    const auto& system = model.getMultibodySystem();
+    const auto& time = solution.getTime();
+    const auto control = solution.getControl("/tau0");
+    for (int itime = 0; itime < solution.getNumTimes(); ++itime) {
+        state.setTime(time[itime]);
+        system.prescribe(state);
+        model.realizeDynamics(state);
+        SimTK::Vector residual;
+        matter.calcResidualForceIgnoringConstraints(state,
+                system.getMobilityForces(state, SimTK::Stage::Dynamics),
+                system.getRigidBodyForces(state, SimTK::Stage::Dynamics),
+                SimTK::Vector(1, 2 * c2), residual);
+        CHECK(control[itime] == Approx(residual[0]).margin(1e-6));
+    }
+}
+
 TEST_CASE("MocoInverse Rajagopal2016, 18 muscles") {
 
     MocoInverse inverse;
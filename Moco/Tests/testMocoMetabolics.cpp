@@ -605,3 +605,78 @@ TEST_CASE("Bhargava2004Metabolics basics") {
 
     }
 }
+
+TEST_CASE("Bhargava2004Metabolics multiple muscles") {
+    // The rates computed for a component with multiple muscles must match
+    // those of components with one muscle each.
+    Model model;
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model.addComponent(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+    coord.setName("x");
+    model.addComponent(joint);
+    auto* all = new Bhargava2004Metabolics();
+    all->setName("all");
+    all->set_use_smoothing(true);
+    const int numMuscles = 3;
+    for (int i = 0; i < numMuscles; ++i) {
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle" + std::to_string(i));
+        muscle->set_max_isometric_force(100.0 * (i + 1));
+        muscle->set_optimal_fiber_length(0.1 + 0.02 * i);
+        muscle->set_tendon_slack_length(0.2);
+        muscle->set_ignore_tendon_compliance(true);
+        muscle->addNewPathPoint("origin", model.updGround(),
+                SimTK::Vec3(-0.02 * i, 0, 0));
+        muscle->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+        model.addComponent(muscle);
+        all->addMuscle(muscle->getName(), *muscle, 0.3 + 0.2 * i, 0.25e6);
+        auto* single = new Bhargava2004Metabolics();
+        single->setName("single" + std::to_string(i));
+        single->set_use_smoothing(true);
+        single->addMuscle(muscle->getName(), *muscle, 0.3 + 0.2 * i, 0.25e6);
+        model.addComponent(single);
+    }
+    model.addComponent(all);
+    model.finalizeConnections();
+
+    SimTK::State state = model.initSystem();
+    coord.setValue(state, 0.32);
+    coord.setSpeedValue(state, -0.2);
+    for (const auto& muscle :
+            model.getComponentList<DeGrooteFregly2016Muscle>()) {
+        muscle.setActivation(state, 0.6);
+    }
+    SimTK::Vector& controls(model.updControls(state));
+    controls = 0.7;
+    model.setControls(state, controls);
+    model.realizeDynamics(state);
+
+    const auto& allMetabolics =
+            model.getComponent<Bhargava2004Metabolics>("all");
+    CHECK(allMetabolics.getNumMetabolicMuscles() == numMuscles);
+    double totalActivationRate = 0;
+    double totalMaintenanceRate = 0;
+    double totalShorteningRate = 0;
+    double totalMechanicalWorkRate = 0;
+    for (int i = 0; i < numMuscles; ++i) {
+        const auto& single = model.getComponent<Bhargava2004Metabolics>(
+                "single" + std::to_string(i));
+        const std::string path = "/muscle" + std::to_string(i);
+        CHECK(allMetabolics.getMuscleMetabolicRate(state, path) ==
+                Approx(single.getMuscleMetabolicRate(state, path)));
+        totalActivationRate += single.getTotalActivationRate(state);
+        totalMaintenanceRate += single.getTotalMaintenanceRate(state);
+        totalShorteningRate += single.getTotalShorteningRate(state);
+        totalMechanicalWorkRate += single.getTotalMechanicalWorkRate(state);
+    }
+    CHECK(allMetabolics.getTotalActivationRate(state) ==
+            Approx(totalActivationRate));
+    CHECK(allMetabolics.getTotalMaintenanceRate(state) ==
+            Approx(totalMaintenanceRate));
+    CHECK(allMetabolics.getTotalShorteningRate(state) ==
+            Approx(totalShorteningRate));
+    CHECK(allMetabolics.getTotalMechanicalWorkRate(state) ==
+            Approx(totalMechanicalWorkRate));
+}
@@ -99,6 +99,32 @@ TEMPLATE_TEST_CASE("Oscillator mass", "", MocoTropterSolver, MocoCasADiSolver) {
     CHECK(sol.getParameter("oscillator_mass") == Approx(MASS).epsilon(0.003));
 }
 
+TEST_CASE("Applying unchanged parameter values") {
+    MocoProblem mp;
+    mp.setModel(createOscillatorModel());
+    mp.setTimeBounds(0, FINAL_TIME);
+    mp.addParameter("oscillator_mass", "body", "mass", MocoBounds(0, 10));
+    const auto rep = mp.createRep();
+    const auto& body =
+            rep.getModelDisabledConstraints().getComponent<Body>("/body");
+
+    SimTK::Vector values(1, MASS);
+    rep.applyParametersToModelProperties(values, true);
+    CHECK(body.getMass() == MASS);
+    auto& state = rep.updStateDisabledConstraints();
+    state.updQ()[0] = 0.3;
+
+    // The models already reflect these values, so initSystem() is not
+    // invoked and the state is not reset.
+    rep.applyParametersToModelProperties(values, true);
+    CHECK(state.getQ()[0] == 0.3);
+
+    values[0] = 2 * MASS;
+    rep.applyParametersToModelProperties(values, true);
+    CHECK(body.getMass() == 2 * MASS);
+    CHECK(rep.updStateDisabledConstraints().getQ()[0] == 0);
+}
+
 std::unique_ptr<Model> createOscillatorTwoSpringsModel() {
     auto model = make_unique<Model>();
     model->setName("oscillator_two_springs");
@@ -23,7 +23,9 @@
 
 #include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
 #include <OpenSim/Analyses/MuscleAnalysis.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+#include <fstream>
 
 using namespace OpenSim;
 
@@ -77,6 +79,121 @@ TEST_CASE("ModelProcessor") {
     }
 }
 
+int numCountingModelOperatorCalls = 0;
+
+TEST_CASE("ModelProcessor cache") {
+    class CountingModelOperator : public ModelOperator {
+        OpenSim_DECLARE_CONCRETE_OBJECT(CountingModelOperator, ModelOperator);
+
+    public:
+        bool isCacheable() const override { return true; }
+        void operate(Model& model, const std::string&) const override {
+            ++numCountingModelOperatorCalls;
+            model.addAnalysis(new MuscleAnalysis());
+        }
+    };
+    Object::registerType(CountingModelOperator());
+    ModelProcessor::clearCache();
+    numCountingModelOperatorCalls = 0;
+
+    Model model = ModelFactory::createPendulum();
+    model.print("testModelProcessor_cache_model.osim");
+    ModelProcessor proc =
+            ModelProcessor("testModelProcessor_cache_model.osim") |
+            CountingModelOperator();
+
+    SECTION("Off by default") {
+        proc.process();
+        proc.process();
+        CHECK(numCountingModelOperatorCalls == 2);
+    }
+
+    SECTION("In memory") {
+        proc.set_cache_in_memory(true);
+        CHECK(proc.process().getAnalysisSet().getSize() == 1);
+        CHECK(numCountingModelOperatorCalls == 1);
+        // A copy of the processor uses the same cache.
+        ModelProcessor procCopy(proc);
+        Model cached = procCopy.process();
+        CHECK(numCountingModelOperatorCalls == 1);
+        CHECK(cached.getAnalysisSet().getSize() == 1);
+        cached.initSystem();
+
+        // Changing the source file invalidates the cache.
+        model.setName("modified");
+        model.print("testModelProcessor_cache_model.osim");
+        CHECK(proc.process().getName() == "modified");
+        CHECK(numCountingModelOperatorCalls == 2);
+
+        // The directory used to locate files is part of the key.
+        proc.process(IO::getCwd());
+        CHECK(numCountingModelOperatorCalls == 3);
+
+        // Models are not cached if any operator is not cacheable, since
+        // operators may depend on more than their properties.
+        class MyModelOperator : public ModelOperator {
+            OpenSim_DECLARE_CONCRETE_OBJECT(MyModelOperator, ModelOperator);
+
+        public:
+            void operate(Model&, const std::string&) const override {}
+        };
+        ModelProcessor procNotCacheable(proc);
+        procNotCacheable.append(MyModelOperator());
+        procNotCacheable.process();
+        procNotCacheable.process();
+        CHECK(numCountingModelOperatorCalls == 5);
+
+        // Caching can be disabled.
+        proc.set_cache_in_memory(false);
+        proc.process();
+        CHECK(numCountingModelOperatorCalls == 6);
+    }
+
+    SECTION("Files referenced by the model") {
+        // Any element whose value names an existing file counts as a
+        // reference.
+        {
+            std::ofstream notes("testModelProcessor_cache_notes.txt");
+            notes << "first" << std::endl;
+        }
+        model.set_credits("testModelProcessor_cache_notes.txt");
+        model.print("testModelProcessor_cache_model.osim");
+        proc.set_cache_in_memory(true);
+        proc.set_cache_directory("testModelProcessor_cache");
+        proc.process();
+        proc.process();
+        CHECK(numCountingModelOperatorCalls == 1);
+
+        // Editing the referenced file invalidates the cache.
+        {
+            std::ofstream notes("testModelProcessor_cache_notes.txt");
+            notes << "second" << std::endl;
+        }
+        proc.process();
+        CHECK(numCountingModelOperatorCalls == 2);
+
+        // The model is not cached on disk, since loading it from the cache
+        // directory would resolve the reference from the wrong directory.
+        ModelProcessor::clearCache();
+        proc.process();
+        CHECK(numCountingModelOperatorCalls == 3);
+    }
+
+    SECTION("On disk") {
+        // Avoid using a cache file from a previous run of this test.
+        model.setName(getMocoFormattedDateTime(true));
+        model.print("testModelProcessor_cache_model.osim");
+        proc.set_cache_in_memory(false);
+        proc.set_cache_directory("testModelProcessor_cache");
+        proc.process();
+        CHECK(numCountingModelOperatorCalls == 1);
+        Model cached = proc.process();
+        CHECK(numCountingModelOperatorCalls == 1);
+        CHECK(cached.getAnalysisSet().getSize() == 1);
+        cached.initSystem();
+    }
+}
+
 TEST_CASE("ModOpRemoveMuscles") {
     Model model;
     using SimTK::Vec3;
@@ -105,3 +222,63 @@ TEST_CASE("ModOpRemoveMuscles") {
     CHECK(processedModel.countNumComponents<Millard2012EquilibriumMuscle>() ==
             0);
 }
+
+TEST_CASE("ModOpReplacePathsWithPolynomials") {
+    Model model;
+    using SimTK::Vec3;
+    auto* body = new OpenSim::Body("body", 1, Vec3(0), SimTK::Inertia(1));
+    auto* joint = new PinJoint("joint",
+            model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0, 1, 0), Vec3(0));
+    auto& coord = joint->updCoordinate();
+    coord.setName("angle");
+    coord.setRangeMin(0);
+    coord.setRangeMax(1.5);
+
+    auto* muscle = new DeGrooteFregly2016Muscle();
+    muscle->setName("muscle");
+    muscle->set_ignore_tendon_compliance(true);
+    muscle->set_optimal_fiber_length(0.25);
+    muscle->set_tendon_slack_length(0.1);
+    muscle->addNewPathPoint("origin", model.getGround(), Vec3(0.1, 0.2, 0));
+    muscle->addNewPathPoint("insertion", *body, Vec3(0.1, 0.7, 0));
+
+    model.addBody(body);
+    model.addJoint(joint);
+    model.addForce(muscle);
+    model.finalizeConnections();
+
+    ModelProcessor proc = ModelProcessor(model) |
+                          ModOpReplacePathsWithPolynomials(5, 11);
+    Model polyModel = proc.process();
+    const auto& polyMuscle = polyModel.getComponent<Muscle>("/muscle");
+    const auto* polyPath = dynamic_cast<const PolynomialGeometryPath*>(
+            &polyMuscle.getGeometryPath());
+    REQUIRE(polyPath);
+    REQUIRE(polyPath->getProperty_coordinate_paths().size() == 1);
+    CHECK(polyPath->get_coordinate_paths(0) == "/jointset/joint/angle");
+
+    SimTK::State state = model.initSystem();
+    SimTK::State polyState = polyModel.initSystem();
+    const auto& polyCoord = polyModel.getCoordinateSet().get("angle");
+    for (const double angle : {0.1, 0.55, 1.05, 1.4}) {
+        CAPTURE(angle);
+        coord.setValue(state, angle);
+        coord.setSpeedValue(state, -0.8);
+        muscle->setActivation(state, 0.5);
+        polyCoord.setValue(polyState, angle);
+        polyCoord.setSpeedValue(polyState, -0.8);
+        polyMuscle.setActivation(polyState, 0.5);
+        model.realizeAcceleration(state);
+        polyModel.realizeAcceleration(polyState);
+        CHECK(polyMuscle.getLength(polyState) ==
+                Approx(muscle->getLength(state)).margin(1e-6));
+        CHECK(polyMuscle.getLengtheningSpeed(polyState) ==
+                Approx(muscle->getLengtheningSpeed(state)).margin(1e-5));
+        CHECK(polyMuscle.computeMomentArm(polyState, polyCoord) ==
+                Approx(muscle->computeMomentArm(state, coord)).margin(1e-5));
+        // The generalized force from the muscle is applied correctly.
+        CHECK(polyState.getUDot()[0] ==
+                Approx(state.getUDot()[0]).epsilon(1e-3));
+    }
+}
@@ -73,3 +73,83 @@ TEST_CASE("TableProcessor") {
         }
     }
 }
+
+TEST_CASE("filterLowpass() matches Storage::lowpassIIR()") {
+    const int numRows = 101;
+    SimTK::Vector time = createVectorLinspace(numRows, 0, 1);
+    SimTK::Matrix data(numRows, 3);
+    for (int i = 0; i < numRows; ++i) {
+        data(i, 0) = std::sin(2 * SimTK::Pi * time[i]);
+        data(i, 1) = std::sin(40 * SimTK::Pi * time[i]) + time[i];
+        data(i, 2) = std::cos(10 * time[i]) * time[i];
+    }
+    TimeSeriesTable table(std::vector<double>(time.begin(), time.end()), data,
+            std::vector<std::string>{"a", "b", "c"});
+
+    for (bool padData : {false, true}) {
+        CAPTURE(padData);
+        Storage sto = convertTableToStorage(table);
+        if (padData) sto.pad(numRows / 2);
+        sto.lowpassIIR(6);
+        TimeSeriesTable expected = sto.exportToTable();
+
+        TimeSeriesTable actual = filterLowpass(table, 6, padData);
+        REQUIRE(actual.getNumRows() == expected.getNumRows());
+        REQUIRE(actual.getColumnLabels() == expected.getColumnLabels());
+        for (int i = 0; i < (int)actual.getNumRows(); ++i) {
+            CHECK(actual.getIndependentColumn()[i] ==
+                    Approx(expected.getIndependentColumn()[i]).margin(1e-12));
+        }
+        SimTK_TEST_EQ_TOL(actual.getMatrix(), expected.getMatrix(), 1e-12);
+    }
+
+    // The table must be sampled uniformly.
+    std::vector<double> nonuniformTime(time.begin(), time.end());
+    nonuniformTime[1] = 0.015;
+    CHECK_THROWS_WITH(filterLowpass(TimeSeriesTable(nonuniformTime, data,
+                                            {"a", "b", "c"}),
+                              6),
+            Catch::Contains("sampled uniformly"));
+}
+
+TEST_CASE("TableProcessor cache") {
+    const int numRows = 51;
+    SimTK::Vector time = createVectorLinspace(numRows, 0, 1);
+    TimeSeriesTable table(std::vector<double>(time.begin(), time.end()),
+            SimTK::Test::randMatrix(numRows, 2),
+            std::vector<std::string>{"a", "b"});
+    table.addTableMetaData<std::string>("inDegrees", "no");
+    writeTableToFile(table, "testTableProcessor_cache_table.sto");
+
+    TableProcessor proc =
+            TableProcessor("testTableProcessor_cache_table.sto") |
+            TabOpLowPassFilter(6);
+    const TimeSeriesTable uncached = proc.process();
+
+    proc.set_cache_directory("testTableProcessor_cache");
+    const TimeSeriesTable first = proc.process();
+    const TimeSeriesTable second = proc.process();
+    for (const auto* processed : {&first, &second}) {
+        REQUIRE(processed->getNumRows() == uncached.getNumRows());
+        CHECK(processed->getColumnLabels() == uncached.getColumnLabels());
+        CHECK(processed->getIndependentColumn() ==
+                uncached.getIndependentColumn());
+        // The cache is lossless.
+        SimTK_TEST_EQ_TOL(processed->getMatrix(), uncached.getMatrix(), 0);
+        CHECK(processed->getTableMetaDataAsString("inDegrees") == "no");
+    }
+
+    // Changing the operators invalidates the cache.
+    proc.set_operators(0, TabOpLowPassFilter(3));
+    const TimeSeriesTable refiltered = proc.process();
+    CHECK(!SimTK::Test::numericallyEqual(
+            refiltered.getMatrix(), uncached.getMatrix(), 1, 1e-6));
+
+    // Changing the source file invalidates the cache.
+    table.updMatrix() *= 2;
+    writeTableToFile(table, "testTableProcessor_cache_table.sto");
+    proc.set_operators(0, TabOpLowPassFilter(6));
+    // The data in the file is written with finite precision.
+    SimTK_TEST_EQ_TOL(proc.process().getMatrix(), 2 * uncached.getMatrix(),
+            1e-4);
+}
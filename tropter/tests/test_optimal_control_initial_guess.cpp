@@ -507,6 +507,24 @@ TEST_CASE("(De)serialization of Iterate", "[iterate_readwrite]") {
     REQUIRE(it0.adjunct_names == it1.adjunct_names);
     REQUIRE(it0.diffuse_names == it1.diffuse_names);
     REQUIRE(it0.parameter_names == it1.parameter_names);
+
+    // Binary format.
+    const std::string binaryFilename =
+            "test_OptimalControlIterate_serialization.traj";
+    it0.write(binaryFilename);
+    Iterate it2(binaryFilename);
+    // No loss of precision.
+    REQUIRE(it0.time == it2.time);
+    REQUIRE(it0.states == it2.states);
+    REQUIRE(it0.controls == it2.controls);
+    REQUIRE(it0.adjuncts == it2.adjuncts);
+    REQUIRE(it0.diffuses == it2.diffuses);
+    REQUIRE(it0.parameters == it2.parameters);
+    REQUIRE(it0.state_names == it2.state_names);
+    REQUIRE(it0.control_names == it2.control_names);
+    REQUIRE(it0.adjunct_names == it2.adjunct_names);
+    REQUIRE(it0.diffuse_names == it2.diffuse_names);
+    REQUIRE(it0.parameter_names == it2.parameter_names);
 }
 
 TEST_CASE("Interpolating an initial guess") {
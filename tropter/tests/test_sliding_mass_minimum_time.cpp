@@ -19,6 +19,7 @@
 #include <catch.hpp>
 #include "testing_optimalcontrol.h"
 #include <cmath>
+#include <set>
 
 using Eigen::Ref;
 using Eigen::VectorXd;
@@ -105,6 +106,12 @@ TEST_CASE("Sliding mass minimum time.") {
         comp.num_mesh_intervals = 3;
         comp.compare();
     }
+    SECTION("derivative comparison, hermite-simpson") {
+        OCPDerivativesComparison<SlidingMassMinimumTime> comp;
+        comp.num_mesh_intervals = 3;
+        comp.transcription_scheme = "hermite-simpson";
+        comp.compare();
+    }
     SECTION("trapezoidal") {
         SlidingMassMinimumTime<adouble>::run_test(100, "trapezoidal", 0.001);
         SlidingMassMinimumTime<double>::run_test(100, "trapezoidal", 0.001);
@@ -117,3 +124,59 @@ TEST_CASE("Sliding mass minimum time.") {
     }
 }
 
+
+TEST_CASE("Sliding mass minimum time, Hessian sparsity of time variables.") {
+    const int num_mesh_intervals = 3;
+    const int num_dense_variables = 2;
+    const int num_continuous_variables = 3;
+    const int num_col_points = 2 * num_mesh_intervals + 1;
+    const int num_variables =
+            num_dense_variables + num_col_points * num_continuous_variables;
+    auto ocp = std::make_shared<SlidingMassMinimumTime<double>>();
+    DirectCollocationSolver<double> dircol(ocp, "hermite-simpson", "ipopt",
+            num_mesh_intervals);
+    SECTION("dense") {
+        // Time is assumed to be coupled to all other variables.
+        auto nlp = dircol.get_transcription().make_decorator();
+        SparsityCoordinates jac_sparsity, hes_sparsity;
+        nlp->calc_sparsity(nlp->make_random_iterate_within_bounds(),
+                jac_sparsity, true, hes_sparsity);
+        std::set<std::pair<int, int>> time_nonzeros;
+        for (int inz = 0; inz < (int)hes_sparsity.row.size(); ++inz) {
+            const auto& row = hes_sparsity.row[inz];
+            const auto& col = hes_sparsity.col[inz];
+            if ((int)row < num_dense_variables)
+                time_nonzeros.insert({(int)row, (int)col});
+        }
+        for (int irow = 0; irow < num_dense_variables; ++irow) {
+            for (int icol = irow; icol < num_variables; ++icol) {
+                INFO("(" << irow << "," << icol << ")");
+                CHECK(time_nonzeros.count({irow, icol}) == 1);
+            }
+        }
+    }
+    SECTION("sparse") {
+        // The dynamics do not depend on the position state "x", so the
+        // defects do not couple initial_time and final_time to "x". Only the
+        // endpoint cost couples time to "x", at the first and last
+        // collocation points.
+        dircol.set_exact_hessian_block_sparsity_mode("sparse");
+        auto nlp = dircol.get_transcription().make_decorator();
+        SparsityCoordinates jac_sparsity, hes_sparsity;
+        nlp->calc_sparsity(nlp->make_random_iterate_within_bounds(),
+                jac_sparsity, true, hes_sparsity);
+        for (int inz = 0; inz < (int)hes_sparsity.row.size(); ++inz) {
+            const auto& row = hes_sparsity.row[inz];
+            const auto& col = hes_sparsity.col[inz];
+            if ((int)row >= num_dense_variables) continue;
+            const int i_col = ((int)col - num_dense_variables) /
+                    num_continuous_variables;
+            const int i_var = ((int)col - num_dense_variables) %
+                    num_continuous_variables;
+            if ((int)col < num_dense_variables || i_col == 0 ||
+                    i_col == num_col_points - 1) continue;
+            INFO("(" << row << "," << col << ")");
+            REQUIRE(i_var != 0);
+        }
+    }
+}
@@ -31,6 +31,7 @@ namespace tropter {
 template <template <class> class OCPType>
 struct OCPDerivativesComparison {
     int num_mesh_intervals = 5;
+    std::string transcription_scheme = "trapezoidal";
     std::string findiff_hessian_mode = "fast";
     double findiff_hessian_step_size = 1e-3;
     double gradient_error_tolerance = 1e-7;
@@ -42,7 +43,7 @@ struct OCPDerivativesComparison {
 
         // double
         auto d = std::make_shared<OCPType<double>>();
-        DirectCollocationSolver<double> ddc(d, "trapezoidal", "ipopt",
+        DirectCollocationSolver<double> ddc(d, transcription_scheme, "ipopt",
                 num_mesh_intervals);
         auto dnlp = ddc.get_transcription().make_decorator();
         dnlp->set_findiff_hessian_step_size(findiff_hessian_step_size);
@@ -57,7 +58,7 @@ struct OCPDerivativesComparison {
 
         // adouble
         auto a = std::make_shared<OCPType<adouble>>();
-        DirectCollocationSolver<adouble> adc(a, "trapezoidal", "ipopt",
+        DirectCollocationSolver<adouble> adc(a, transcription_scheme, "ipopt",
                 num_mesh_intervals);
         auto anlp = adc.get_transcription().make_decorator();
         VectorXd agrad;
@@ -203,7 +203,7 @@ SparsityPattern
         x[j] = x0[j];
         diff = output - output0;
         for (int i = 0; i < (int)num_outputs; ++i) {
-            if (std::isnan(diff[i])) {
+            if (isnan(diff[i])) {
                 std::cout << "[tropter] Warning: NaN encountered when "
                     "detecting sparsity of Jacobian; entry (";
                 if (col_names.empty() || row_names.empty())
@@ -128,6 +128,7 @@ Solution DirectCollocationSolver<T>::solve(
     solution.success = optsol.success;
     solution.status = optsol.status;
     solution.num_iterations = optsol.num_iterations;
+    solution.timings = optsol.timings;
     if (!solution && m_verbosity) {
         std::cerr << "[tropter] DirectCollocationSolver did not succeed:\n"
                 << solution.status << std::endl;
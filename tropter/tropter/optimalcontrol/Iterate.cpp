@@ -16,6 +16,8 @@
 
 #include "Iterate.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 
@@ -26,9 +28,227 @@
 
 using namespace tropter;
 
+namespace {
+
+// Binary columnar iterate files, using the same layout as OpenSim Moco's
+// binary MocoTrajectory files (see Iterate.h). Each block stores one column
+// per variable, so the (variable x time) matrices are transposed.
+const char binary_magic[8] = {'O', 'S', 'I', 'M', 'T', 'R', 'A', 'J'};
+const uint32_t binary_version = 1;
+const uint32_t binary_byte_order_mark = 0x01020304;
+const uint64_t binary_alignment = 64;
+
+bool has_binary_extension(const std::string& filepath) {
+    const std::string ext = ".traj";
+    return filepath.size() >= ext.size() &&
+           filepath.compare(filepath.size() - ext.size(), ext.size(), ext) ==
+                   0;
+}
+
+bool is_binary_file(const std::string& filepath) {
+    std::ifstream f(filepath, std::ios::binary);
+    char magic[sizeof(binary_magic)];
+    return f.read(magic, sizeof(magic)) &&
+           std::equal(magic, magic + sizeof(magic), binary_magic);
+}
+
+uint64_t align_offset(uint64_t offset) {
+    return (offset + binary_alignment - 1) / binary_alignment *
+           binary_alignment;
+}
+
+struct BinaryBlock {
+    std::string name;
+    std::vector<std::string> labels;
+    // Number of rows x number of labels, column-major.
+    Eigen::MatrixXd data;
+    uint64_t offset = 0;
+};
+
+void append(std::string& header, uint64_t value) {
+    header.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void append(std::string& header, const std::string& value) {
+    append(header, (uint64_t)value.size());
+    header.append(value);
+}
+
+// Use generated names if the names do not match the number of variables.
+std::vector<std::string> labels_for(const std::vector<std::string>& names,
+        Eigen::Index num_variables, const std::string& prefix) {
+    if ((Eigen::Index)names.size() == num_variables) return names;
+    std::vector<std::string> labels;
+    for (Eigen::Index i = 0; i < num_variables; ++i)
+        labels.push_back(prefix + std::to_string(i));
+    return labels;
+}
+
+void write_binary(const Iterate& it, const std::string& filepath) {
+    std::vector<BinaryBlock> blocks;
+    const auto add_block = [&](const std::string& name,
+                                   std::vector<std::string> labels,
+                                   Eigen::MatrixXd data) {
+        BinaryBlock block;
+        block.name = name;
+        block.labels = std::move(labels);
+        block.data = std::move(data);
+        blocks.push_back(std::move(block));
+    };
+    add_block("time", {"time"}, it.time.transpose());
+    add_block("states", labels_for(it.state_names, it.states.rows(), "state"),
+            it.states.transpose());
+    add_block("controls",
+            labels_for(it.control_names, it.controls.rows(), "control"),
+            it.controls.transpose());
+    add_block("adjuncts",
+            labels_for(it.adjunct_names, it.adjuncts.rows(), "adjunct"),
+            it.adjuncts.transpose());
+    add_block("diffuses",
+            labels_for(it.diffuse_names, it.diffuses.rows(), "diffuse"),
+            it.diffuses.transpose());
+    add_block("parameters",
+            labels_for(it.parameter_names, it.parameters.rows(), "parameter"),
+            it.parameters.transpose());
+
+    std::string header(binary_magic, sizeof(binary_magic));
+    header.append(reinterpret_cast<const char*>(&binary_version),
+            sizeof(binary_version));
+    header.append(reinterpret_cast<const char*>(&binary_byte_order_mark),
+            sizeof(binary_byte_order_mark));
+    append(header, (uint64_t)0); // No metadata.
+    append(header, (uint64_t)blocks.size());
+    std::vector<size_t> offset_positions;
+    for (const auto& block : blocks) {
+        append(header, block.name);
+        append(header, (uint64_t)block.data.rows());
+        append(header, (uint64_t)block.labels.size());
+        offset_positions.push_back(header.size());
+        append(header, (uint64_t)0);
+        for (const auto& label : block.labels) append(header, label);
+    }
+    uint64_t offset = align_offset(header.size());
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        blocks[i].offset = offset;
+        std::copy_n(reinterpret_cast<const char*>(&offset), sizeof(offset),
+                &header[offset_positions[i]]);
+        offset = align_offset(offset + sizeof(double) * blocks[i].data.size());
+    }
+
+    std::ofstream f(filepath, std::ios::binary);
+    TROPTER_THROW_IF(!f, "Could not open '%s' for writing.", filepath);
+    f.write(header.data(), header.size());
+    uint64_t position = header.size();
+    const std::vector<char> padding(binary_alignment, 0);
+    for (const auto& block : blocks) {
+        f.write(padding.data(), block.offset - position);
+        const uint64_t num_bytes = sizeof(double) * block.data.size();
+        if (num_bytes) {
+            f.write(reinterpret_cast<const char*>(block.data.data()),
+                    num_bytes);
+        }
+        position = block.offset + num_bytes;
+    }
+    TROPTER_THROW_IF(!f, "Error while writing '%s'.", filepath);
+}
+
+void read_binary(Iterate& it, const std::string& filepath) {
+    std::ifstream f(filepath, std::ios::binary | std::ios::ate);
+    TROPTER_THROW_IF(!f, "Could not read '%s'.", filepath);
+    const uint64_t file_size = (uint64_t)f.tellg();
+    f.seekg(0);
+    const auto read = [&](void* out, uint64_t num_bytes) {
+        f.read(reinterpret_cast<char*>(out), num_bytes);
+        TROPTER_THROW_IF(!f, "Unexpected end of file '%s'.", filepath);
+    };
+    const auto read_uint64 = [&]() {
+        uint64_t value;
+        read(&value, sizeof(value));
+        return value;
+    };
+    const auto read_string = [&]() {
+        const uint64_t size = read_uint64();
+        TROPTER_THROW_IF(size > file_size, "Invalid string length in '%s'.",
+                filepath);
+        std::string value(size, '\0');
+        if (size) read(&value[0], size);
+        return value;
+    };
+
+    char magic[sizeof(binary_magic)];
+    uint32_t version;
+    uint32_t byte_order_mark;
+    read(magic, sizeof(magic));
+    read(&version, sizeof(version));
+    read(&byte_order_mark, sizeof(byte_order_mark));
+    TROPTER_THROW_IF(!std::equal(magic, magic + sizeof(magic), binary_magic),
+            "'%s' is not a binary iterate file.", filepath);
+    TROPTER_THROW_IF(byte_order_mark != binary_byte_order_mark,
+            "'%s' was written on a machine with a different byte order.",
+            filepath);
+    TROPTER_THROW_IF(version > binary_version,
+            "'%s' has version %i, but only versions up to %i are supported.",
+            filepath, (int)version, (int)binary_version);
+    const uint64_t num_metadata = read_uint64();
+    for (uint64_t i = 0; i < 2 * num_metadata; ++i) read_string();
+
+    const uint64_t num_blocks = read_uint64();
+    std::vector<BinaryBlock> blocks(num_blocks);
+    std::vector<uint64_t> num_rows(num_blocks);
+    for (uint64_t i = 0; i < num_blocks; ++i) {
+        blocks[i].name = read_string();
+        num_rows[i] = read_uint64();
+        const uint64_t num_columns = read_uint64();
+        blocks[i].offset = read_uint64();
+        for (uint64_t icol = 0; icol < num_columns; ++icol)
+            blocks[i].labels.push_back(read_string());
+        TROPTER_THROW_IF(blocks[i].offset +
+                                         sizeof(double) * num_rows[i] *
+                                                 num_columns >
+                                 file_size,
+                "Block '%s' of '%s' is truncated.", blocks[i].name, filepath);
+    }
+    for (uint64_t i = 0; i < num_blocks; ++i) {
+        auto& block = blocks[i];
+        block.data.resize(num_rows[i], block.labels.size());
+        if (block.data.size()) {
+            f.seekg(block.offset);
+            read(block.data.data(), sizeof(double) * block.data.size());
+        }
+        if (block.name == "time") {
+            it.time = block.data.transpose();
+        } else if (block.name == "states") {
+            it.state_names = block.labels;
+            it.states = block.data.transpose();
+        } else if (block.name == "controls") {
+            it.control_names = block.labels;
+            it.controls = block.data.transpose();
+        } else if (block.name == "adjuncts") {
+            it.adjunct_names = block.labels;
+            it.adjuncts = block.data.transpose();
+        } else if (block.name == "diffuses") {
+            it.diffuse_names = block.labels;
+            it.diffuses = block.data.transpose();
+        } else if (block.name == "parameters") {
+            it.parameter_names = block.labels;
+            it.parameters = block.data.transpose();
+        }
+    }
+    TROPTER_THROW_IF(it.time.size() == 0 && (it.states.size() ||
+                                                    it.controls.size()),
+            "Expected a 'time' column in '%s'.", filepath);
+}
+
+} // anonymous namespace
+
 Iterate::Iterate(const std::string& filepath) {
     TROPTER_THROW_IF(filepath.empty(), "filepath is empty.");
 
+    if (is_binary_file(filepath)) {
+        read_binary(*this, filepath);
+        return;
+    }
+
     std::ifstream f(filepath);
     TROPTER_THROW_IF(!f, "Could not read '%s'.", filepath);
 
@@ -246,6 +466,11 @@ Iterate Iterate::interpolate(Eigen::VectorXd newTime) const {
 /// Write the states, controls, and adjuncts trajectories and the parameter
 /// values to a plain-text CSV file.
 void Iterate::write(const std::string& filepath) const {
+    if (has_binary_extension(filepath)) {
+        write_binary(*this, filepath);
+        return;
+    }
+
     std::ofstream f(filepath);
 
     // Header.
@@ -16,6 +16,8 @@
 // limitations under the License.
 // ----------------------------------------------------------------------------
 
+#include <tropter/utilities.h>
+
 #include <Eigen/Dense>
 
 #include <string>
@@ -47,6 +49,11 @@ time,<state-0-name>,...,<control-0-name>,...,<adjunct-0-name>,... \
  : , : ,..., : ,..., : ,...,    :     ,...,  :  ,...
 <#>,<#>,...,<#>,...,<#>,...,<#-or-NaN>,...,<NaN>,...
 @endverbatim
+If the file name ends with ".traj", write() instead uses a compact binary
+columnar format (the same layout as OpenSim Moco's binary MocoTrajectory
+files), with one block of columns for each of time, states, controls,
+adjuncts, diffuses, and parameters; each column is a variable. The
+constructor detects this format automatically.
 @ingroup optimalcontrol
 */
 // TODO rename to Variables?
@@ -72,8 +79,8 @@ struct Iterate {
                 adjunct_names.size() || diffuse_names.size() ||
                 parameter_names.size());
     }
-    /// Read in states and controls from a CSV file generated by calling
-    /// write().
+    /// Read in states and controls from a CSV or binary (".traj") file
+    /// generated by calling write().
     explicit Iterate(const std::string& filepath);
     /// Linearly interpolate (upsample or downsample) the continuous variables 
     /// (i.e. states and controls) within this iterate to produce a new iterate 
@@ -82,7 +89,8 @@ struct Iterate {
     /// @returns the interpolated iterate.
     Iterate interpolate(Eigen::VectorXd newTime) const;
     // TODO void validate(const std::string& error_message) const;
-    /// Write the states and controls trajectories to a plain-text CSV file.
+    /// Write the states and controls trajectories to a plain-text CSV file,
+    /// or to a binary file if `filepath` ends with ".traj".
     virtual void write(const std::string& filepath) const;
 };
 
@@ -97,6 +105,9 @@ struct Solution : public Iterate {
     std::string status;
     /// Number of solver iterations at which this solution was obtained.
     int num_iterations = -1;
+    /// Number of evaluations of, and time spent in, computing the objective,
+    /// constraints, and their derivatives.
+    std::vector<Timing> timings;
 };
 
 } // namespace tropter
@@ -233,6 +233,24 @@ protected:
         make_constraints_view(Eigen::Ref<VectorX<T>> constraints) const;
 
 private:
+    /// Determine how initial_time, final_time, and the parameters (the
+    /// "dense" variables) are coupled to the continuous variables at a single
+    /// collocation point, in the Hessian of the constraints and in the Hessian
+    /// of the integral costs. The patterns are over the variables
+    /// [initial_time, final_time, parameters, continuous variables], and are
+    /// the union of the sparsity of the Jacobian of the DAE and the
+    /// integrands at every collocation point of `x`. This is only used if the
+    /// exact Hessian block sparsity mode is "sparse"; otherwise, the dense
+    /// variables are assumed to be coupled to all other variables.
+    void calc_sparsity_dense_variable_coupling(const Eigen::VectorXd& x,
+            SymmetricSparsityPattern& dae_coupling,
+            SymmetricSparsityPattern& integrand_coupling) const;
+    /// Set the rows of the dense variables in `sparsity` by repeating the
+    /// coupling from calc_sparsity_dense_variable_coupling() for every
+    /// collocation point.
+    void set_nonzero_dense_variable_rows(
+            const SymmetricSparsityPattern& point_coupling,
+            SymmetricSparsityPattern& sparsity) const;
 
     std::shared_ptr<const OCProblem> m_ocproblem;
 
@@ -246,8 +264,8 @@ private:
     int m_num_time_variables = -1;
     int m_num_parameters = -1;
     // The sum total of time_variables and parameters. Here, "dense" means that
-    // a dense row and column are added to the sparsity pattern of the Hessian 
-    // for each dense_variable added.
+    // these variables may be coupled to the variables at every collocation
+    // point in the sparsity pattern of the Hessian.
     int m_num_dense_variables = -1;
     int m_num_defects = -1;
     int m_num_states = -1;
@@ -505,27 +505,42 @@ void HermiteSimpson<T>::calc_sparsity_hessian_lagrangian(
 
     const auto& num_con_vars = m_num_continuous_variables;
 
+    // The first rows of the Hessian contain partial derivatives with
+    // initial_time, final_time, and the parameters. In "dense" mode, we
+    // assume these "dense" variables are coupled to all other variables. In
+    // "sparse" mode, we derive their coupling to the continuous variables from
+    // the structure of the defects and the cost terms.
+    SymmetricSparsityPattern dae_coupling(
+            m_num_dense_variables + num_con_vars);
+    SymmetricSparsityPattern integrand_coupling(
+            m_num_dense_variables + num_con_vars);
+    if (this->get_exact_hessian_block_sparsity_mode() == "sparse") {
+        calc_sparsity_dense_variable_coupling(
+                x, dae_coupling, integrand_coupling);
+    } else if (this->get_exact_hessian_block_sparsity_mode() == "dense") {
+        dae_coupling.set_dense();
+        integrand_coupling.set_dense();
+    }
+    // The diffuse variables are appended to the end of the variables vector.
+    const int diffuses_start =
+            m_num_dense_variables + m_num_col_points * num_con_vars;
+
     // Hessian of constraints.
     // -----------------------
-    // The first two rows of the Hessian contain partial derivatives with
-    // initial_time and final_time. We assume time is coupled to all other
-    // variables.
-    // TODO can be smarter about interaction of variables with time; implicit
-    // formulations (see test_double_pendulum) give additional sparsity here.
+    set_nonzero_dense_variable_rows(dae_coupling, hescon_sparsity);
+    // We do not detect how the diffuse variables interact with time and the
+    // parameters.
     for (int irow = 0; irow < m_num_dense_variables; ++irow) {
-        for (int icol = irow; icol < (int)num_variables; ++icol) {
+        for (int icol = diffuses_start; icol < (int)num_variables; ++icol) {
             hescon_sparsity.set_nonzero(irow, icol);
         }
     }
 
+    // Automatic sparsity detection for the Hessian diagonal blocks is not
+    // implemented for Hermite-Simpson transcription, so the blocks are dense
+    // in both modes.
     SymmetricSparsityPattern dae_sparsity(m_num_continuous_variables);
-    if (this->get_exact_hessian_block_sparsity_mode() == "sparse") {
-        TROPTER_THROW(
-                "Automatic sparsity detection for Hessian diagonal "
-                "blocks not implemented for Hermite-Simpson transcription.");
-    } else if (this->get_exact_hessian_block_sparsity_mode() == "dense") {
-        dae_sparsity.set_dense();
-    }
+    dae_sparsity.set_dense();
 
     // Repeat the block down the diagonal of the Hessian of constraints.
     // TODO may need to move this into each branch of if-statement above,
@@ -537,26 +552,32 @@ void HermiteSimpson<T>::calc_sparsity_hessian_lagrangian(
 
     // Hessian of objective.
     // ---------------------
-    // Assume time and parameters are coupled to all other variables.
-    // TODO not necessarily; detect this sparsity.
+    set_nonzero_dense_variable_rows(integrand_coupling, hesobj_sparsity);
+    // The endpoint costs may depend on time and the parameters in any way, so
+    // the dense variables are coupled to all of the continuous variables at
+    // the initial and final collocation points.
+    const auto lastcolstart =
+            m_num_dense_variables + (m_num_col_points - 1) * num_con_vars;
     for (int irow = 0; irow < m_num_dense_variables; ++irow) {
-        for (int icol = irow; icol < (int)num_variables; ++icol) {
+        for (int icol = irow; icol < m_num_dense_variables + num_con_vars;
+                ++icol) {
+            hesobj_sparsity.set_nonzero(irow, icol);
+        }
+        for (int icol = lastcolstart; icol < lastcolstart + num_con_vars;
+                ++icol) {
+            hesobj_sparsity.set_nonzero(irow, icol);
+        }
+        for (int icol = diffuses_start; icol < (int)num_variables; ++icol) {
             hesobj_sparsity.set_nonzero(irow, icol);
         }
     }
 
     for (int icost = 0; icost < m_ocproblem->get_num_costs(); ++icost) {
         if (m_ocproblem->get_cost_requires_integral(icost)) {
+            // As with the constraints, the diagonal blocks are dense in both
+            // modes.
             SymmetricSparsityPattern integral_cost_sparsity(num_con_vars);
-            if (this->get_exact_hessian_block_sparsity_mode() == "sparse") {
-                TROPTER_THROW(
-                        "Automatic sparsity detection for Hessian diagonal "
-                        "blocks not implemented for Hermite-Simpson "
-                        "transcription.");
-            } else if (this->get_exact_hessian_block_sparsity_mode() ==
-                       "dense") {
-                integral_cost_sparsity.set_dense();
-            }
+            integral_cost_sparsity.set_dense();
 
             // Repeat the block down the diagonal of the Hessian of the
             // objective.
@@ -652,8 +673,165 @@ void HermiteSimpson<T>::calc_sparsity_hessian_lagrangian(
         hesobj_sparsity.set_nonzero_block(lastmeshstart, cost_final_sparsity);
     }
 
-    // TODO most objectives do *NOT* depend on time; should time actually
-    // affect hesobj for most problems?
+}
+
+template <typename T>
+void HermiteSimpson<T>::calc_sparsity_dense_variable_coupling(
+        const Eigen::VectorXd& x, SymmetricSparsityPattern& dae_coupling,
+        SymmetricSparsityPattern& integrand_coupling) const {
+    const auto& num_con_vars = m_num_continuous_variables;
+    const int num_point_vars = m_num_dense_variables + num_con_vars;
+    // The local variables are ordered in the same way as the first entries of
+    // the NLP variables: initial_time, final_time, parameters, and the
+    // continuous variables at a single collocation point. A function may only
+    // depend on a variable for some values of the other variables (e.g., in
+    // an if-statement), so we take the union of the sparsity detected at the
+    // variables of every collocation point.
+    Eigen::VectorXd point_vars(num_point_vars);
+    point_vars.head(m_num_dense_variables) = x.head(m_num_dense_variables);
+    auto set_point_vars = [&](int i_col) {
+        point_vars.tail(num_con_vars) = x.segment(
+                m_num_dense_variables + i_col * num_con_vars, num_con_vars);
+    };
+    // The normalized time of the collocation point for which we are
+    // detecting sparsity.
+    double normalized_time = 0;
+    auto unpack = [this, &normalized_time](const VectorX<T>& vars, T& t,
+            VectorX<T>& s, VectorX<T>& c, VectorX<T>& a, VectorX<T>& p) {
+        t = (vars[1] - vars[0]) * normalized_time + vars[0];
+        p = vars.segment(m_num_time_variables, m_num_parameters);
+        s = vars.segment(m_num_dense_variables, m_num_states);
+        c = vars.segment(m_num_dense_variables + m_num_states,
+                m_num_controls);
+        a = vars.tail(m_num_adjuncts);
+    };
+
+    // Defects and path constraints.
+    // -----------------------------
+    // The Hermite and Simpson defects contain h * f(t, x, p), where the mesh
+    // interval duration h is a linear function of initial_time and
+    // final_time. Therefore, time is coupled to every continuous variable
+    // that the state derivatives depend on. The path constraints are not
+    // scaled by h, so they only couple time with the continuous variables if
+    // they depend on time explicitly. The time at a collocation point depends
+    // on both initial_time and final_time, so we treat a dependence on either
+    // time variable as a dependence on both.
+    const int num_dae_outputs = m_num_states + m_num_path_constraints;
+    std::function<void(const VectorX<T>&, VectorX<T>&)> calc_dae =
+            [this, &unpack](const VectorX<T>& vars, VectorX<T>& out) {
+                T t;
+                VectorX<T> s, c, a, p;
+                unpack(vars, t, s, c, a, p);
+                VectorX<T> d; // empty
+                VectorX<T> deriv(m_num_states);
+                VectorX<T> path(m_num_path_constraints);
+                m_ocproblem->initialize_on_iterate(p);
+                m_ocproblem->calc_differential_algebraic_equations(
+                        {0, t, s, c, a, d, p}, {deriv, path});
+                out.head(m_num_states) = deriv;
+                out.tail(m_num_path_constraints) = path;
+            };
+    SparsityPattern dae_dependence(num_dae_outputs, num_point_vars);
+    for (int i_col = 0; i_col < m_num_col_points; ++i_col) {
+        set_point_vars(i_col);
+        normalized_time = m_mesh_and_midpoints[i_col];
+        dae_dependence.add_in_nonzeros(
+                calc_jacobian_sparsity_with_perturbation(
+                        point_vars, num_dae_outputs, calc_dae));
+    }
+    const auto dae_dependence_crs =
+            dae_dependence.convert_to_CompressedRowSparsity();
+    for (int irow = 0; irow < num_dae_outputs; ++irow) {
+        const auto& nonzeros = dae_dependence_crs[irow];
+        // The state derivatives are multiplied by h.
+        const bool scaled_by_duration = irow < m_num_states;
+        const bool depends_on_time =
+                !nonzeros.empty() && (int)nonzeros[0] < m_num_time_variables;
+        if (scaled_by_duration || depends_on_time) {
+            dae_dependence.set_nonzero(irow, 0);
+            dae_dependence.set_nonzero(irow, 1);
+        }
+    }
+    dae_coupling = SymmetricSparsityPattern::create_from_jacobian_sparsity(
+            dae_dependence);
+
+    // Integral costs.
+    // ---------------
+    // The integral is scaled by the duration, and the endpoint cost may be a
+    // nonlinear function of both the integral and the dense variables.
+    // Therefore, the dense variables are coupled to every continuous variable
+    // that any integrand depends on.
+    std::vector<int> integral_cost_indices;
+    for (int icost = 0; icost < m_ocproblem->get_num_costs(); ++icost) {
+        if (m_ocproblem->get_cost_requires_integral(icost))
+            integral_cost_indices.push_back(icost);
+    }
+    const int num_integrands = (int)integral_cost_indices.size();
+    std::function<void(const VectorX<T>&, VectorX<T>&)> calc_integrands =
+            [this, &unpack, &integral_cost_indices](
+                    const VectorX<T>& vars, VectorX<T>& out) {
+                T t;
+                VectorX<T> s, c, a, p;
+                unpack(vars, t, s, c, a, p);
+                VectorX<T> d; // empty
+                m_ocproblem->initialize_on_iterate(p);
+                for (int i = 0; i < (int)integral_cost_indices.size(); ++i) {
+                    T integrand = 0;
+                    m_ocproblem->calc_cost_integrand(integral_cost_indices[i],
+                            {0, t, s, c, a, d, p}, integrand);
+                    out[i] = integrand;
+                }
+            };
+    SparsityPattern integrand_dependence(num_integrands, num_point_vars);
+    if (num_integrands) {
+        for (int i_col = 0; i_col < m_num_col_points; ++i_col) {
+            set_point_vars(i_col);
+            normalized_time = m_mesh_and_midpoints[i_col];
+            integrand_dependence.add_in_nonzeros(
+                    calc_jacobian_sparsity_with_perturbation(
+                            point_vars, num_integrands, calc_integrands));
+        }
+    }
+    for (int irow = 0; irow < num_integrands; ++irow) {
+        for (int icol = 0; icol < m_num_dense_variables; ++icol) {
+            integrand_dependence.set_nonzero(irow, icol);
+        }
+    }
+    integrand_coupling =
+            SymmetricSparsityPattern::create_from_jacobian_sparsity(
+                    integrand_dependence);
+
+    // Restore the parameters from the provided iterate.
+    m_ocproblem->initialize_on_iterate(
+            x.segment(m_num_time_variables, m_num_parameters)
+                    .template cast<T>());
+}
+
+template <typename T>
+void HermiteSimpson<T>::set_nonzero_dense_variable_rows(
+        const SymmetricSparsityPattern& point_coupling,
+        SymmetricSparsityPattern& sparsity) const {
+    const auto& num_con_vars = m_num_continuous_variables;
+    // Time and the parameters are always coupled to each other.
+    for (int irow = 0; irow < m_num_dense_variables; ++irow) {
+        for (int icol = irow; icol < m_num_dense_variables; ++icol) {
+            sparsity.set_nonzero(irow, icol);
+        }
+    }
+    // The coupling between the dense variables and the continuous variables
+    // is the same at every collocation point.
+    const auto point_crs = point_coupling.convert_to_CompressedRowSparsity();
+    for (int irow = 0; irow < m_num_dense_variables; ++irow) {
+        for (const auto& icol : point_crs[irow]) {
+            if ((int)icol < m_num_dense_variables) continue;
+            const int i_con_var = (int)icol - m_num_dense_variables;
+            for (int i_col = 0; i_col < m_num_col_points; ++i_col) {
+                sparsity.set_nonzero(irow,
+                        m_num_dense_variables + i_col * num_con_vars +
+                                i_con_var);
+            }
+        }
+    }
 }
 
 template <typename T>
@@ -38,6 +38,25 @@ void ProblemDecorator::set_findiff_hessian_mode(std::string value) {
     m_findiff_hessian_mode = std::move(value);
 }
 
+std::vector<Timing> ProblemDecorator::get_timings() const {
+    static const char* names[] = {"sparsity", "objective", "constraints",
+            "gradient", "jacobian", "hessian_lagrangian"};
+    std::vector<Timing> timings;
+    for (int i = 0; i < num_timings; ++i) {
+        if (!m_timings[i].num_evaluations) continue;
+        timings.push_back(m_timings[i]);
+        timings.back().name = names[i];
+    }
+    return timings;
+}
+
+void ProblemDecorator::reset_timings() {
+    for (auto& timing : m_timings) {
+        timing.num_evaluations = 0;
+        timing.duration = 0;
+    }
+}
+
 // Explicit instantiation.
 
 template class Problem<double>;
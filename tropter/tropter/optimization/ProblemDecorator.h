@@ -120,7 +120,27 @@ public:
     const std::string& get_findiff_hessian_mode() const;
     /// @}
 
+    /// The number of evaluations of, and the time spent in, each of the
+    /// calc_*() functions above since the last call to reset_timings().
+    /// Functions that were not evaluated are omitted.
+    std::vector<Timing> get_timings() const;
+    /// Set the number of evaluations and time of all timings to zero.
+    void reset_timings();
+
 protected:
+    enum TimingIndex {
+        timing_sparsity,
+        timing_objective,
+        timing_constraints,
+        timing_gradient,
+        timing_jacobian,
+        timing_hessian_lagrangian,
+        num_timings
+    };
+    /// Derived classes time each calc_*() function with a ScopedTimer on
+    /// this Timing.
+    Timing& upd_timing(TimingIndex index) const { return m_timings[index]; }
+
     template<typename ...Types>
     void print(const std::string& format_string, Types... args) const;
 private:
@@ -128,6 +148,8 @@ private:
     int m_verbosity = 1;
     double m_findiff_hessian_step_size = 1e-5;
     std::string m_findiff_hessian_mode = "fast";
+    mutable std::vector<Timing> m_timings =
+            std::vector<Timing>(num_timings);
 };
 
 inline int ProblemDecorator::get_verbosity() const
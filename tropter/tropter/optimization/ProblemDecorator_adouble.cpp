@@ -82,6 +82,7 @@ calc_sparsity(const Eigen::VectorXd& x,
         bool provide_hessian_sparsity,
         SparsityCoordinates& hessian_sparsity) const
 {
+    ScopedTimer timer(upd_timing(timing_sparsity));
     const auto& num_variables = get_num_variables();
     assert(x.size() == num_variables);
     const auto& num_constraints = get_num_constraints();
@@ -183,6 +184,7 @@ calc_objective(unsigned num_variables, const double* x,
         bool /*new_x*/,
         double& obj_value) const
 {
+    ScopedTimer timer(upd_timing(timing_objective));
     int status = ::function(m_objective_tag,
             1, // number of dependent variables.
             num_variables, // number of independent variables.
@@ -201,6 +203,7 @@ calc_constraints(unsigned num_variables, const double* variables,
         bool /*new_variables*/,
         unsigned num_constraints, double* constr) const
 {
+    ScopedTimer timer(upd_timing(timing_constraints));
     // Evaluate the constraints tape.
     int status = ::function(m_constraints_tag,
             num_constraints, // number of dependent variables.
@@ -216,6 +219,7 @@ void Problem<adouble>::Decorator::
 calc_gradient(unsigned num_variables, const double* x, bool /*new_x*/,
         double* grad) const
 {
+    ScopedTimer timer(upd_timing(timing_gradient));
     int status = ::gradient(m_objective_tag, num_variables, x, grad);
     assert(status); // TODO error codes can be -2,-1,0,1,2,3; improve assert!
 }
@@ -224,6 +228,7 @@ void Problem<adouble>::Decorator::
 calc_jacobian(unsigned num_variables, const double* x, bool /*new_x*/,
         unsigned /*num_nonzeros*/, double* jacobian_values) const
 {
+    ScopedTimer timer(upd_timing(timing_jacobian));
     int repeated_call = 1; // We already have the sparsity structure.
     int status = ::sparse_jac(m_constraints_tag, get_num_constraints(),
             num_variables, repeated_call, x,
@@ -245,6 +250,7 @@ calc_hessian_lagrangian(unsigned num_variables, const double* x,
         bool /*new_lambda TODO */,
         unsigned /*num_nonzeros*/, double* hessian_values) const
 {
+    ScopedTimer timer(upd_timing(timing_hessian_lagrangian));
     // TODO if not new_x, then do NOT re-eval objective()!!!
 
     int repeated_call = 1;
@@ -60,6 +60,7 @@ calc_sparsity(const Eigen::VectorXd& variables,
         bool provide_hessian_sparsity,
         SparsityCoordinates& hessian_sparsity_coordinates) const
 {
+    ScopedTimer timer(upd_timing(timing_sparsity));
     const auto num_vars = get_num_variables();
     m_x_working = VectorXd::Zero(num_vars);
 
@@ -198,6 +199,7 @@ calc_objective(unsigned num_variables, const double* variables,
         bool /*new_x*/,
         double& obj_value) const
 {
+    ScopedTimer timer(upd_timing(timing_objective));
     obj_value = 0.0;
     // TODO avoid copy.
     const VectorXd xvec = Eigen::Map<const VectorXd>(variables, num_variables);
@@ -209,6 +211,7 @@ calc_constraints(unsigned num_variables, const double* variables,
         bool /*new_variables*/,
         unsigned num_constraints, double* constr) const
 {
+    ScopedTimer timer(upd_timing(timing_constraints));
     // TODO avoid copy.
     m_x_working = Eigen::Map<const VectorXd>(variables, num_variables);
     VectorXd constrvec(num_constraints); // TODO avoid copy.
@@ -222,6 +225,7 @@ void Problem<double>::Decorator::
 calc_gradient(unsigned num_variables, const double* x, bool /*new_x*/,
         double* grad) const
 {
+    ScopedTimer timer(upd_timing(timing_gradient));
     m_x_working = Eigen::Map<const VectorXd>(x, num_variables);
 
     // TODO use a better estimate for this step size.
@@ -262,6 +266,7 @@ void Problem<double>::Decorator::
 calc_jacobian(unsigned num_variables, const double* variables, bool /*new_x*/,
         unsigned /*num_nonzeros*/, double* jacobian_values) const
 {
+    ScopedTimer timer(upd_timing(timing_jacobian));
     // TODO give error message that sparsity() must be called first.
 
     // TODO scale by magnitude of x.
@@ -296,6 +301,7 @@ calc_hessian_lagrangian(unsigned num_variables, const double* x_raw,
         unsigned num_constraints, const double* lambda_raw,
         bool new_lambda,
         unsigned num_hes_nonzeros, double* hessian_values_raw) const {
+    ScopedTimer timer(upd_timing(timing_hessian_lagrangian));
 
     // TODO remove this string comparison.
     if (get_findiff_hessian_mode() == "slow") {
@@ -177,13 +177,20 @@ Solver::optimize(const Eigen::VectorXd& variables) const
     TROPTER_THROW_IF(variables.size() != m_problem->get_num_variables(),
             "Expected guess to have %i elements, but it has %i elements.",
             m_problem->get_num_variables(), variables.size() );
-    return optimize_impl(variables);
+    m_problem->reset_timings();
+    Solution solution = optimize_impl(variables);
+    solution.timings = m_problem->get_timings();
+    return solution;
 }
 
 Solution
 Solver::optimize() const {
     m_problem->validate();
-    return optimize_impl(m_problem->make_initial_guess_from_bounds());
+    m_problem->reset_timings();
+    Solution solution =
+            optimize_impl(m_problem->make_initial_guess_from_bounds());
+    solution.timings = m_problem->get_timings();
+    return solution;
 }
 
 void Solver::calc_sparsity(const Eigen::VectorXd guess,
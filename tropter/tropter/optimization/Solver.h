@@ -17,6 +17,7 @@
 // ----------------------------------------------------------------------------
 
 #include <tropter/common.h>
+#include <tropter/utilities.h>
 #include <Eigen/Dense>
 
 #include <memory>
@@ -39,6 +40,9 @@ struct Solution {
     /// Number of solver iterations at which this solution was obtained.
     int num_iterations = -1;
     std::string status;
+    /// Number of evaluations of, and time spent in, computing the objective,
+    /// constraints, and their derivatives.
+    std::vector<Timing> timings;
 };
 
 /// The OptimizationSolver class contains some generic options that are
@@ -16,6 +16,7 @@
 // limitations under the License.
 // ----------------------------------------------------------------------------
 
+#include <chrono>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -45,6 +46,34 @@ private:
     // std::ios m_format{nullptr};
 }; // StreamFormat
 
+/// The number of evaluations of, and the real (clock) time in seconds spent
+/// in, a part of a solve (e.g., computing the Jacobian of the constraints).
+struct Timing {
+    std::string name;
+    long long num_evaluations = 0;
+    double duration = 0;
+};
+
+/// This class adds the time between its construction and destruction to a
+/// Timing, and increments the Timing's number of evaluations.
+class ScopedTimer {
+public:
+    ScopedTimer(Timing& timing)
+            : m_timing(timing), m_start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        const std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - m_start;
+        ++m_timing.num_evaluations;
+        m_timing.duration += elapsed.count();
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Timing& m_timing;
+    std::chrono::steady_clock::time_point m_start;
+}; // ScopedTimer
+
 } // namespace tropter
 
 #endif // TROPTER_UTILITIES_H_